@@ -38,6 +38,7 @@ const sidebars = {
                 "features/header",
                 "features/section",
                 "features/lists",
+                "features/tables",
                 "features/arrow",
                 "features/bold-italics",
                 "features/math",
@@ -0,0 +1,508 @@
+/**
+ * @file batch_io/batch_io.cpp
+ * @package //batch_io:batch_io
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `batch_io` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `batch_io` class,
+ *     which reads and writes many small files at once.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "batch_io.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+
+#include "trace/trace.hpp"
+
+#if __has_include(<linux/io_uring.h>)
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#define SPARKDOWN_HAS_IO_URING
+#endif
+
+namespace sparkdown {
+
+#ifdef SPARKDOWN_HAS_IO_URING
+
+/**
+ * @brief An io_uring, set up with raw system calls.
+ * @details Each call to `run()` submits the entries prepared since the last,
+ *     and waits for all of them to complete,
+ *     so the rings are always empty between batches.
+ *
+ */
+struct batch_io::ring {
+    int fd = -1;
+    void *sq_memory = MAP_FAILED;
+    std::size_t sq_size = 0;
+    void *cq_memory = MAP_FAILED;
+    std::size_t cq_size = 0;
+    io_uring_sqe *sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+    std::size_t sqes_size = 0;
+
+    unsigned *sq_tail = nullptr;
+    unsigned *sq_mask = nullptr;
+    unsigned *sq_array = nullptr;
+    unsigned *cq_head = nullptr;
+    unsigned *cq_tail = nullptr;
+    unsigned *cq_mask = nullptr;
+    io_uring_cqe *cqes = nullptr;
+
+    /**
+     * @brief The number of submission entries.
+     *
+     */
+    unsigned entries = 0;
+
+    /**
+     * @brief The number of entries prepared since the last `run()`.
+     *
+     */
+    unsigned prepared = 0;
+
+    ring() = default;
+    ring(const ring &) = delete;
+    ring &operator=(const ring &) = delete;
+
+    ~ring() {
+        if (this->sqes != MAP_FAILED) munmap(this->sqes, this->sqes_size);
+        if (this->cq_memory != MAP_FAILED &&
+            this->cq_memory != this->sq_memory) {
+            munmap(this->cq_memory, this->cq_size);
+        }
+        if (this->sq_memory != MAP_FAILED) {
+            munmap(this->sq_memory, this->sq_size);
+        }
+        if (this->fd >= 0) close(this->fd);
+    }
+
+    /**
+     * @brief Sets up a ring.
+     *
+     * @param entries The least number of submission entries.
+     * @return The ring, or null if the kernel does not allow one.
+     */
+    static std::unique_ptr<ring> open(unsigned entries) {
+        auto result = std::make_unique<ring>();
+        io_uring_params params = {};
+        result->fd =
+            static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (result->fd < 0) return nullptr;
+
+        result->entries = params.sq_entries;
+        result->sq_size =
+            params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        result->cq_size =
+            params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single) {
+            result->sq_size = result->cq_size =
+                std::max(result->sq_size, result->cq_size);
+        }
+
+        result->sq_memory =
+            mmap(nullptr, result->sq_size, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, result->fd, IORING_OFF_SQ_RING);
+        if (result->sq_memory == MAP_FAILED) return nullptr;
+        result->cq_memory =
+            single ? result->sq_memory
+                   : mmap(nullptr, result->cq_size, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, result->fd,
+                          IORING_OFF_CQ_RING);
+        if (result->cq_memory == MAP_FAILED) return nullptr;
+        result->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        result->sqes = static_cast<io_uring_sqe *>(
+            mmap(nullptr, result->sqes_size, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, result->fd, IORING_OFF_SQES));
+        if (result->sqes == MAP_FAILED) return nullptr;
+
+        char *sq = static_cast<char *>(result->sq_memory);
+        char *cq = static_cast<char *>(result->cq_memory);
+        result->sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        result->sq_mask =
+            reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        result->sq_array =
+            reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        result->cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        result->cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        result->cq_mask =
+            reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        result->cqes =
+            reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+        return result;
+    }
+
+    /**
+     * @brief Prepares the next submission entry.
+     *
+     * @param opcode The operation.
+     * @param user_data The index of the result to complete into.
+     * @return The entry, cleared but for the operation and index.
+     */
+    io_uring_sqe *prepare(std::uint8_t opcode, std::size_t user_data) {
+        unsigned tail = *this->sq_tail + this->prepared++;
+        unsigned index = tail & *this->sq_mask;
+        io_uring_sqe *sqe = &this->sqes[index];
+        *sqe = {};
+        sqe->opcode = opcode;
+        sqe->user_data = user_data;
+        this->sq_array[index] = index;
+        return sqe;
+    }
+
+    /**
+     * @brief Submits the prepared entries, and waits for them all.
+     *
+     * @param results Receives the result of each entry, by its index.
+     *     Entries that never complete are left as they were.
+     * @return False if the ring failed, and must not be used again.
+     */
+    bool run(std::vector<int> &results) {
+        unsigned count = this->prepared;
+        this->prepared = 0;
+        __atomic_store_n(this->sq_tail, *this->sq_tail + count,
+                         __ATOMIC_RELEASE);
+
+        unsigned submit = count;
+        for (unsigned done = 0; done < count;) {
+            long entered =
+                syscall(__NR_io_uring_enter, this->fd, submit, count - done,
+                        IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (entered < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            submit -= std::min(submit, static_cast<unsigned>(entered));
+
+            unsigned head = *this->cq_head;
+            unsigned tail = __atomic_load_n(this->cq_tail, __ATOMIC_ACQUIRE);
+            for (; head != tail; head++, done++) {
+                const io_uring_cqe &cqe = this->cqes[head & *this->cq_mask];
+                results[cqe.user_data] = cqe.res;
+            }
+            __atomic_store_n(this->cq_head, head, __ATOMIC_RELEASE);
+        }
+        return true;
+    }
+};
+
+#else
+
+struct batch_io::ring {};
+
+#endif
+
+namespace {
+
+#ifdef SPARKDOWN_HAS_IO_URING
+
+/**
+ * @brief The result of a ring operation that never ran.
+ *
+ */
+constexpr int not_run = -ECANCELED;
+
+/**
+ * @brief Reads the rest of an open file with blocking calls.
+ *
+ * @param fd The file.
+ * @param contents Holds the contents read so far. Receives the rest.
+ * @return True on success.
+ */
+bool read_rest(int fd, std::string &contents) {
+    std::size_t size = contents.size();
+    while (true) {
+        contents.resize(std::max<std::size_t>(size * 2, 4096));
+        ssize_t count = pread(fd, contents.data() + size,
+                              contents.size() - size, static_cast<off_t>(size));
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) {
+            contents.resize(size);
+            return count == 0;
+        }
+        size += static_cast<std::size_t>(count);
+    }
+}
+
+/**
+ * @brief Writes the rest of the given contents with blocking calls.
+ *
+ * @param fd The file.
+ * @param contents The contents.
+ * @param offset The number of bytes already written.
+ * @return True on success.
+ */
+bool write_rest(int fd, const std::string &contents, std::size_t offset) {
+    while (offset < contents.size()) {
+        ssize_t count =
+            pwrite(fd, contents.data() + offset, contents.size() - offset,
+                   static_cast<off_t>(offset));
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) return false;
+        offset += static_cast<std::size_t>(count);
+    }
+    return true;
+}
+
+#endif
+
+}  // namespace
+
+batch_io::batch_io(io_backend backend, std::size_t depth)
+    : _depth(std::max<std::size_t>(depth, 1)) {
+#ifdef SPARKDOWN_HAS_IO_URING
+    if (backend != IO_BLOCKING) {
+        this->_ring = ring::open(static_cast<unsigned>(this->_depth));
+        // The kernel may round the depth up, but never down.
+        if (this->_ring) {
+            this->_depth = std::min<std::size_t>(this->_depth,
+                                                 this->_ring->entries);
+        }
+    }
+#else
+    (void)backend;
+#endif
+}
+
+batch_io::~batch_io() = default;
+
+io_backend batch_io::backend() const {
+    return this->_ring ? IO_URING : IO_BLOCKING;
+}
+
+void batch_io::read(std::vector<read_request> &requests) {
+    SPARKDOWN_TRACE_SPAN("io", "read batch");
+    for (std::size_t first = 0; first < requests.size();
+         first += this->_depth) {
+        std::size_t count = std::min(this->_depth, requests.size() - first);
+        if (this->_ring) {
+            this->_read_ring(&requests[first], count);
+        } else {
+            for (std::size_t i = 0; i < count; i++) {
+                _read_blocking(requests[first + i]);
+            }
+        }
+    }
+}
+
+void batch_io::write(std::vector<write_request> &requests) {
+    SPARKDOWN_TRACE_SPAN("io", "write batch");
+    for (std::size_t first = 0; first < requests.size();
+         first += this->_depth) {
+        std::size_t count = std::min(this->_depth, requests.size() - first);
+        if (this->_ring) {
+            this->_write_ring(&requests[first], count);
+        } else {
+            for (std::size_t i = 0; i < count; i++) {
+                write_request &request = requests[first + i];
+                request.result = output::write(request.path, request.contents);
+            }
+        }
+    }
+}
+
+void batch_io::_read_blocking(read_request &request) {
+    std::ifstream stream(request.path, std::ios::binary);
+    request.contents.assign(std::istreambuf_iterator<char>(stream),
+                            std::istreambuf_iterator<char>());
+    request.ok = stream || stream.eof();
+}
+
+#ifdef SPARKDOWN_HAS_IO_URING
+
+void batch_io::_read_ring(read_request *requests, std::size_t count) {
+    std::vector<int> fds(count, not_run);
+    std::vector<int> reads(count, not_run);
+    std::vector<int> closes(count, not_run);
+    bool ring_ok = true;
+    for (std::size_t i = 0; i < count; i++) requests[i].ok = false;
+
+    // Open every file, then read every file, then close every file:
+    // three system calls for the whole batch.
+    for (std::size_t i = 0; i < count; i++) {
+        io_uring_sqe *sqe = this->_ring->prepare(IORING_OP_OPENAT, i);
+        sqe->fd = AT_FDCWD;
+        sqe->addr = reinterpret_cast<std::uintptr_t>(requests[i].path.c_str());
+        sqe->open_flags = O_RDONLY | O_CLOEXEC;
+    }
+    ring_ok = this->_ring->run(fds);
+
+    // One byte past the hint, so that a right hint also finds the end.
+    for (std::size_t i = 0; ring_ok && i < count; i++) {
+        if (fds[i] < 0) continue;
+        std::string &contents = requests[i].contents;
+        contents.resize(requests[i].size_hint + 1);
+        io_uring_sqe *sqe = this->_ring->prepare(IORING_OP_READ, i);
+        sqe->fd = fds[i];
+        sqe->addr = reinterpret_cast<std::uintptr_t>(contents.data());
+        sqe->len = static_cast<std::uint32_t>(contents.size());
+    }
+    ring_ok = ring_ok && this->_ring->run(reads);
+
+    for (std::size_t i = 0; i < count; i++) {
+        if (fds[i] < 0) continue;
+        std::string &contents = requests[i].contents;
+        if (reads[i] >= 0) {
+            std::size_t size = static_cast<std::size_t>(reads[i]);
+            bool whole = size < contents.size();
+            contents.resize(size);
+            requests[i].ok = whole || read_rest(fds[i], contents);
+        }
+        if (ring_ok) {
+            io_uring_sqe *sqe = this->_ring->prepare(IORING_OP_CLOSE, i);
+            sqe->fd = fds[i];
+        } else {
+            close(fds[i]);
+        }
+    }
+    if (ring_ok && this->_ring->prepared) ring_ok = this->_ring->run(closes);
+
+    if (!ring_ok) this->_ring.reset();
+    for (std::size_t i = 0; i < count; i++) {
+        if (!requests[i].ok) _read_blocking(requests[i]);
+    }
+}
+
+void batch_io::_write_ring(write_request *requests, std::size_t count) {
+    std::vector<struct statx> stats(count);
+    std::vector<std::string> temporaries(count);
+    std::vector<int> results(count, not_run);
+    std::vector<int> fds(count, not_run);
+    std::vector<int> writes(count, not_run);
+    std::vector<int> syncs(count, not_run);
+    std::vector<int> closes(count, not_run);
+    std::vector<int> renames(count, not_run);
+    std::vector<bool> pending(count, true);
+
+    // As in `output::write()`: files that already hold the contents
+    // are left alone, and the sizes rule out most of them at once.
+    // Links are not followed, so that they can be told apart.
+    for (std::size_t i = 0; i < count; i++) {
+        io_uring_sqe *sqe = this->_ring->prepare(IORING_OP_STATX, i);
+        sqe->fd = AT_FDCWD;
+        sqe->addr = reinterpret_cast<std::uintptr_t>(requests[i].path.c_str());
+        sqe->len = STATX_TYPE | STATX_MODE | STATX_SIZE;
+        sqe->off = reinterpret_cast<std::uintptr_t>(&stats[i]);
+        sqe->statx_flags = AT_SYMLINK_NOFOLLOW;
+    }
+    bool ring_ok = this->_ring->run(results);
+
+    // Then each regular file is written to a new temporary file beside it,
+    // which is renamed over it once it is synced and closed.
+    // Links and other kinds of file are left to `output::write()`.
+    for (std::size_t i = 0; ring_ok && i < count; i++) {
+        bool exists = results[i] == 0;
+        if (exists && !S_ISREG(stats[i].stx_mode)) continue;
+        if (!exists && results[i] != -ENOENT) continue;
+        if (exists && stats[i].stx_size == requests[i].contents.size() &&
+            output::matches(requests[i].path, requests[i].contents)) {
+            requests[i].result = WRITE_UNCHANGED;
+            pending[i] = false;
+            continue;
+        }
+        temporaries[i] = output::temporary(requests[i].path).native();
+        io_uring_sqe *sqe = this->_ring->prepare(IORING_OP_OPENAT, i);
+        sqe->fd = AT_FDCWD;
+        sqe->addr = reinterpret_cast<std::uintptr_t>(temporaries[i].c_str());
+        sqe->open_flags = O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC;
+        sqe->len = 0666;
+    }
+    ring_ok = ring_ok && this->_ring->run(fds);
+
+    for (std::size_t i = 0; ring_ok && i < count; i++) {
+        if (fds[i] < 0) continue;
+        const std::string &contents = requests[i].contents;
+        io_uring_sqe *sqe = this->_ring->prepare(IORING_OP_WRITE, i);
+        sqe->fd = fds[i];
+        sqe->addr = reinterpret_cast<std::uintptr_t>(contents.data());
+        sqe->len = static_cast<std::uint32_t>(contents.size());
+    }
+    ring_ok = ring_ok && this->_ring->run(writes);
+
+    // The replacement keeps the permissions of the file it replaces,
+    // and its contents reach the disk before the rename makes it visible.
+    std::vector<bool> written(count, false);
+    for (std::size_t i = 0; i < count; i++) {
+        if (fds[i] < 0) continue;
+        written[i] = writes[i] >= 0 &&
+                     write_rest(fds[i], requests[i].contents,
+                                static_cast<std::size_t>(writes[i])) &&
+                     (results[i] != 0 ||
+                      fchmod(fds[i], stats[i].stx_mode & 07777) == 0);
+        if (!written[i]) continue;
+        if (ring_ok) {
+            io_uring_sqe *sqe = this->_ring->prepare(IORING_OP_FSYNC, i);
+            sqe->fd = fds[i];
+        } else {
+            syncs[i] = fsync(fds[i]);
+        }
+    }
+    if (ring_ok && this->_ring->prepared) ring_ok = this->_ring->run(syncs);
+
+    for (std::size_t i = 0; i < count; i++) {
+        if (fds[i] < 0) continue;
+        if (syncs[i] < 0) written[i] = false;
+        if (ring_ok) {
+            io_uring_sqe *sqe = this->_ring->prepare(IORING_OP_CLOSE, i);
+            sqe->fd = fds[i];
+        } else {
+            closes[i] = close(fds[i]);
+        }
+    }
+    if (ring_ok && this->_ring->prepared) ring_ok = this->_ring->run(closes);
+
+    for (std::size_t i = 0; ring_ok && i < count; i++) {
+        if (!written[i] || closes[i] < 0) continue;
+        io_uring_sqe *sqe = this->_ring->prepare(IORING_OP_RENAMEAT, i);
+        sqe->fd = AT_FDCWD;
+        sqe->addr = reinterpret_cast<std::uintptr_t>(temporaries[i].c_str());
+        sqe->len = static_cast<std::uint32_t>(AT_FDCWD);
+        sqe->off = reinterpret_cast<std::uintptr_t>(requests[i].path.c_str());
+    }
+    if (ring_ok && this->_ring->prepared) ring_ok = this->_ring->run(renames);
+
+    if (!ring_ok) this->_ring.reset();
+    for (std::size_t i = 0; i < count; i++) {
+        if (!pending[i]) continue;
+        if (renames[i] == 0) {
+            requests[i].result = WRITE_CHANGED;
+            continue;
+        }
+        if (fds[i] >= 0) unlink(temporaries[i].c_str());
+        requests[i].result = output::write(requests[i].path,
+                                           requests[i].contents);
+    }
+}
+
+#else
+
+void batch_io::_read_ring(read_request *requests, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) _read_blocking(requests[i]);
+}
+
+void batch_io::_write_ring(write_request *requests, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) {
+        requests[i].result = output::write(requests[i].path,
+                                           requests[i].contents);
+    }
+}
+
+#endif
+
+}  // namespace sparkdown
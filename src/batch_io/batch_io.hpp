@@ -0,0 +1,205 @@
+/**
+ * @file batch_io/batch_io.hpp
+ * @package //batch_io:batch_io
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `batch_io` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `batch_io` class,
+ *     which reads and writes many small files at once.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef BATCH_IO_HPP
+#define BATCH_IO_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "output/output.hpp"
+
+namespace sparkdown {
+
+/**
+ * @brief An enumeration of the ways `batch_io` can reach the disk.
+ *
+ */
+enum io_backend {
+    IO_AUTO,      // io_uring where the kernel allows it; blocking otherwise.
+    IO_URING,     // Batches of operations queued on an io_uring.
+    IO_BLOCKING,  // One blocking system call at a time.
+};
+
+/**
+ * @brief A file to be read by `batch_io#read()`.
+ *
+ */
+struct read_request {
+    /**
+     * @brief The file to read.
+     *
+     */
+    std::filesystem::path path;
+
+    /**
+     * @brief The expected size of the file, e.g., from a directory listing.
+     * @details The file is read whole even if the hint is wrong;
+     *     a right hint just saves a read.
+     *
+     */
+    std::size_t size_hint = 0;
+
+    /**
+     * @brief Receives the contents of the file.
+     *
+     */
+    std::string contents;
+
+    /**
+     * @brief Set once the file has been read whole.
+     *
+     */
+    bool ok = false;
+};
+
+/**
+ * @brief A file to be written by `batch_io#write()`.
+ *
+ */
+struct write_request {
+    /**
+     * @brief The file to write. Its directory must exist.
+     *
+     */
+    std::filesystem::path path;
+
+    /**
+     * @brief The contents to write.
+     *
+     */
+    std::string contents;
+
+    /**
+     * @brief Receives whether the file was changed, was unchanged, or failed.
+     *
+     */
+    write_result result = WRITE_FAILED;
+};
+
+/**
+ * @brief Reads and writes many small files at once.
+ * @details Transpiling thousands of small notes spends most of its time
+ *     on system calls: a `stat`, `open`, `read` or `write`, and `close`
+ *     for every file. With io_uring, each of those steps is queued
+ *     for a whole batch of files, and the batch is submitted
+ *     with a single system call, so the cost of the call is shared.
+ *
+ *     Where io_uring is missing (an older kernel, another platform,
+ *     or a sandbox that forbids it), each file is read and written
+ *     with blocking calls instead, with the same results.
+ *     Any file that fails on the ring is also retried the blocking way,
+ *     so that an operation the kernel does not know yet
+ *     costs speed, not correctness.
+ *
+ *     Writes keep the guarantees of `output::write()`:
+ *     files that already hold the contents are left untouched,
+ *     and the others are replaced atomically, keeping their permissions,
+ *     once their new contents are synced. Symlinks and files
+ *     that are not regular files are handed to `output::write()` itself.
+ *
+ *     An instance must only be used by one thread at a time.
+ *
+ */
+class batch_io {
+   private:
+    /**
+     * @brief The io_uring, if one is in use. Defined in the implementation.
+     *
+     */
+    struct ring;
+
+    /**
+     * @brief The io_uring, or null when blocking.
+     *
+     */
+    std::unique_ptr<ring> _ring;
+
+    /**
+     * @brief The most files handled per batch.
+     *
+     */
+    std::size_t _depth;
+
+    /**
+     * @brief Reads the given files with io_uring.
+     *
+     * @param requests The first file to read.
+     * @param count The number of files, at most `_depth`.
+     */
+    void _read_ring(read_request *requests, std::size_t count);
+
+    /**
+     * @brief Writes the given files with io_uring.
+     *
+     * @param requests The first file to write.
+     * @param count The number of files, at most `_depth`.
+     */
+    void _write_ring(write_request *requests, std::size_t count);
+
+    /**
+     * @brief Reads the given file with blocking calls.
+     *
+     * @param request The file to read.
+     */
+    static void _read_blocking(read_request &request);
+
+   public:
+    /**
+     * @brief Constructor.
+     *
+     * @param backend The backend to use. `IO_URING` falls back
+     *     to blocking calls if the ring cannot be set up.
+     * @param depth The most files handled per batch.
+     */
+    explicit batch_io(io_backend backend = IO_AUTO, std::size_t depth = 64);
+
+    /**
+     * @brief Destructor. Closes the ring, if there is one.
+     *
+     */
+    ~batch_io();
+
+    batch_io(const batch_io &) = delete;
+    batch_io &operator=(const batch_io &) = delete;
+
+    /**
+     * @brief Returns the backend in use: `IO_URING` or `IO_BLOCKING`.
+     *
+     * @return The backend.
+     */
+    [[nodiscard]] io_backend backend() const;
+
+    /**
+     * @brief Reads the given files, a batch at a time.
+     *
+     * @param requests The files to read.
+     */
+    void read(std::vector<read_request> &requests);
+
+    /**
+     * @brief Writes the given files, a batch at a time.
+     *
+     * @param requests The files to write.
+     */
+    void write(std::vector<write_request> &requests);
+};
+
+}  // namespace sparkdown
+
+#endif
@@ -0,0 +1,163 @@
+/**
+ * @file batch_io/batch_io.tests.cpp
+ * @package //batch_io:batch_io.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `batch_io` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `batch_io` class,
+ *     which reads and writes many small files at once.
+ *     Every test is run against both backends.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunknown-pragmas"
+#pragma ide diagnostic ignored "UnusedLocalVariable"
+
+#include "batch_io.hpp"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "scratch/scratch.hpp"
+
+/**
+ * @brief The backends to test.
+ *
+ */
+static const sparkdown::io_backend backends[] = {sparkdown::IO_URING,
+                                                 sparkdown::IO_BLOCKING};
+
+/**
+ * @brief `batch_io#backend()` test.
+ * @details Ensures that the blocking backend is used when asked for,
+ *     and that asking for io_uring gives one backend or the other.
+ *
+ */
+TEST(batch_io, backend) {
+    EXPECT_EQ(sparkdown::batch_io(sparkdown::IO_BLOCKING).backend(),
+              sparkdown::IO_BLOCKING);
+    EXPECT_NE(sparkdown::batch_io(sparkdown::IO_URING).backend(),
+              sparkdown::IO_AUTO);
+}
+
+/**
+ * @brief `batch_io#read()` test.
+ * @details Ensures that files are read whole whatever their size hints,
+ *     across more than one batch, and that missing files fail.
+ *
+ */
+TEST(batch_io, read) {
+    std::filesystem::path dir = sparkdown::scratch::directory("batch-io-read");
+    const std::string large(100000, 'x');
+    std::ofstream(dir / "empty._", std::ios::binary);
+    std::ofstream(dir / "small._", std::ios::binary) << "small";
+    std::ofstream(dir / "large._", std::ios::binary) << large;
+
+    for (sparkdown::io_backend backend : backends) {
+        sparkdown::batch_io io(backend, 2);
+        const std::pair<const char *, std::size_t> files[] = {
+            {"empty._", 0},  {"small._", 5},       {"small._", 0},
+            {"large._", 10}, {"large._", 1 << 20}, {"missing._", 0}};
+        std::vector<sparkdown::read_request> requests(6);
+        for (std::size_t i = 0; i < requests.size(); i++) {
+            requests[i].path = dir / files[i].first;
+            requests[i].size_hint = files[i].second;
+        }
+        io.read(requests);
+
+        for (std::size_t i = 0; i < 5; i++) EXPECT_TRUE(requests[i].ok) << i;
+        EXPECT_EQ(requests[0].contents, "");
+        EXPECT_EQ(requests[1].contents, "small");
+        EXPECT_EQ(requests[2].contents, "small");
+        EXPECT_EQ(requests[3].contents, large);
+        EXPECT_EQ(requests[4].contents, large);
+        EXPECT_FALSE(requests[5].ok);
+    }
+}
+
+/**
+ * @brief `batch_io#write()` test.
+ * @details Ensures that files are created and replaced,
+ *     that files with the same contents are left alone,
+ *     that files in missing directories fail,
+ *     and that no temporary files are left behind.
+ *
+ */
+TEST(batch_io, write) {
+    for (sparkdown::io_backend backend : backends) {
+        std::filesystem::path dir =
+            sparkdown::scratch::directory("batch-io-write");
+        std::ofstream(dir / "same.tex", std::ios::binary) << "same";
+        std::ofstream(dir / "old.tex", std::ios::binary) << "old";
+        std::ofstream(dir / "size.tex", std::ios::binary) << "abcd";
+
+        sparkdown::batch_io io(backend, 2);
+        std::vector<sparkdown::write_request> requests(5);
+        requests[0] = {dir / "same.tex", "same"};
+        requests[1] = {dir / "old.tex", "replaced"};
+        requests[2] = {dir / "size.tex", "wxyz"};
+        requests[3] = {dir / "new.tex", std::string(100000, 'n')};
+        requests[4] = {dir / "missing" / "file.tex", "lost"};
+        io.write(requests);
+
+        EXPECT_EQ(requests[0].result, sparkdown::WRITE_UNCHANGED);
+        EXPECT_EQ(requests[1].result, sparkdown::WRITE_CHANGED);
+        EXPECT_EQ(requests[2].result, sparkdown::WRITE_CHANGED);
+        EXPECT_EQ(requests[3].result, sparkdown::WRITE_CHANGED);
+        EXPECT_EQ(requests[4].result, sparkdown::WRITE_FAILED);
+
+        EXPECT_EQ(sparkdown::scratch::read_file(dir / "old.tex"), "replaced");
+        EXPECT_EQ(sparkdown::scratch::read_file(dir / "size.tex"), "wxyz");
+        EXPECT_EQ(sparkdown::scratch::read_file(dir / "new.tex"),
+                  std::string(100000, 'n'));
+
+        std::size_t files = 0;
+        for (const auto &item : std::filesystem::directory_iterator(dir)) {
+            if (item.is_regular_file()) files++;
+        }
+        EXPECT_EQ(files, 4);
+    }
+}
+
+/**
+ * @brief `batch_io#write()` link and permissions test.
+ * @details Ensures that a symlinked destination keeps its link,
+ *     with the file it points to replaced,
+ *     and that a replaced file keeps its permissions.
+ *
+ */
+TEST(batch_io, keeps_links_and_modes) {
+    for (sparkdown::io_backend backend : backends) {
+        std::filesystem::path dir =
+            sparkdown::scratch::directory("batch-io-links");
+        sparkdown::scratch::write_file(dir / "target.tex", "old");
+        std::filesystem::create_symlink(dir / "target.tex", dir / "link.tex");
+        sparkdown::scratch::write_file(dir / "private.tex", "old");
+        const auto mode = std::filesystem::perms::owner_read |
+                          std::filesystem::perms::owner_write;
+        std::filesystem::permissions(dir / "private.tex", mode);
+
+        sparkdown::batch_io io(backend, 2);
+        std::vector<sparkdown::write_request> requests(2);
+        requests[0] = {dir / "link.tex", "linked"};
+        requests[1] = {dir / "private.tex", "private"};
+        io.write(requests);
+
+        EXPECT_EQ(requests[0].result, sparkdown::WRITE_CHANGED);
+        EXPECT_EQ(requests[1].result, sparkdown::WRITE_CHANGED);
+        EXPECT_TRUE(std::filesystem::is_symlink(dir / "link.tex"));
+        EXPECT_EQ(sparkdown::scratch::read_file(dir / "target.tex"), "linked");
+        EXPECT_EQ(sparkdown::scratch::read_file(dir / "private.tex"),
+                  "private");
+        EXPECT_EQ(std::filesystem::status(dir / "private.tex").permissions(),
+                  mode);
+    }
+}
+
+#pragma clang diagnostic pop
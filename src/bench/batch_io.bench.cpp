@@ -0,0 +1,145 @@
+/**
+ * @file bench/batch_io.bench.cpp
+ * @package //bench:batch_io.bench
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief Batched file I/O benchmarks.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file benchmarks reading a generated tree of small notes,
+ *     and building it with `vault`, with each `batch_io` backend.
+ *     The first argument of each benchmark is the backend
+ *     (0 for io_uring, 1 for blocking calls), and the second the number
+ *     of files. The tree is generated once, in the temporary directory.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "batch_io/batch_io.hpp"
+#include "bench/documents.hpp"
+#include "vault/vault.hpp"
+
+/**
+ * @brief The number of notes in each directory of a generated tree.
+ *
+ */
+static constexpr std::size_t notes_per_directory = 500;
+
+/**
+ * @brief Returns a tree of the given number of small notes,
+ *     generating it if it does not exist yet.
+ *
+ * @param count The number of notes.
+ * @return The root of the tree.
+ */
+static std::filesystem::path tree(std::size_t count) {
+    std::filesystem::path root = std::filesystem::temp_directory_path() /
+                                 ("sparkdown-bench-tree-" +
+                                  std::to_string(count));
+    std::filesystem::path done = root / ".complete";
+    if (std::filesystem::exists(done)) return root;
+
+    std::filesystem::remove_all(root);
+    std::vector<std::string> notes;
+    for (std::size_t size = 256; size <= 2048; size += 256) {
+        notes.push_back(sparkdown::bench::document(size));
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        std::filesystem::path directory =
+            root / "notes" / std::to_string(i / notes_per_directory);
+        if (i % notes_per_directory == 0) {
+            std::filesystem::create_directories(directory);
+        }
+        std::ofstream(directory / (std::to_string(i) + "._"), std::ios::binary)
+            << notes[i % notes.size()];
+    }
+    std::ofstream(done, std::ios::binary);
+    return root;
+}
+
+/**
+ * @brief Benchmarks `batch_io#read()` over every note in a tree.
+ *
+ */
+static void batch_io_read(benchmark::State &state) {
+    std::filesystem::path root = tree(state.range(1));
+    std::vector<sparkdown::read_request> requests;
+    for (const auto &item :
+         std::filesystem::recursive_directory_iterator(root / "notes")) {
+        if (!item.is_regular_file()) continue;
+        requests.emplace_back();
+        requests.back().path = item.path();
+        requests.back().size_hint = item.file_size();
+    }
+
+    sparkdown::batch_io io(
+        static_cast<sparkdown::io_backend>(sparkdown::IO_URING +
+                                           state.range(0)));
+    if (io.backend() != sparkdown::IO_URING + state.range(0)) {
+        state.SkipWithError("io_uring is not available");
+        return;
+    }
+
+    for (auto _ : state) {
+        io.read(requests);
+        benchmark::DoNotOptimize(requests.data());
+    }
+
+    state.counters["files"] =
+        benchmark::Counter(static_cast<double>(requests.size()),
+                           benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(batch_io_read)
+    ->Args({0, 1 << 10})
+    ->Args({1, 1 << 10})
+    ->Args({0, 50000})
+    ->Args({1, 50000})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/**
+ * @brief Benchmarks a full `vault#build()` of a tree into an empty directory.
+ *
+ */
+static void vault_build(benchmark::State &state) {
+    std::filesystem::path root = tree(state.range(1));
+    std::filesystem::path output = root / "build";
+    auto backend = static_cast<sparkdown::io_backend>(sparkdown::IO_URING +
+                                                      state.range(0));
+    if (sparkdown::batch_io(backend).backend() != backend) {
+        state.SkipWithError("io_uring is not available");
+        return;
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::filesystem::remove_all(output);
+        state.ResumeTiming();
+
+        sparkdown::vault vault(root / "notes", output, 0, backend);
+        sparkdown::vault_report report = vault.build();
+        if (!report.failed.empty()) {
+            state.SkipWithError("build failed");
+            break;
+        }
+    }
+
+    state.counters["files"] =
+        benchmark::Counter(static_cast<double>(state.range(1)),
+                           benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(vault_build)
+    ->Args({0, 1 << 10})
+    ->Args({1, 1 << 10})
+    ->Args({0, 50000})
+    ->Args({1, 50000})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
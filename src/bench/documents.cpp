@@ -0,0 +1,53 @@
+/**
+ * @file bench/documents.cpp
+ * @package //bench:documents
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief Benchmark input documents.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file builds the input documents shared by the benchmarks.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "documents.hpp"
+
+#include "corpus/corpus.hpp"
+
+namespace sparkdown::bench {
+
+std::string document(std::size_t size) {
+    return corpus(1).generate(size);
+}
+
+std::string code_document(std::size_t size) {
+    corpus_mix mix;
+    mix.verbatim = 60;
+    return corpus(1, mix).generate(size);
+}
+
+std::string math_document(std::size_t size) {
+    corpus_mix mix;
+    mix.math = 40;
+    return corpus(1, mix).generate(size);
+}
+
+std::string list_document(std::size_t size) {
+    std::string document;
+    for (std::size_t i = 0; document.size() < size; i++) {
+        std::size_t depth = i % 20 < 10 ? i % 20 : 19 - i % 20;
+        document.append(2 * depth, ' ');
+        document += i % 3 == 0 ? "1. An item\n" : "* An item\n";
+        if (i % 7 == 0) {
+            document.append(2 * depth + 2, ' ');
+            document += "\\\\ continued\n";
+        }
+    }
+    return document;
+}
+
+}  // namespace sparkdown::bench
@@ -0,0 +1,66 @@
+/**
+ * @file bench/documents.hpp
+ * @package //bench:documents
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief Benchmark input documents.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file declares the functions that build the input documents
+ *     shared by the benchmarks.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef DOCUMENTS_HPP
+#define DOCUMENTS_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace sparkdown::bench {
+
+/**
+ * @brief Returns a realistic Sparkdown document of about the given size.
+ * @details The document is generated by `corpus` with a fixed seed,
+ *     so every benchmark sees the same input on every run.
+ *
+ * @param size The size of the document, in bytes.
+ * @return The document.
+ */
+std::string document(std::size_t size);
+
+/**
+ * @brief Returns a code-heavy Sparkdown document of about the given size.
+ * @details Like `document()`, but about 60% of the text
+ *     is in verbatim blocks.
+ *
+ * @param size The size of the document, in bytes.
+ * @return The document.
+ */
+std::string code_document(std::size_t size);
+
+/**
+ * @brief Returns a formula-dense Sparkdown document of about the given size.
+ * @details Like `document()`, but most of the blocks are display math.
+ *
+ * @param size The size of the document, in bytes.
+ * @return The document.
+ */
+std::string math_document(std::size_t size);
+
+/**
+ * @brief Returns a single long list of about the given size.
+ * @details The items are nested ten levels deep and back again,
+ *     over and over, with the kinds of list mixed,
+ *     so that lists are opened and closed on almost every line.
+ *
+ * @param size The size of the document, in bytes.
+ * @return The document.
+ */
+std::string list_document(std::size_t size);
+
+}  // namespace sparkdown::bench
+
+#endif
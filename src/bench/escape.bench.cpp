@@ -0,0 +1,75 @@
+/**
+ * @file bench/escape.bench.cpp
+ * @package //bench:escape.bench
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `escape` class benchmarks.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file benchmarks the `escape` class,
+ *     which escapes the characters that are special to LaTeX,
+ *     comparing the vectorized kernel against the scalar reference.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "bench/documents.hpp"
+#include "escape/escape.hpp"
+
+/**
+ * @brief Benchmarks `escape#append()`.
+ *
+ */
+static void escape_append(benchmark::State &state) {
+    const std::string input = sparkdown::bench::document(state.range(0));
+    std::string output;
+
+    for (auto _ : state) {
+        output.clear();
+        sparkdown::escape::append(input, sparkdown::ESCAPE_TEXT, output);
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(escape_append)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+/**
+ * @brief Benchmarks `escape#append_scalar()`, the reference implementation.
+ *
+ */
+static void escape_append_scalar(benchmark::State &state) {
+    const std::string input = sparkdown::bench::document(state.range(0));
+    std::string output;
+
+    for (auto _ : state) {
+        output.clear();
+        sparkdown::escape::append_scalar(input, sparkdown::ESCAPE_TEXT, output);
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(escape_append_scalar)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+/**
+ * @brief Benchmarks `escape#append()` for HTML text,
+ *     as the HTML emitter uses it.
+ *
+ */
+static void escape_append_html(benchmark::State &state) {
+    const std::string input = sparkdown::bench::document(state.range(0));
+    std::string output;
+
+    for (auto _ : state) {
+        output.clear();
+        sparkdown::escape::append(input, sparkdown::ESCAPE_HTML, output);
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(escape_append_html)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
@@ -0,0 +1,94 @@
+/**
+ * @file bench/lexer.bench.cpp
+ * @package //bench:lexer.bench
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `lexer` class benchmarks.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file benchmarks the `lexer` class,
+ *     which is used to lex a string into a sequence of tokens.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <memory_resource>
+
+#include "bench/documents.hpp"
+#include "lexer/lexer.hpp"
+
+/**
+ * @brief Benchmarks `lexer#lex()` followed by the copying
+ *     `lexer#get_tokens()`, starting from an empty lexer every time.
+ *
+ */
+static void lexer_lex_copy(benchmark::State &state) {
+    const std::string input = sparkdown::bench::document(state.range(0));
+
+    for (auto _ : state) {
+        sparkdown::lexer lexer;
+        lexer.lex(input);
+        sparkdown::token_list tokens = lexer.get_tokens();
+        benchmark::DoNotOptimize(tokens);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+    state.counters["tokens"] =
+        benchmark::Counter(static_cast<double>(input.size()),
+                           benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(lexer_lex_copy)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+/**
+ * @brief Benchmarks `lexer#lex()` with a new lexer every time,
+ *     drawing its tokens from a new monotonic arena.
+ * @details Compare with `lexer_lex_copy`: the arena is released whole,
+ *     instead of one token node at a time.
+ *
+ */
+static void lexer_lex_arena(benchmark::State &state) {
+    const std::string input = sparkdown::bench::document(state.range(0));
+
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource arena;
+        sparkdown::lexer lexer(&arena);
+        lexer.lex(input);
+        sparkdown::token_list tokens(&arena);
+        lexer.get_tokens(tokens);
+        benchmark::DoNotOptimize(tokens);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+    state.counters["tokens"] =
+        benchmark::Counter(static_cast<double>(input.size()),
+                           benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(lexer_lex_arena)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+/**
+ * @brief Benchmarks `lexer#lex()` followed by the moving
+ *     `lexer#get_tokens()`, recycling the tokens between iterations.
+ * @details This is the steady state of a reused `compiler`.
+ *
+ */
+static void lexer_lex_recycled(benchmark::State &state) {
+    const std::string input = sparkdown::bench::document(state.range(0));
+    sparkdown::lexer lexer;
+    sparkdown::token_list tokens;
+
+    for (auto _ : state) {
+        lexer.lex(input);
+        lexer.get_tokens(tokens);
+        benchmark::DoNotOptimize(tokens);
+        lexer.recycle(tokens);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+    state.counters["tokens"] =
+        benchmark::Counter(static_cast<double>(input.size()),
+                           benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(lexer_lex_recycled)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
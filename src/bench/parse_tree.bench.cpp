@@ -0,0 +1,98 @@
+/**
+ * @file bench/parse_tree.bench.cpp
+ * @package //bench:parse_tree.bench
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief Saved parse tree benchmarks.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file benchmarks writing a document with the LaTeX and HTML
+ *     backends, from its text, against replaying its saved parse tree.
+ *     The tree is saved in the temporary directory.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <string>
+
+#include "bench/documents.hpp"
+#include "compiler/compiler.hpp"
+#include "emitter/html_emitter.hpp"
+#include "emitter/latex_emitter.hpp"
+#include "hash/hash.hpp"
+#include "parse_tree/parse_tree.hpp"
+#include "parse_tree/tree_emitter.hpp"
+
+/**
+ * @brief Benchmarks `compiler#compile()` with both backends.
+ *
+ */
+static void parse_tree_compile(benchmark::State &state) {
+    const std::string document = sparkdown::bench::document(state.range(0));
+    sparkdown::compiler compiler;
+    std::string latex;
+    std::string html;
+    sparkdown::latex_emitter latex_emitter(latex);
+    sparkdown::html_emitter html_emitter(html);
+
+    for (auto _ : state) {
+        if (compiler.compile(document, {&latex_emitter, &html_emitter}) !=
+            sparkdown::COMPILE_OK) {
+            state.SkipWithError("compilation failed");
+            break;
+        }
+        benchmark::DoNotOptimize(latex.data());
+        benchmark::DoNotOptimize(html.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * document.size());
+}
+BENCHMARK(parse_tree_compile)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+/**
+ * @brief Benchmarks opening a saved parse tree and replaying it
+ *     with both backends, as a rebuild of an unchanged document would.
+ *
+ */
+static void parse_tree_emit(benchmark::State &state) {
+    const std::string document = sparkdown::bench::document(state.range(0));
+    const std::uint64_t hash = sparkdown::hash::of(document);
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() /
+        ("sparkdown-bench-" + std::to_string(state.range(0)) + ".tree");
+    {
+        sparkdown::compiler compiler;
+        std::string text;
+        sparkdown::tree_emitter tree_emitter(text);
+        if (compiler.compile(document, {&tree_emitter}) !=
+                sparkdown::COMPILE_OK ||
+            tree_emitter.save(path, hash) == sparkdown::WRITE_FAILED) {
+            state.SkipWithError("saving the tree failed");
+            return;
+        }
+    }
+
+    std::string latex;
+    std::string html;
+    sparkdown::latex_emitter latex_emitter(latex);
+    sparkdown::html_emitter html_emitter(html);
+    sparkdown::parse_tree tree;
+
+    for (auto _ : state) {
+        if (!tree.open(path, hash) ||
+            tree.emit({&latex_emitter, &html_emitter}) !=
+                sparkdown::COMPILE_OK) {
+            state.SkipWithError("replaying the tree failed");
+            break;
+        }
+        benchmark::DoNotOptimize(latex.data());
+        benchmark::DoNotOptimize(html.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * document.size());
+}
+BENCHMARK(parse_tree_emit)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
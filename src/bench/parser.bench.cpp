@@ -0,0 +1,65 @@
+/**
+ * @file bench/parser.bench.cpp
+ * @package //bench:parser.bench
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `parser` class benchmarks.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file benchmarks the `parser` class,
+ *     which is used to parse a sequence of tokens into
+ *     a model of syntactic meaning.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "bench/documents.hpp"
+#include "compiler/compiler.hpp"
+#include "lexer/lexer.hpp"
+#include "parser/parser.hpp"
+
+/**
+ * @brief Benchmarks `parser#parse()` with the given pattern pack.
+ * @details The input is lexed again outside of the timed region
+ *     before every iteration, because parsing modifies it.
+ *
+ */
+template <class parser_type>
+static void parser_parse(benchmark::State &state) {
+    const std::string input = sparkdown::bench::document(state.range(0));
+    sparkdown::lexer lexer;
+    sparkdown::token_list tokens;
+    parser_type parser;
+    std::size_t count = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        lexer.recycle(tokens);
+        lexer.lex(input);
+        lexer.get_tokens(tokens);
+        count = tokens.size();
+        parser.reset();
+        state.ResumeTiming();
+
+        parser.parse(tokens);
+        benchmark::DoNotOptimize(tokens);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+    state.counters["tokens"] =
+        benchmark::Counter(static_cast<double>(count),
+                           benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// No patterns at all: the cost of walking the token list.
+BENCHMARK_TEMPLATE(parser_parse, sparkdown::parser<>)
+    ->RangeMultiplier(32)
+    ->Range(1 << 10, 1 << 20);
+
+// The patterns used by the compiler.
+BENCHMARK_TEMPLATE(parser_parse, sparkdown::compiler::default_parser)
+    ->RangeMultiplier(32)
+    ->Range(1 << 10, 1 << 20);
@@ -0,0 +1,170 @@
+/**
+ * @file bench/pipeline.bench.cpp
+ * @package //bench:pipeline.bench
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief Pipelined driver benchmarks.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file benchmarks the `pipeline` class against reading,
+ *     transpiling, and writing one after another,
+ *     with a simulated slow disk on both ends.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "bench/documents.hpp"
+#include "module_cache/module_cache.hpp"
+#include "pipeline/pipeline.hpp"
+
+namespace {
+
+/**
+ * @brief The number of bytes a slow stream moves at a time.
+ *
+ */
+constexpr std::size_t slow_block = 4 << 10;
+
+/**
+ * @brief The time a slow stream takes to move each block.
+ *
+ */
+constexpr std::chrono::microseconds slow_delay(100);
+
+/**
+ * @brief A stream buffer that reads from a string, or writes to one,
+ *     a block at a time, sleeping before each block as a slow disk would.
+ *
+ */
+class slow_buffer : public std::streambuf {
+   private:
+    /**
+     * @brief The text to read, or the text written so far.
+     *
+     */
+    std::string _text;
+
+    /**
+     * @brief The number of bytes read so far.
+     *
+     */
+    std::size_t _position = 0;
+
+   protected:
+    int_type underflow() override {
+        if (this->_position == this->_text.size()) return traits_type::eof();
+        std::this_thread::sleep_for(slow_delay);
+        std::size_t size =
+            std::min(slow_block, this->_text.size() - this->_position);
+        char *start = this->_text.data() + this->_position;
+        this->setg(start, start, start + size);
+        this->_position += size;
+        return traits_type::to_int_type(*start);
+    }
+
+    std::streamsize xsputn(const char *text, std::streamsize count) override {
+        for (std::streamsize done = 0; done < count;) {
+            std::this_thread::sleep_for(slow_delay);
+            std::streamsize size = std::min(
+                count - done, static_cast<std::streamsize>(slow_block));
+            this->_text.append(text + done, static_cast<std::size_t>(size));
+            done += size;
+        }
+        return count;
+    }
+
+   public:
+    /**
+     * @brief Constructor.
+     *
+     * @param text The text to read. Empty for writing.
+     */
+    explicit slow_buffer(std::string text = {}) : _text(std::move(text)) {}
+
+    /**
+     * @brief Returns the text written so far.
+     *
+     * @return The text.
+     */
+    [[nodiscard]] const std::string &text() const { return this->_text; }
+};
+
+}  // namespace
+
+/**
+ * @brief Benchmarks reading the whole document, transpiling it,
+ *     and then writing it, one after another, on slow streams.
+ *
+ */
+static void pipeline_sequential(benchmark::State &state) {
+    const std::string document = sparkdown::bench::document(state.range(0));
+    sparkdown::module_cache modules;
+    std::string input;
+    std::string latex;
+
+    for (auto _ : state) {
+        slow_buffer source(document);
+        slow_buffer sink;
+        std::istream in(&source);
+        std::ostream out(&sink);
+
+        input.assign(std::istreambuf_iterator<char>(in),
+                     std::istreambuf_iterator<char>());
+        if (modules.compile(input, ".", latex) != sparkdown::COMPILE_OK) {
+            state.SkipWithError("compilation failed");
+            break;
+        }
+        out.write(latex.data(), static_cast<std::streamsize>(latex.size()));
+        benchmark::DoNotOptimize(sink.text());
+    }
+
+    state.SetBytesProcessed(state.iterations() * document.size());
+}
+BENCHMARK(pipeline_sequential)
+    ->Arg(1 << 10)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/**
+ * @brief Benchmarks `pipeline#run()` on slow streams.
+ *
+ */
+static void pipeline_run(benchmark::State &state) {
+    const std::string document = sparkdown::bench::document(state.range(0));
+    sparkdown::module_cache modules;
+    sparkdown::pipeline pipeline(modules, slow_block * 4);
+
+    for (auto _ : state) {
+        slow_buffer source(document);
+        slow_buffer sink;
+        std::istream in(&source);
+        std::ostream out(&sink);
+
+        if (pipeline.run(in, ".", out) != sparkdown::COMPILE_OK) {
+            state.SkipWithError("compilation failed");
+            break;
+        }
+        benchmark::DoNotOptimize(sink.text());
+    }
+
+    state.SetBytesProcessed(state.iterations() * document.size());
+}
+BENCHMARK(pipeline_run)
+    ->Arg(1 << 10)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
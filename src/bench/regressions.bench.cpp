@@ -0,0 +1,92 @@
+/**
+ * @file bench/regressions.bench.cpp
+ * @package //bench:regressions.bench
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief Complexity regression benchmarks.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file benchmarks the worst-case inputs
+ *     found by `//fuzz:complexity.fuzz`, kept in `bench/regressions/`.
+ *
+ *     Each input is repeated up to each benchmarked size,
+ *     and Google Benchmark fits the running times to a complexity class,
+ *     which should stay O(N). The work done per byte is also reported,
+ *     and should stay constant across sizes.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "compiler/compiler.hpp"
+#include "stats/stats.hpp"
+
+/**
+ * @brief The directory of the regression cases,
+ *     relative to the workspace root.
+ *
+ */
+static const char *const regressions = "bench/regressions";
+
+/**
+ * @brief Benchmarks `compiler#compile()` on the given case,
+ *     repeated up to the benchmarked size.
+ *
+ */
+static void regression(benchmark::State &state, const std::string &seed) {
+    std::string input;
+    while (input.size() < static_cast<std::size_t>(state.range(0))) {
+        input += seed;
+    }
+
+    sparkdown::compiler compiler;
+    sparkdown::compile_stats stats;
+    std::string output;
+    compiler.set_stats(&stats);
+    compiler.compile(input, output);
+    compiler.set_stats(nullptr);
+
+    for (auto _ : state) {
+        compiler.compile(input, output);
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+    state.SetComplexityN(static_cast<std::int64_t>(input.size()));
+    state.counters["work_per_byte"] = stats.work_per_byte();
+}
+
+/**
+ * @brief Registers one benchmark for each case in `bench/regressions/`.
+ *
+ * @return True once done.
+ */
+static bool register_regressions() {
+    std::error_code error;
+    for (const auto &entry :
+         std::filesystem::directory_iterator(regressions, error)) {
+        if (entry.path().extension() != "._") continue;
+
+        std::ifstream file(entry.path(), std::ios::binary);
+        std::string seed(std::istreambuf_iterator<char>(file),
+                         std::istreambuf_iterator<char>{});
+        if (seed.empty()) continue;
+
+        std::string name = "regression/" + entry.path().stem().string();
+        benchmark::RegisterBenchmark(name.c_str(), regression, seed)
+            ->RangeMultiplier(32)
+            ->Range(1 << 10, 1 << 20)
+            ->Complexity();
+    }
+    return true;
+}
+
+[[maybe_unused]] static const bool registered = register_regressions();
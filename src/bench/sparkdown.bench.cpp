@@ -0,0 +1,328 @@
+/**
+ * @file bench/sparkdown.bench.cpp
+ * @package //bench:sparkdown.bench
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief End-to-end benchmarks.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file benchmarks whole transpiles,
+ *     through both the `compiler` class and the `sparkdown` driver class.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <vector>
+
+#include "bench/documents.hpp"
+#include "compiler/compiler.hpp"
+#include "emitter/html_emitter.hpp"
+#include "emitter/latex_emitter.hpp"
+#include "sparkdown/sparkdown.hpp"
+
+/**
+ * @brief Benchmarks `compiler#compile()` with a reused compiler
+ *     and output buffer.
+ *
+ */
+static void compiler_compile(benchmark::State &state) {
+    const std::string input = sparkdown::bench::document(state.range(0));
+    sparkdown::compiler compiler;
+    std::string output;
+
+    for (auto _ : state) {
+        if (compiler.compile(input, output) != sparkdown::COMPILE_OK) {
+            state.SkipWithError("compilation failed");
+            break;
+        }
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+    state.counters["tokens"] =
+        benchmark::Counter(static_cast<double>(input.size()),
+                           benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(compiler_compile)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+/**
+ * @brief Benchmarks `compiler#compile()` with a new compiler
+ *     for every document, as a one-shot driver does.
+ *
+ */
+static void compiler_compile_cold(benchmark::State &state) {
+    const std::string input = sparkdown::bench::document(state.range(0));
+    std::string output;
+
+    for (auto _ : state) {
+        sparkdown::compiler compiler;
+        if (compiler.compile(input, output) != sparkdown::COMPILE_OK) {
+            state.SkipWithError("compilation failed");
+            break;
+        }
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(compiler_compile_cold)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+/**
+ * @brief Benchmarks `compiler#compile()` with a new compiler
+ *     for every document, drawing its tokens from a monotonic arena.
+ * @details Compare with `compiler_compile_cold`.
+ *
+ */
+static void compiler_compile_arena(benchmark::State &state) {
+    const std::string input = sparkdown::bench::document(state.range(0));
+    std::string output;
+
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource arena;
+        sparkdown::compiler compiler(&arena);
+        if (compiler.compile(input, output) != sparkdown::COMPILE_OK) {
+            state.SkipWithError("compilation failed");
+            break;
+        }
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(compiler_compile_arena)
+    ->RangeMultiplier(32)
+    ->Range(1 << 10, 1 << 20);
+
+/**
+ * @brief Benchmarks `compiler#compile()` on many threads at once,
+ *     each with the compiler given by `compiler#local()`.
+ * @details The threads share only constant tables,
+ *     so the total throughput should grow nearly linearly
+ *     with the number of threads, up to the number of cores.
+ *
+ */
+static void compiler_compile_threads(benchmark::State &state) {
+    const std::string input = sparkdown::bench::document(state.range(0));
+    sparkdown::compiler &compiler = sparkdown::compiler::local();
+    std::string output;
+
+    for (auto _ : state) {
+        if (compiler.compile(input, output) != sparkdown::COMPILE_OK) {
+            state.SkipWithError("compilation failed");
+            break;
+        }
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(compiler_compile_threads)
+    ->Arg(1 << 16)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+/**
+ * @brief Benchmarks `compiler#compile()` on a code-heavy document,
+ *     which should be dominated by the verbatim fast path.
+ *
+ */
+static void compiler_compile_code(benchmark::State &state) {
+    const std::string input = sparkdown::bench::code_document(state.range(0));
+    sparkdown::compiler compiler;
+    std::string output;
+
+    for (auto _ : state) {
+        if (compiler.compile(input, output) != sparkdown::COMPILE_OK) {
+            state.SkipWithError("compilation failed");
+            break;
+        }
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(compiler_compile_code)
+    ->RangeMultiplier(32)
+    ->Range(1 << 10, 1 << 20);
+
+/**
+ * @brief Benchmarks `compiler#compile()` on a formula-dense document,
+ *     which should be dominated by the math region scanner.
+ *
+ */
+static void compiler_compile_math(benchmark::State &state) {
+    const std::string input = sparkdown::bench::math_document(state.range(0));
+    sparkdown::compiler compiler;
+    std::string output;
+
+    for (auto _ : state) {
+        if (compiler.compile(input, output) != sparkdown::COMPILE_OK) {
+            state.SkipWithError("compilation failed");
+            break;
+        }
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(compiler_compile_math)
+    ->RangeMultiplier(32)
+    ->Range(1 << 10, 1 << 20);
+
+/**
+ * @brief Benchmarks `compiler#compile()` on one long, deeply nested list.
+ * @details Reports the complexity, which should be linear:
+ *     each line is handled by looking only at its own indentation.
+ *
+ */
+static void compiler_compile_lists(benchmark::State &state) {
+    const std::string input = sparkdown::bench::list_document(state.range(0));
+    sparkdown::compiler compiler;
+    std::string output;
+
+    for (auto _ : state) {
+        if (compiler.compile(input, output) != sparkdown::COMPILE_OK) {
+            state.SkipWithError("compilation failed");
+            break;
+        }
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+    state.SetComplexityN(static_cast<std::int64_t>(input.size()));
+}
+BENCHMARK(compiler_compile_lists)
+    ->RangeMultiplier(32)
+    ->Range(1 << 10, 1 << 20)
+    ->Complexity(benchmark::oN);
+
+/**
+ * @brief Benchmarks `compiler#compile()` writing LaTeX and HTML
+ *     from a single parse.
+ *
+ */
+static void compiler_compile_fan_out(benchmark::State &state) {
+    const std::string input = sparkdown::bench::document(state.range(0));
+    sparkdown::compiler compiler;
+    std::string latex;
+    std::string html;
+    sparkdown::latex_emitter latex_out(latex);
+    sparkdown::html_emitter html_out(html);
+    const std::vector<sparkdown::emitter *> emitters = {&latex_out, &html_out};
+
+    for (auto _ : state) {
+        if (compiler.compile(input, emitters) != sparkdown::COMPILE_OK) {
+            state.SkipWithError("compilation failed");
+            break;
+        }
+        benchmark::DoNotOptimize(latex);
+        benchmark::DoNotOptimize(html);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(compiler_compile_fan_out)
+    ->RangeMultiplier(32)
+    ->Range(1 << 10, 1 << 20);
+
+/**
+ * @brief Benchmarks `compiler#compile()` writing LaTeX and HTML
+ *     with a separate parse for each, for comparison.
+ *
+ */
+static void compiler_compile_each(benchmark::State &state) {
+    const std::string input = sparkdown::bench::document(state.range(0));
+    sparkdown::compiler compiler;
+    std::string latex;
+    std::string html;
+    sparkdown::latex_emitter latex_out(latex);
+    sparkdown::html_emitter html_out(html);
+    const std::vector<sparkdown::emitter *> first = {&latex_out};
+    const std::vector<sparkdown::emitter *> second = {&html_out};
+
+    for (auto _ : state) {
+        if (compiler.compile(input, first) != sparkdown::COMPILE_OK ||
+            compiler.compile(input, second) != sparkdown::COMPILE_OK) {
+            state.SkipWithError("compilation failed");
+            break;
+        }
+        benchmark::DoNotOptimize(latex);
+        benchmark::DoNotOptimize(html);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(compiler_compile_each)
+    ->RangeMultiplier(32)
+    ->Range(1 << 10, 1 << 20);
+
+/**
+ * @brief Benchmarks finding and compiling the section
+ *     around the middle line of a document, as a live preview does.
+ * @details The time should grow with the size of the section,
+ *     which is about the same at every size, not of the document.
+ *
+ */
+static void compiler_compile_section(benchmark::State &state) {
+    const std::string input = sparkdown::bench::document(state.range(0));
+    const std::size_t line =
+        std::count(input.begin(), input.end(), '\n') / 2 + 1;
+    sparkdown::compiler compiler;
+    std::string output;
+
+    std::size_t size = 0;
+    for (auto _ : state) {
+        std::string_view section =
+            sparkdown::compiler::section(input, line, line);
+        if (compiler.compile(section, output) != sparkdown::COMPILE_OK) {
+            state.SkipWithError("compilation failed");
+            break;
+        }
+        size = section.size();
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.counters["section"] = static_cast<double>(size);
+}
+BENCHMARK(compiler_compile_section)
+    ->RangeMultiplier(32)
+    ->Range(1 << 10, 1 << 20);
+
+/**
+ * @brief Benchmarks a whole run of the `sparkdown` driver:
+ *     reading the input file, transpiling it, and saving the output file.
+ *
+ */
+static void sparkdown_file(benchmark::State &state) {
+    const std::string input = sparkdown::bench::document(state.range(0));
+    std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "sparkdown-bench";
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "input._", std::ios::binary) << input;
+
+    for (auto _ : state) {
+        sparkdown::sparkdown driver((dir / "input._").string(),
+                                    (dir / "output.tex").string());
+        driver.parse();
+        if (driver.save_latex_code() == sparkdown::WRITE_FAILED) {
+            state.SkipWithError("could not write the output");
+            break;
+        }
+    }
+
+    std::filesystem::remove_all(dir);
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+    state.counters["tokens"] =
+        benchmark::Counter(static_cast<double>(input.size()),
+                           benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(sparkdown_file)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
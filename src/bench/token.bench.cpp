@@ -0,0 +1,60 @@
+/**
+ * @file bench/token.bench.cpp
+ * @package //bench:token.bench
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `token` class benchmarks.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file benchmarks the `token` class,
+ *     which represents a single token in the lexing/parsing process.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "bench/documents.hpp"
+#include "token/token.hpp"
+
+/**
+ * @brief Benchmarks `token#get_type()` over a realistic document.
+ *
+ */
+static void token_get_type(benchmark::State &state) {
+    const std::string input = sparkdown::bench::document(state.range(0));
+
+    for (auto _ : state) {
+        for (char c : input) {
+            benchmark::DoNotOptimize(sparkdown::token::get_type(c));
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+    state.counters["tokens"] =
+        benchmark::Counter(static_cast<double>(input.size()),
+                           benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(token_get_type)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+/**
+ * @brief Benchmarks `token#token(char)` over a realistic document.
+ *
+ */
+static void token_construct(benchmark::State &state) {
+    const std::string input = sparkdown::bench::document(state.range(0));
+
+    for (auto _ : state) {
+        for (char c : input) {
+            sparkdown::token t(c);
+            benchmark::DoNotOptimize(t);
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+    state.counters["tokens"] =
+        benchmark::Counter(static_cast<double>(input.size()),
+                           benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(token_construct)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
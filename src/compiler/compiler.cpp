@@ -0,0 +1,644 @@
+/**
+ * @file compiler/compiler.cpp
+ * @package //compiler:compiler
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `compiler` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `compiler` class,
+ *     which transpiles Sparkdown text held in memory into LaTeX code.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "compiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <iterator>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "emitter/latex_emitter.hpp"
+
+namespace sparkdown {
+
+namespace {
+
+/**
+ * @brief Marks the characters that may start a region
+ *     that `compiler::_lex()` handles itself.
+ *
+ */
+constexpr std::array<bool, 256> special = [] {
+    std::array<bool, 256> table{};
+    for (unsigned char c : {'`', '$', '\\', '%'}) table[c] = true;
+    return table;
+}();
+
+/**
+ * @brief Returns the position of the next special character.
+ * @details Where SSE2 is available, 16 bytes are compared
+ *     against every special character at a time,
+ *     as in `escape::append()`.
+ *
+ * @param input The text to search.
+ * @param from The position to search from.
+ * @return The position, or `npos` if there is none.
+ */
+std::size_t find_special(std::string_view input, std::size_t from) {
+#ifdef __SSE2__
+    const char *data = input.data();
+    const __m128i backtick = _mm_set1_epi8('`');
+    const __m128i dollar = _mm_set1_epi8('$');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i percent = _mm_set1_epi8('%');
+    for (; from + 16 <= input.size(); from += 16) {
+        __m128i chunk =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + from));
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, backtick),
+                         _mm_cmpeq_epi8(chunk, dollar)),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, backslash),
+                         _mm_cmpeq_epi8(chunk, percent)));
+
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+        if (mask) return from + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+#endif
+
+    // Any bytes left over are checked one at a time.
+    for (; from < input.size(); from++) {
+        if (special[static_cast<unsigned char>(input[from])]) return from;
+    }
+    return std::string_view::npos;
+}
+
+/**
+ * @brief Reports whether the given position starts a line.
+ *
+ * @param input The text.
+ * @param position The position.
+ * @return True if the position starts a line.
+ */
+bool starts_line(std::string_view input, std::size_t position) {
+    return position == 0 || input[position - 1] == '\n';
+}
+
+/**
+ * @brief Reports whether the given "$" starts a head or include directive,
+ *     rather than math.
+ *
+ * @param input The text.
+ * @param position The position of the "$".
+ * @return True if the "$" starts a directive.
+ */
+bool is_directive(std::string_view input, std::size_t position) {
+    if (!starts_line(input, position)) return false;
+    std::string_view rest = input.substr(position);
+    for (std::string_view directive : head::directives) {
+        if (rest.substr(0, directive.size()) == directive) return true;
+    }
+    std::string_view directive = include::directive;
+    if (rest.substr(0, directive.size()) == directive) return true;
+    return false;
+}
+
+/**
+ * @brief Returns the position of the next occurrence of the given delimiter
+ *     that is not escaped by a backslash.
+ * @details Searches with `std::string_view::find()`,
+ *     which skips ahead with `memchr()`.
+ *
+ * @param input The text to search.
+ * @param delimiter The delimiter to search for.
+ * @param from The position to search from.
+ *     Backslashes before it are not counted.
+ * @param walked Increased by the number of backslashes looked back over.
+ * @return The position, or `npos` if there is none.
+ */
+std::size_t find_unescaped(std::string_view input, std::string_view delimiter,
+                           std::size_t from, std::size_t &walked) {
+    for (std::size_t found = input.find(delimiter, from);
+         found != std::string_view::npos;
+         found = input.find(delimiter, found + 1)) {
+        std::size_t backslashes = 0;
+        while (found - backslashes > from &&
+               input[found - backslashes - 1] == '\\') {
+            backslashes++;
+        }
+        walked += backslashes;
+        if (backslashes % 2 == 0) return found;
+    }
+    return std::string_view::npos;
+}
+
+/**
+ * @brief A region of the input that `compiler::_lex()` handles itself.
+ *
+ */
+struct region {
+    std::size_t start;      // The position of its first character,
+                            //     or `npos` if there is none.
+    std::size_t end;        // The position at which lexing resumes.
+    std::string_view span;  // The text its token stands in for.
+    token_type type;        // The type of its token.
+    compile_status status;  // Whether it is terminated.
+    std::size_t scanned;    // The number of bytes examined to find it.
+};
+
+/**
+ * @brief Finds the next verbatim block or math region.
+ * @details See `compiler::_lex()` for how each is delimited.
+ *
+ * @param input The text to search.
+ * @param position The position to search from.
+ *     It must not be inside of a region.
+ * @return The region. If it is not terminated,
+ *     only its start and status are set.
+ */
+region next_region(std::string_view input, std::size_t position) {
+    const std::size_t from = position;
+    while ((position = find_special(input, position)) !=
+           std::string_view::npos) {
+        char c = input[position];
+
+        // Skip over everything that does not start a region.
+        if (c == '%') {
+            position = std::min(input.find('\n', position), input.size());
+            continue;
+        }
+        if (c == '\\' && input.substr(position, 2) != "\\[") {
+            position += 2;
+            continue;
+        }
+        if (c == '`' &&
+            (!starts_line(input, position) ||
+             input.substr(position, 3) != "```")) {
+            position++;
+            continue;
+        }
+        if (c == '$' && is_directive(input, position)) {
+            position++;
+            continue;
+        }
+        break;
+    }
+    if (position >= input.size()) {
+        return {std::string_view::npos, 0, {}, token_type::CHAR_OTHER,
+                COMPILE_OK, input.size() - from};
+    }
+
+    if (input[position] == '`') {
+        // The block starts on the line after the opening fence,
+        // and ends at the start of the closing fence.
+        std::size_t start = input.find('\n', position);
+        std::size_t close = start == std::string_view::npos
+                                ? start
+                                : input.find("\n```", start);
+        if (close == std::string_view::npos) {
+            return {position, 0, {}, token_type::COMP_VERBATIM,
+                    COMPILE_UNTERMINATED_VERBATIM, input.size() - from};
+        }
+
+        // Lexing resumes at the end of the closing fence line.
+        std::size_t end = std::min(input.find('\n', close + 1), input.size());
+        return {position, end, input.substr(start + 1, close - start),
+                token_type::COMP_VERBATIM, COMPILE_OK, end - from};
+    }
+
+    std::string_view closer = "$";
+    if (input[position] == '\\') {
+        closer = "\\]";
+    } else if (input.substr(position, 2) == "$$") {
+        closer = "$$";
+    }
+    std::size_t walked = 0;
+    std::size_t close =
+        find_unescaped(input, closer, position + closer.size(), walked);
+    if (close == std::string_view::npos) {
+        return {position, 0, {}, token_type::COMP_MATH,
+                COMPILE_UNTERMINATED_MATH, input.size() - from + walked};
+    }
+    std::size_t end = close + closer.size();
+    return {position, end, input.substr(position, end - position),
+            token_type::COMP_MATH, COMPILE_OK, end - from + walked};
+}
+
+/**
+ * @brief Reports whether a chunk may start at the given line.
+ * @details The line must not be blank, indented, or a list item,
+ *     so that it closes every open list,
+ *     just as the end of the previous chunk does.
+ *     (Lines starting with a digit, "*", or "-" are all refused.)
+ *     Nor may it start with "|", since a table row
+ *     means nothing without the rows above it.
+ *
+ * @param input The text.
+ * @param position The start of the line.
+ * @return True if a chunk may start there.
+ */
+bool starts_chunk(std::string_view input, std::size_t position) {
+    if (position == 0 || position >= input.size()) return false;
+    char c = input[position];
+    return c != ' ' && c != '\t' && c != '\n' && c != '\r' && c != '*' &&
+           c != '-' && c != '|' &&
+           !std::isdigit(static_cast<unsigned char>(c));
+}
+
+/**
+ * @brief Reports whether the given line is a headline.
+ * @details See `heading` for the syntax.
+ *
+ * @param input The text.
+ * @param position The start of the line.
+ * @return True if the line is a headline.
+ */
+bool is_headline(std::string_view input, std::size_t position) {
+    std::size_t level = 0;
+    while (position + level < input.size() && input[position + level] == '#' &&
+           level < 4) {
+        level++;
+    }
+    return level > 0 && level < 4 && position + level < input.size() &&
+           input[position + level] == ' ';
+}
+
+/**
+ * @brief Returns the position of the start of the given line.
+ *
+ * @param input The text.
+ * @param line The line, counting from 1.
+ * @return The position, or the length of the text if it has fewer lines.
+ */
+std::size_t line_start(std::string_view input, std::size_t line) {
+    std::size_t position = 0;
+    for (; line > 1; line--) {
+        position = input.find('\n', position);
+        if (position == std::string_view::npos) return input.size();
+        position++;
+    }
+    return position;
+}
+
+}  // namespace
+
+compiler::compiler(std::pmr::memory_resource *resource)
+    : _lexer(resource),
+      _parser(resource),
+      _tokens(resource),
+      _include_handler(nullptr),
+      _directive(resource),
+      _columns(resource),
+      _stats(nullptr),
+      _spans(resource),
+      _text(resource) {}
+
+void compiler::set_include_handler(include_handler *handler) {
+    this->_include_handler = handler;
+}
+
+void compiler::set_stats(compile_stats *stats) { this->_stats = stats; }
+
+compile_status compiler::compile(std::string_view input, std::string &output) {
+    latex_emitter latex(output);
+    emitter *emitters[] = {&latex};
+    return this->_compile(input, emitters, 1);
+}
+
+compile_status compiler::compile(std::string_view input,
+                                 const std::vector<emitter *> &emitters) {
+    return this->_compile(input, emitters.data(), emitters.size());
+}
+
+compile_status compiler::_compile(std::string_view input,
+                                  emitter *const *emitters,
+                                  std::size_t count) {
+    this->reset();
+    for (std::size_t i = 0; i < count; i++) emitters[i]->clear();
+
+    compile_stats *stats = this->_stats;
+
+    compile_status status;
+    {
+        SPARKDOWN_TRACE_SPAN("compiler", "lex");
+        phase_timer timer(stats ? &stats->lex : nullptr);
+        status = this->_lex(input);
+    }
+    // The work done is counted even if the input fails to compile.
+    if (stats) {
+        stats->bytes_in += input.size();
+        stats->tokens_lexed += this->_tokens.size();
+    }
+    if (status != COMPILE_OK) return status;
+
+    {
+        SPARKDOWN_TRACE_SPAN("compiler", "parse");
+        phase_timer timer(stats ? &stats->parse : nullptr);
+        this->_parser.parse(this->_tokens);
+    }
+    if (stats) {
+        stats->tokens_parsed += this->_tokens.size();
+        stats->tokens_visited += this->_parser.get_state().visits();
+    }
+
+    const state &s = this->_parser.get_state();
+    if (s.is_verbatim()) return COMPILE_UNTERMINATED_VERBATIM;
+    if (s.is_math()) return COMPILE_UNTERMINATED_MATH;
+
+    SPARKDOWN_TRACE_SPAN("compiler", "emit");
+    phase_timer timer(stats ? &stats->emit : nullptr);
+    status = this->_emit(emitters, count);
+    if (stats) {
+        for (std::size_t i = 0; i < count; i++) {
+            stats->bytes_out += emitters[i]->output().size();
+        }
+    }
+    return status;
+}
+
+void compiler::reset() {
+    this->_parser.recycle(this->_tokens);
+    this->_lexer.recycle(this->_tokens);
+    this->_spans.clear();
+    this->_parser.reset();
+}
+
+std::size_t compiler::boundary(std::string_view input) {
+    std::size_t resume = 0;
+    return boundary(input, resume);
+}
+
+std::size_t compiler::boundary(std::string_view input, std::size_t &resume) {
+    std::size_t found = 0;
+    std::size_t position = resume;  // The end of the last region.
+    for (;;) {
+        region r = next_region(input, position);
+        std::size_t limit = std::min(r.start, input.size());
+
+        // Consider every line that starts before the region.
+        for (std::size_t line = input.find('\n', position); line < limit;
+             line = input.find('\n', line + 1)) {
+            if (starts_chunk(input, line + 1)) found = line + 1;
+        }
+
+        if (r.start == std::string_view::npos) {
+            // The last line may not be whole yet, so it is scanned again.
+            std::size_t last = input.rfind('\n');
+            resume = last == std::string_view::npos || last < position
+                         ? position
+                         : last;
+            return found;
+        }
+        if (r.status != COMPILE_OK) {
+            // The region may be closed by the text still to come.
+            resume = r.start;
+            return found;
+        }
+        position = r.end;
+    }
+}
+
+std::string_view compiler::section(std::string_view input,
+                                   std::size_t first_line,
+                                   std::size_t last_line) {
+    std::size_t first = line_start(input, first_line);
+    std::size_t last =
+        last_line > first_line ? line_start(input, last_line) : first;
+
+    std::size_t start = 0;
+    std::size_t position = 0;  // The end of the last region.
+    for (;;) {
+        region r = next_region(input, position);
+        std::size_t limit = std::min(r.start, input.size());
+
+        // Consider every line that starts before the region.
+        for (std::size_t line = input.find('\n', position); line < limit;
+             line = input.find('\n', line + 1)) {
+            if (!is_headline(input, line + 1)) continue;
+            if (line + 1 > last) {
+                return input.substr(start, line + 1 - start);
+            }
+            if (line + 1 <= first) start = line + 1;
+        }
+
+        if (r.start == std::string_view::npos || r.status != COMPILE_OK) {
+            return input.substr(start);
+        }
+        position = r.end;
+    }
+}
+
+compiler &compiler::local() {
+    // The pool is constructed first, so it is destroyed last.
+    thread_local std::pmr::unsynchronized_pool_resource pool;
+    thread_local compiler instance(&pool);
+    return instance;
+}
+
+std::string_view compiler::describe(compile_status status) {
+    switch (status) {
+        case COMPILE_OK:
+            return "success";
+        case COMPILE_UNTERMINATED_MATH:
+            return "the input ended inside of math mode";
+        case COMPILE_UNTERMINATED_VERBATIM:
+            return "the input ended inside of verbatim text";
+        case COMPILE_INCLUDE_UNSUPPORTED:
+            return "the input includes another file, "
+                   "but includes are not supported here";
+        case COMPILE_INCLUDE_NOT_FOUND:
+            return "an included file could not be read";
+        case COMPILE_INCLUDE_CYCLE:
+            return "a file includes itself";
+        case COMPILE_DAMAGED_TREE:
+            return "a saved parse tree is damaged";
+        default:
+            return "unknown error";
+    }
+}
+
+compile_status compiler::_lex(std::string_view input) {
+    std::size_t pending = 0;  // The start of the text not yet lexed.
+    std::size_t scanned = 0;  // The bytes examined by the region scan.
+    region r;
+    while ((r = next_region(input, pending)).start != std::string_view::npos &&
+           r.status == COMPILE_OK) {
+        scanned += r.scanned;
+        this->_lexer.lex(input.substr(pending, r.start - pending));
+        this->_spans.push_back(r.span);
+        this->_lexer.append(r.type);
+        pending = r.end;
+    }
+    scanned += r.scanned;
+    if (r.status == COMPILE_OK) this->_lexer.lex(input.substr(pending));
+
+    this->_lexer.get_tokens(this->_tokens);
+    if (this->_stats) this->_stats->bytes_scanned += scanned;
+    return r.status;
+}
+
+compile_status compiler::_emit(emitter *const *emitters, std::size_t count) {
+    // Hands the gathered run of plain text to every emitter.
+    auto flush = [&] {
+        if (this->_text.empty()) return;
+        for (std::size_t i = 0; i < count; i++) emitters[i]->text(this->_text);
+        this->_text.clear();
+    };
+
+    // Gathers the value of a directive: the rest of its line,
+    // without trailing whitespace.
+    auto rest_of_line = [&](token_list::iterator &it) {
+        this->_directive.clear();
+        while (std::next(it) != this->_tokens.end() &&
+               std::next(it)->value != '\n') {
+            this->_directive += (++it)->value;
+        }
+        while (!this->_directive.empty() &&
+               std::isspace(
+                   static_cast<unsigned char>(this->_directive.back()))) {
+            this->_directive.pop_back();
+        }
+    };
+
+    std::size_t span = 0;
+    int heading = 0;      // The level of the headline being written.
+    bool header = false;  // Whether the table row being written is a header.
+    for (auto it = this->_tokens.begin(); it != this->_tokens.end(); it++) {
+        const token &t = *it;
+        if (t.type <= token_type::CHAR_OTHER) {
+            this->_text += t.value;
+            continue;
+        }
+        flush();
+
+        switch (t.type) {
+            case token_type::COMP_INCLUDE:
+                rest_of_line(it);
+                for (std::size_t i = 0; i < count; i++) {
+                    if (emitters[i]->include(this->_directive)) continue;
+                    if (!this->_include_handler) {
+                        return COMPILE_INCLUDE_UNSUPPORTED;
+                    }
+                    compile_status status = this->_include_handler->include(
+                        this->_directive, emitters[i]->output());
+                    if (status != COMPILE_OK) return status;
+                }
+                break;
+            case token_type::COMP_TITLE:
+            case token_type::COMP_AUTHOR:
+            case token_type::COMP_DATE: {
+                head_field field = t.type == token_type::COMP_TITLE ? HEAD_TITLE
+                                   : t.type == token_type::COMP_AUTHOR
+                                       ? HEAD_AUTHOR
+                                       : HEAD_DATE;
+                rest_of_line(it);
+                for (std::size_t i = 0; i < count; i++) {
+                    emitters[i]->head(field, this->_directive);
+                }
+                break;
+            }
+            case token_type::COMP_VERBATIM:
+                for (std::size_t i = 0; i < count; i++) {
+                    emitters[i]->verbatim(this->_spans[span]);
+                }
+                span++;
+                break;
+            case token_type::COMP_MATH:
+                for (std::size_t i = 0; i < count; i++) {
+                    emitters[i]->math(this->_spans[span]);
+                }
+                span++;
+                break;
+            case token_type::COMP_SECTION:
+            case token_type::COMP_SUBSECTION:
+            case token_type::COMP_SUBSUBSECTION:
+                heading = 1 + (t.type - token_type::COMP_SECTION);
+                for (std::size_t i = 0; i < count; i++) {
+                    emitters[i]->begin_heading(heading);
+                }
+                break;
+            case token_type::COMP_END_HEADING:
+                for (std::size_t i = 0; i < count; i++) {
+                    emitters[i]->end_heading(heading);
+                }
+                break;
+            case token_type::COMP_BEGIN_ITEMIZE:
+                for (std::size_t i = 0; i < count; i++) {
+                    emitters[i]->begin_list(LIST_ITEMIZE);
+                }
+                break;
+            case token_type::COMP_END_ITEMIZE:
+                for (std::size_t i = 0; i < count; i++) {
+                    emitters[i]->end_list(LIST_ITEMIZE);
+                }
+                break;
+            case token_type::COMP_BEGIN_ENUMERATE:
+                for (std::size_t i = 0; i < count; i++) {
+                    emitters[i]->begin_list(LIST_ENUMERATE);
+                }
+                break;
+            case token_type::COMP_END_ENUMERATE:
+                for (std::size_t i = 0; i < count; i++) {
+                    emitters[i]->end_list(LIST_ENUMERATE);
+                }
+                break;
+            case token_type::COMP_ITEM:
+                for (std::size_t i = 0; i < count; i++) emitters[i]->item();
+                break;
+            case token_type::COMP_R_ARROW:
+                for (std::size_t i = 0; i < count; i++) emitters[i]->arrow();
+                break;
+            case token_type::COMP_BEGIN_TABLE:
+                // The column alignments follow the table token.
+                this->_columns.clear();
+                while (std::next(it) != this->_tokens.end() &&
+                       std::next(it)->type == token_type::COMP_COLUMN) {
+                    this->_columns += (++it)->value;
+                }
+                for (std::size_t i = 0; i < count; i++) {
+                    emitters[i]->begin_table(this->_columns);
+                }
+                header = true;
+                break;
+            case token_type::COMP_BEGIN_ROW:
+                for (std::size_t i = 0; i < count; i++) {
+                    emitters[i]->begin_row(header);
+                }
+                break;
+            case token_type::COMP_CELL:
+                for (std::size_t i = 0; i < count; i++) {
+                    emitters[i]->next_cell(header);
+                }
+                break;
+            case token_type::COMP_END_ROW:
+                for (std::size_t i = 0; i < count; i++) {
+                    emitters[i]->end_row(header);
+                }
+                header = false;
+                break;
+            case token_type::COMP_PIPE:
+                for (std::size_t i = 0; i < count; i++) emitters[i]->pipe();
+                break;
+            case token_type::COMP_END_TABLE:
+                for (std::size_t i = 0; i < count; i++) {
+                    emitters[i]->end_table();
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    flush();
+
+    return COMPILE_OK;
+}
+
+}  // namespace sparkdown
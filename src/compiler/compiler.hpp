@@ -0,0 +1,393 @@
+/**
+ * @file compiler/compiler.hpp
+ * @package //compiler:compiler
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `compiler` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `compiler` class,
+ *     which transpiles Sparkdown text held in memory into LaTeX code.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef COMPILER_HPP
+#define COMPILER_HPP
+
+#include <string>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+#include "emitter/emitter.hpp"
+#include "lexer/lexer.hpp"
+#include "parser/parser.hpp"
+#include "parser/patterns/head.hpp"
+#include "parser/patterns/heading.hpp"
+#include "parser/patterns/include.hpp"
+#include "parser/patterns/list.hpp"
+#include "parser/patterns/pattern.hpp"
+#include "parser/patterns/table.hpp"
+#include "stats/stats.hpp"
+#include "trace/trace.hpp"
+
+namespace sparkdown {
+
+/**
+ * @brief An enumeration of the possible results of a compilation.
+ *
+ */
+enum compile_status {
+    COMPILE_OK,                     // The input was compiled successfully.
+    COMPILE_UNTERMINATED_MATH,      // The input ended inside of math mode.
+    COMPILE_UNTERMINATED_VERBATIM,  // The input ended inside of verbatim text.
+    COMPILE_INCLUDE_UNSUPPORTED,    // The input includes a file,
+                                    //     but there is no include handler.
+    COMPILE_INCLUDE_NOT_FOUND,      // An included file could not be read.
+    COMPILE_INCLUDE_CYCLE,          // A file includes itself, perhaps
+                                    //     through other files.
+    COMPILE_DAMAGED_TREE,           // A saved parse tree is damaged.
+};
+
+/**
+ * @brief Handles the include directives met by a `compiler`.
+ * @details The compiler itself never touches the filesystem,
+ *     so it hands each include directive to a handler.
+ *     See `module_cache` for the handler used with files on disk.
+ *
+ */
+class include_handler {
+   public:
+    /**
+     * @brief Destructor.
+     *
+     */
+    virtual ~include_handler() = default;
+
+    /**
+     * @brief Handles a single include directive.
+     * @details Typically writes the LaTeX code of the included file
+     *     onto the end of the output.
+     *
+     * @param path The path given in the directive, exactly as written.
+     * @param output The output written so far.
+     * @return `COMPILE_OK` on success; otherwise, the reason for failure.
+     */
+    virtual compile_status include(std::string_view path,
+                                   std::string &output) = 0;
+};
+
+/**
+ * @brief A reusable context for transpiling Sparkdown text into LaTeX code.
+ * @details Unlike the `sparkdown` driver class, a `compiler` never touches
+ *     the filesystem and never exits the program: input is given as a string,
+ *     output is written into a caller-supplied buffer,
+ *     and errors are reported through the return value.
+ *
+ *     Other output formats are written by `emitter` backends,
+ *     several of which may share a single parse.
+ *
+ *     A `compiler` keeps its token buffers between documents,
+ *     so once it has seen a document of a given size,
+ *     compiling another document of that size does not allocate.
+ *     (The caller's output buffer likewise keeps its capacity.)
+ *
+ *     The token buffers are drawn from the memory resource
+ *     given to the constructor. A `std::pmr::monotonic_buffer_resource`
+ *     makes a cheap arena for a single document, freed all at once;
+ *     a `std::pmr::unsynchronized_pool_resource` suits a compiler
+ *     kept by a single worker thread.
+ *     The resource must outlive the compiler.
+ *
+ *     The tables a compilation reads, such as the token classes,
+ *     the escape tables, and the scanner's table of special characters,
+ *     are constant and built at compile time, so they are shared
+ *     by every compiler without synchronization.
+ *     Everything a compilation writes to belongs to the compiler:
+ *     its lexer, its parser and the parser's state, and its buffers.
+ *     A `compiler` is thus a cheap per-thread context.
+ *     It is not thread-safe, but compilers on different threads
+ *     never share mutable data, and any number of them
+ *     may compile at once. See `local()`.
+ *
+ */
+class compiler {
+   public:
+    /**
+     * @brief The parser used by the compiler, with the default patterns.
+     *
+     */
+    typedef parser<table, head, include, heading, list> default_parser;
+
+   private:
+    /**
+     * @brief Lexes the input text into tokens.
+     * @details Also holds the spare token nodes between documents.
+     *
+     */
+    lexer _lexer;
+
+    /**
+     * @brief Parses the lexed tokens.
+     *
+     */
+    default_parser _parser;
+
+    /**
+     * @brief The token sequence of the current document.
+     *
+     */
+    token_list _tokens;
+
+    /**
+     * @brief Handles include directives. May be null.
+     *
+     */
+    include_handler *_include_handler;
+
+    /**
+     * @brief Holds the value of the head or include directive
+     *     being emitted.
+     *
+     */
+    std::pmr::string _directive;
+
+    /**
+     * @brief Holds the column alignments of the table being emitted.
+     *
+     */
+    std::pmr::string _columns;
+
+    /**
+     * @brief Receives the statistics of each compilation. May be null.
+     *
+     */
+    compile_stats *_stats;
+
+    /**
+     * @brief The text of the opaque tokens of the current document,
+     *     in order, as views into the input.
+     * @details Each `COMP_VERBATIM` token stands in for the contents
+     *     of a verbatim block, and each `COMP_MATH` token
+     *     for a math region, delimiters included.
+     *
+     */
+    std::pmr::vector<std::string_view> _spans;
+
+    /**
+     * @brief Lexes the input into the current token sequence.
+     * @details Verbatim blocks and math regions are not lexed:
+     *     the closing delimiter of each is found with a single search,
+     *     and the whole region is replaced by one opaque token,
+     *     so the parser and its patterns never see its contents.
+     *
+     *     A verbatim fence is a line starting with "```".
+     *     The rest of a fence line is ignored.
+     *
+     *     Math regions are delimited by "$", "$$", or "\\[" and "\\]".
+     *     Escaped delimiters, such as "\\$", and delimiters inside
+     *     of LaTeX comments are ignored, as are the "$" of head
+     *     and include directives.
+     *
+     *     The bytes examined while finding the regions are added
+     *     to the statistics, if any, even if the input fails to lex.
+     *
+     * @param input The Sparkdown text to lex.
+     * @return `COMPILE_OK` on success; otherwise, the reason for failure.
+     */
+    compile_status _lex(std::string_view input);
+
+    /**
+     * @brief Holds the run of plain text being gathered for the emitters.
+     *
+     */
+    std::pmr::string _text;
+
+    /**
+     * @brief Transpiles the given text with the given emitters.
+     *
+     * @param input The Sparkdown text to transpile.
+     * @param emitters The emitters to write with.
+     * @param count The number of emitters.
+     * @return `COMPILE_OK` on success; otherwise, the reason for failure.
+     */
+    compile_status _compile(std::string_view input, emitter *const *emitters,
+                            std::size_t count);
+
+    /**
+     * @brief Walks the current token sequence once,
+     *     writing it with each of the given emitters.
+     * @details Plain text tokens are gathered into runs,
+     *     which are handed to the emitters whole.
+     *
+     * @param emitters The emitters to write with.
+     * @param count The number of emitters.
+     * @return `COMPILE_OK` on success; otherwise, the reason for failure.
+     */
+    compile_status _emit(emitter *const *emitters, std::size_t count);
+
+   public:
+    /**
+     * @brief Constructor.
+     *
+     * @param resource The memory resource to draw the token buffers from.
+     */
+    explicit compiler(
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    compiler(const compiler &) = delete;
+    compiler &operator=(const compiler &) = delete;
+
+    /**
+     * @brief Sets the handler for include directives.
+     * @details Without a handler, an include directive
+     *     fails with `COMPILE_INCLUDE_UNSUPPORTED`.
+     *
+     * @param handler The handler, or null to remove it.
+     */
+    void set_include_handler(include_handler *handler);
+
+    /**
+     * @brief Sets the statistics that each compilation adds to.
+     * @details Records the lex, parse, and emit phases,
+     *     the bytes compiled and emitted, and the token counts.
+     *
+     * @param stats The statistics, or null to stop recording.
+     */
+    void set_stats(compile_stats *stats);
+
+    /**
+     * @brief Transpiles the given Sparkdown text into LaTeX code.
+     * @details The compiler is reset before the input is lexed,
+     *     so consecutive calls are independent of one another.
+     *
+     *     The output buffer is cleared before it is written to,
+     *     but its capacity is kept.
+     *
+     * @param input The Sparkdown text to transpile.
+     * @param output The buffer to write the LaTeX code to.
+     * @return `COMPILE_OK` on success; otherwise, the reason for failure.
+     */
+    compile_status compile(std::string_view input, std::string &output);
+
+    /**
+     * @brief Transpiles the given Sparkdown text with several backends
+     *     at once.
+     * @details The input is lexed and parsed once,
+     *     and the parsed tokens are walked once,
+     *     with every event handed to each emitter in turn.
+     *
+     *     Each emitter's output buffer is cleared before it is written to,
+     *     but its capacity is kept.
+     *     The include handler is called once per emitter,
+     *     with that emitter's output buffer.
+     *
+     * @param input The Sparkdown text to transpile.
+     * @param emitters The emitters to write with.
+     * @return `COMPILE_OK` on success; otherwise, the reason for failure.
+     */
+    compile_status compile(std::string_view input,
+                           const std::vector<emitter *> &emitters);
+
+    /**
+     * @brief Returns the compiler to its initial state.
+     * @details The token buffers are kept for reuse by the next document.
+     *
+     */
+    void reset();
+
+    /**
+     * @brief Finds where the given text may be cut in two,
+     *     so that each part can be compiled on its own.
+     * @details Compiling the text before the cut and the text after it,
+     *     and joining the outputs, gives the same output
+     *     as compiling the whole text.
+     *
+     *     A cut is only made at the start of a line outside of
+     *     any verbatim block or math region, and only before a line
+     *     that is not blank, indented, a list item, or a table row,
+     *     since such a line closes every open list and table.
+     *     The last such line is chosen.
+     *
+     *     Takes time linear in the length of the text.
+     *
+     * @param input The Sparkdown text.
+     * @return The position of the cut, or zero if there is none.
+     */
+    static std::size_t boundary(std::string_view input);
+
+    /**
+     * @brief Finds where the given text may be cut in two,
+     *     resuming an earlier scan of the start of the same text.
+     * @details For text that grows at its end, as it is read:
+     *     only the text from `resume` on is scanned,
+     *     so a long stretch with no cut is not scanned over and over.
+     *     See `boundary(std::string_view)`.
+     *
+     * @param input The Sparkdown text.
+     * @param resume The position to scan from. It must be zero,
+     *     or a position given by an earlier call on a prefix of the text.
+     *     It is then set to the position that the next call,
+     *     on a longer text, may scan from.
+     * @return The position of the last cut after `resume`,
+     *     or zero if there is none.
+     */
+    static std::size_t boundary(std::string_view input, std::size_t &resume);
+
+    /**
+     * @brief Finds the sections that enclose the given lines,
+     *     so that they can be previewed without the rest of the text.
+     * @details A section runs from a headline to the line before
+     *     the next headline, of any level. The text before
+     *     the first headline is a section of its own.
+     *     Headlines inside of verbatim blocks and math regions
+     *     are not counted.
+     *
+     *     A headline closes every list and table, and is never
+     *     inside of a region, so the parser's state at its start
+     *     is that of a new document; the head directives above it
+     *     emit nothing. Compiling the returned text thus gives
+     *     the same output as the matching part of the output
+     *     of the whole text. See `boundary()`.
+     *
+     *     Only the text up to the end of the last section is scanned,
+     *     and only for region delimiters and line ends,
+     *     so compiling the section costs far more than finding it.
+     *
+     * @param input The Sparkdown text.
+     * @param first_line The first line to enclose, counting from 1.
+     * @param last_line The last line to enclose. If it is before
+     *     the first line, only the first line is enclosed.
+     * @return The text of the enclosing sections, as a view into the input.
+     *     Lines past the end of the text are in the last section.
+     */
+    static std::string_view section(std::string_view input,
+                                    std::size_t first_line,
+                                    std::size_t last_line);
+
+    /**
+     * @brief Returns the compiler of the calling thread.
+     * @details Each thread is given its own compiler the first time
+     *     it calls this, drawing from a pool resource of its own,
+     *     and keeps it until the thread exits.
+     *     Its include handler and statistics are those last set
+     *     on the same thread; both must only be used by that thread.
+     *
+     * @return The compiler of the calling thread.
+     */
+    static compiler &local();
+
+    /**
+     * @brief Returns a human-readable description of the given status.
+     *
+     * @param status The status to describe.
+     * @return A description of the status.
+     */
+    static std::string_view describe(compile_status status);
+};
+
+}  // namespace sparkdown
+
+#endif
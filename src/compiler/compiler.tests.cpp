@@ -0,0 +1,792 @@
+/**
+ * @file compiler/compiler.tests.cpp
+ * @package //compiler:compiler.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `compiler` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `compiler` class,
+ *     which transpiles Sparkdown text held in memory into LaTeX code.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunknown-pragmas"
+#pragma ide diagnostic ignored "UnusedLocalVariable"
+
+#include "compiler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "corpus/corpus.hpp"
+#include "emitter/html_emitter.hpp"
+#include "emitter/latex_emitter.hpp"
+
+/**
+ * @brief The size of the document used by the allocation budget tests.
+ *
+ */
+static const std::uint64_t budget_document_size = 1 << 20;
+
+/**
+ * @brief The most allocations that each phase may make
+ *     per MiB of input, the first time a compiler sees a document.
+ * @details Lexing allocates one token node per byte from the heap,
+ *     unless the compiler is given an arena.
+ *     Parsing and emitting should allocate next to nothing.
+ *
+ */
+static const std::uint64_t cold_lex_budget = (1 << 20) + 64;
+static const std::uint64_t cold_parse_budget = 1024;
+static const std::uint64_t cold_emit_budget = 64;
+
+/**
+ * @brief `compiler#compiler()` no-fail test.
+ * @details Ensures that the constructor does not throw an exception.
+ *
+ */
+TEST(compiler, constructor_no_fail) { sparkdown::compiler c; }
+
+/**
+ * @brief `compiler#compile()` test.
+ * @details Ensures that plain text passes through unchanged,
+ *     and that the output buffer is overwritten rather than appended to.
+ *
+ */
+TEST(compiler, compile_plain_text) {
+    sparkdown::compiler c;
+    std::string output = "leftover";
+
+    EXPECT_EQ(c.compile("Hello, world!", output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(output, "Hello, world!");
+
+    EXPECT_EQ(c.compile("", output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(output, "");
+}
+
+/**
+ * @brief `compiler#compile()` reuse test.
+ * @details Ensures that consecutive documents do not affect one another.
+ *
+ */
+TEST(compiler, is_reusable) {
+    sparkdown::compiler c;
+    std::string output;
+
+    EXPECT_EQ(c.compile("a longer first document", output),
+              sparkdown::COMPILE_OK);
+    EXPECT_EQ(output, "a longer first document");
+
+    EXPECT_EQ(c.compile("short", output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(output, "short");
+
+    c.reset();
+    EXPECT_EQ(c.compile("a longer third document!", output),
+              sparkdown::COMPILE_OK);
+    EXPECT_EQ(output, "a longer third document!");
+}
+
+/**
+ * @brief `compiler#compile()` allocation test.
+ * @details Ensures that, once the compiler and the output buffer have seen
+ *     a document, compiling a document of the same size does not allocate.
+ *
+ */
+TEST(compiler, steady_state_does_not_allocate) {
+    sparkdown::compiler c;
+    std::string output;
+    const std::string first(4096, 'a');
+    const std::string second(4096, 'b');
+
+    ASSERT_EQ(c.compile(first, output), sparkdown::COMPILE_OK);
+
+    std::uint64_t before = sparkdown::compile_stats::thread_allocations();
+    ASSERT_EQ(c.compile(second, output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(sparkdown::compile_stats::thread_allocations(), before);
+    EXPECT_EQ(output, second);
+}
+
+/**
+ * @brief Verbatim block test.
+ * @details Ensures that fenced blocks are copied as-is
+ *     into a `verbatim` environment, and that the fence lines are dropped.
+ *
+ */
+TEST(compiler, verbatim_blocks) {
+    sparkdown::compiler c;
+    std::string output;
+
+    ASSERT_EQ(c.compile("a\n```cpp\n$include: x\n  int a;\n```\nb", output),
+              sparkdown::COMPILE_OK);
+    EXPECT_EQ(output,
+              "a\n\\begin{verbatim}\n$include: x\n  int a;\n"
+              "\\end{verbatim}\nb");
+
+    // Empty blocks, and blocks that end the input.
+    ASSERT_EQ(c.compile("```\n```", output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(output, "\\begin{verbatim}\n\\end{verbatim}");
+
+    // Fences must start a line.
+    ASSERT_EQ(c.compile("a ``` b", output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(output, "a ``` b");
+
+    // The environment cannot be ended from inside.
+    ASSERT_EQ(c.compile("```\n\\end{verbatim}\n```", output),
+              sparkdown::COMPILE_OK);
+    EXPECT_EQ(output,
+              "\\begin{verbatim}\n\\end{verbatim}\\verb|\\end{verbatim}|"
+              "\\begin{verbatim}\n\\end{verbatim}");
+
+    EXPECT_EQ(c.compile("a\n```\ncode", output),
+              sparkdown::COMPILE_UNTERMINATED_VERBATIM);
+    EXPECT_EQ(c.compile("a\n```", output),
+              sparkdown::COMPILE_UNTERMINATED_VERBATIM);
+}
+
+/**
+ * @brief Allocation budget test.
+ * @details Ensures that each phase stays within its allocation budget
+ *     on a realistic document, and that a warm compiler does not allocate
+ *     in any phase. Fails when a change makes the compiler allocate more.
+ *
+ */
+TEST(compiler, allocation_budget) {
+    ASSERT_TRUE(sparkdown::compile_stats::counting_allocations());
+
+    const std::string document =
+        sparkdown::corpus(1).generate(budget_document_size);
+    const double mib =
+        static_cast<double>(document.size()) / budget_document_size;
+
+    sparkdown::compiler c;
+    sparkdown::compile_stats cold;
+    std::string output;
+    c.set_stats(&cold);
+    ASSERT_EQ(c.compile(document, output), sparkdown::COMPILE_OK);
+
+    EXPECT_LE(cold.lex.allocations, cold_lex_budget * mib);
+    EXPECT_LE(cold.parse.allocations, cold_parse_budget * mib);
+    EXPECT_LE(cold.emit.allocations, cold_emit_budget * mib);
+
+    sparkdown::compile_stats warm;
+    c.set_stats(&warm);
+    ASSERT_EQ(c.compile(document, output), sparkdown::COMPILE_OK);
+
+    EXPECT_EQ(warm.lex.allocations, 0);
+    EXPECT_EQ(warm.parse.allocations, 0);
+    EXPECT_EQ(warm.emit.allocations, 0);
+}
+
+/**
+ * @brief The most heap allocations that lexing may make
+ *     per MiB of input, the first time a compiler drawing from an arena
+ *     sees a document.
+ * @details The arena grows geometrically,
+ *     so it allocates a handful of large blocks instead of a node per byte.
+ *
+ */
+static const std::uint64_t arena_lex_budget = 64;
+
+/**
+ * @brief Arena allocation budget test.
+ * @details Ensures that a compiler given a monotonic arena
+ *     allocates the token nodes of a document in a few large blocks,
+ *     and that it compiles the document just as a compiler using the heap.
+ *
+ */
+TEST(compiler, arena_allocation_budget) {
+    ASSERT_TRUE(sparkdown::compile_stats::counting_allocations());
+
+    const std::string document =
+        sparkdown::corpus(1).generate(budget_document_size);
+    const double mib =
+        static_cast<double>(document.size()) / budget_document_size;
+
+    std::string expected;
+    sparkdown::compiler heap;
+    ASSERT_EQ(heap.compile(document, expected), sparkdown::COMPILE_OK);
+
+    std::pmr::monotonic_buffer_resource arena;
+    sparkdown::compiler c(&arena);
+    sparkdown::compile_stats cold;
+    std::string output;
+    c.set_stats(&cold);
+    ASSERT_EQ(c.compile(document, output), sparkdown::COMPILE_OK);
+
+    EXPECT_LE(cold.lex.allocations, arena_lex_budget * mib);
+    EXPECT_LE(cold.parse.allocations, cold_parse_budget * mib);
+    EXPECT_EQ(output, expected);
+}
+
+/**
+ * @brief Memory resource test.
+ * @details Ensures that every allocation the compiler makes
+ *     is drawn from the given resource.
+ *     The arena has no upstream resource,
+ *     so any allocation that misses it throws,
+ *     and the output buffer is sized beforehand.
+ *
+ */
+TEST(compiler, uses_memory_resource) {
+    const std::string document = sparkdown::corpus(1).generate(64 << 10);
+
+    std::string expected;
+    sparkdown::compiler heap;
+    ASSERT_EQ(heap.compile(document, expected), sparkdown::COMPILE_OK);
+
+    std::vector<std::byte> buffer(document.size() * 64);
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+                                              std::pmr::null_memory_resource());
+    sparkdown::counting_resource counting(&arena);
+    sparkdown::compiler c(&counting);
+    std::string output;
+    output.reserve(expected.size());
+
+    std::uint64_t before = sparkdown::compile_stats::thread_allocations();
+    ASSERT_EQ(c.compile(document, output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(sparkdown::compile_stats::thread_allocations(), before);
+    EXPECT_GT(counting.allocations(), 0);
+    EXPECT_EQ(output, expected);
+}
+
+/**
+ * @brief Include handler for testing.
+ * @details Writes the path of each include in brackets.
+ *
+ */
+class bracket_handler : public sparkdown::include_handler {
+   public:
+    sparkdown::compile_status include(std::string_view path,
+                                      std::string &output) override {
+        if (path == "missing._") return sparkdown::COMPILE_INCLUDE_NOT_FOUND;
+        output += "[";
+        output += path;
+        output += "]";
+        return sparkdown::COMPILE_OK;
+    }
+};
+
+/**
+ * @brief `compiler#set_include_handler()` test.
+ * @details Ensures that include directives are handed to the handler,
+ *     and that they fail without one.
+ *
+ */
+TEST(compiler, include_handler) {
+    sparkdown::compiler c;
+    bracket_handler handler;
+    std::string output;
+
+    EXPECT_EQ(c.compile("a\n$include: b._ \nc", output),
+              sparkdown::COMPILE_INCLUDE_UNSUPPORTED);
+
+    c.set_include_handler(&handler);
+    EXPECT_EQ(c.compile("a\n$include: b._ \nc", output),
+              sparkdown::COMPILE_OK);
+    EXPECT_EQ(output, "a\n[b._]\nc");
+
+    EXPECT_EQ(c.compile("$include: missing._", output),
+              sparkdown::COMPILE_INCLUDE_NOT_FOUND);
+
+    // A warm compile of a document with includes does not allocate.
+    const std::string document = "a\n$include: b._\n$include: c._\nd";
+    ASSERT_EQ(c.compile(document, output), sparkdown::COMPILE_OK);
+    std::uint64_t before = sparkdown::compile_stats::thread_allocations();
+    ASSERT_EQ(c.compile(document, output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(sparkdown::compile_stats::thread_allocations(), before);
+    EXPECT_EQ(output, "a\n[b._]\n[c._]\nd");
+}
+
+/**
+ * @brief `compiler#set_stats()` test.
+ * @details Ensures that each compilation adds to the statistics.
+ *
+ */
+TEST(compiler, set_stats) {
+    sparkdown::compiler c;
+    bracket_handler handler;
+    sparkdown::compile_stats stats;
+    std::string output;
+
+    c.set_include_handler(&handler);
+    c.set_stats(&stats);
+    ASSERT_EQ(c.compile("$include: b", output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(stats.bytes_in, 11);
+    EXPECT_EQ(stats.bytes_out, output.size());
+    EXPECT_EQ(stats.tokens_lexed, 11);
+    EXPECT_EQ(stats.tokens_parsed, 2);
+    EXPECT_EQ(stats.bytes_scanned, 11);
+
+    ASSERT_EQ(c.compile("$include: b", output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(stats.bytes_in, 22);
+
+    c.set_stats(nullptr);
+    ASSERT_EQ(c.compile("$include: b", output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(stats.bytes_in, 22);
+}
+
+/**
+ * @brief `compiler#set_stats()` failure test.
+ * @details Ensures that the work done on an input that fails to compile
+ *     is counted, and that none of it is left over for the next input.
+ *
+ */
+TEST(compiler, counts_failed_work) {
+    sparkdown::compiler c;
+    sparkdown::compile_stats stats;
+    std::string output;
+
+    c.set_stats(&stats);
+    EXPECT_EQ(c.compile("a $x$ b $y", output),
+              sparkdown::COMPILE_UNTERMINATED_MATH);
+    EXPECT_EQ(stats.bytes_in, 10);
+    EXPECT_EQ(stats.bytes_scanned, 10);
+    EXPECT_EQ(stats.tokens_lexed, 3);
+    EXPECT_GT(stats.work_per_byte(), 0);
+    c.set_stats(nullptr);
+
+    ASSERT_EQ(c.compile("cd", output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(output, "cd");
+}
+
+/**
+ * @brief Math region test.
+ * @details Ensures that math regions are passed through whole,
+ *     untouched by the patterns, and that escaped delimiters,
+ *     comments, and directives do not start or end them.
+ *
+ */
+TEST(compiler, math_regions) {
+    sparkdown::compiler c;
+    bracket_handler handler;
+    c.set_include_handler(&handler);
+    std::string output;
+
+    for (const std::string text :
+         {"a $x -> y$ b", "$$\n$include: x\n$$", "\\[ a \\$ b \\]",
+          "$a \\$ b$", "$a \\\\$", "\\[ a \\\\\\]"}) {
+        ASSERT_EQ(c.compile(text, output), sparkdown::COMPILE_OK) << text;
+        EXPECT_EQ(output, text);
+    }
+
+    // Escaped dollars and comments are plain text.
+    ASSERT_EQ(c.compile("\\$5 % costs $5\n$include: x", output),
+              sparkdown::COMPILE_OK);
+    EXPECT_EQ(output, "\\$5 % costs $5\n[x]");
+
+    EXPECT_EQ(c.compile("a $b", output), sparkdown::COMPILE_UNTERMINATED_MATH);
+    EXPECT_EQ(c.compile("$a \\$", output),
+              sparkdown::COMPILE_UNTERMINATED_MATH);
+    EXPECT_EQ(c.compile("\\[ a \\\\]", output),
+              sparkdown::COMPILE_UNTERMINATED_MATH);
+}
+
+/**
+ * @brief Special character search test.
+ * @details Ensures that a region is found at every offset
+ *     within and across the 16-byte chunks that are searched at once.
+ *
+ */
+TEST(compiler, finds_regions_at_any_offset) {
+    sparkdown::compiler c;
+    std::string output;
+
+    for (std::size_t padding = 0; padding < 48; padding++) {
+        for (const char *region : {"$x -> y$", "\\[ x -> y \\]"}) {
+            std::string text = std::string(padding, 'a') + region + " b";
+            ASSERT_EQ(c.compile(text, output), sparkdown::COMPILE_OK) << text;
+            EXPECT_EQ(output, text);
+        }
+    }
+}
+
+/**
+ * @brief List test.
+ * @details Ensures that nested lists become nested
+ *     `itemize` and `enumerate` environments.
+ *
+ */
+TEST(compiler, lists) {
+    sparkdown::compiler c;
+    std::string output;
+
+    ASSERT_EQ(c.compile("* a $x$\\\\\n  b\n  1. c\n\nd", output),
+              sparkdown::COMPILE_OK);
+    EXPECT_EQ(output,
+              "\\begin{itemize}\n\\item a $x$\\\\\n  b\n"
+              "\\begin{enumerate}\n\\item c\n\n"
+              "\\end{enumerate}\n\\end{itemize}\nd");
+}
+
+/**
+ * @brief Headline test.
+ * @details Ensures that headlines become sectioning commands,
+ *     that they end any open lists,
+ *     and that a "\r\n" line ending is left out of the command.
+ *
+ */
+TEST(compiler, headings) {
+    sparkdown::compiler c;
+    std::string output;
+
+    ASSERT_EQ(c.compile("* a\n# One\n## Two $x$\n#no", output),
+              sparkdown::COMPILE_OK);
+    EXPECT_EQ(output,
+              "\\begin{itemize}\n\\item a\n\\end{itemize}\n"
+              "\\section{One}\n\\subsection{Two $x$}\n#no");
+
+    ASSERT_EQ(c.compile("# One\r\ntext\r\n", output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(output, "\\section{One}\r\ntext\r\n");
+}
+
+/**
+ * @brief Head directive test.
+ * @details Ensures that the head directives become the commands
+ *     used by `\maketitle`, and are never left as math.
+ *
+ */
+TEST(compiler, head) {
+    sparkdown::compiler c;
+    std::string output;
+
+    ASSERT_EQ(c.compile("$title: T & U \n$author: A\n$date: D\n$x$", output),
+              sparkdown::COMPILE_OK);
+    EXPECT_EQ(output, "\\title{T & U}\n\\author{A}\n\\date{D}\n$x$");
+
+    std::string html;
+    sparkdown::html_emitter html_out(html);
+    ASSERT_EQ(c.compile("$title: T & U\n$date: D", {&html_out}),
+              sparkdown::COMPILE_OK);
+    EXPECT_EQ(html, "<h1 class=\"title\">T &amp; U</h1>\n"
+                    "<p class=\"date\">D</p>");
+}
+
+/**
+ * @brief Table test.
+ * @details Ensures that pipe tables become `longtable` environments
+ *     and HTML tables, that escaped bars are written for each backend,
+ *     that "\r\n" line endings are recognized,
+ *     that they end any open lists,
+ *     and that a long table compiles without allocating once warm.
+ *
+ */
+TEST(compiler, tables) {
+    sparkdown::compiler c;
+    const std::string input =
+        "* a\n| Name | $x$ | y\n|:--|--:|:-:|\n| b < c\\|d | 1 | 2 |\nd";
+
+    std::string latex;
+    std::string html;
+    sparkdown::latex_emitter latex_out(latex);
+    sparkdown::html_emitter html_out(html);
+    ASSERT_EQ(c.compile(input, {&latex_out, &html_out}), sparkdown::COMPILE_OK);
+    EXPECT_EQ(latex,
+              "\\begin{itemize}\n\\item a\n\\end{itemize}\n"
+              "\\begin{longtable}{lrc}\n\\hline\n"
+              " Name & $x$ & y \\\\\n\\hline\n\\endhead\n"
+              " b < c\\textbar{}d & 1 & 2  \\\\\n\\hline\n\\end{longtable}\nd");
+    EXPECT_EQ(html,
+              "<ul>\n<li>a\n</li></ul>\n<table>\n"
+              "<tr><th> Name </th><th style=\"text-align: right\"> $x$ </th>"
+              "<th style=\"text-align: center\"> y</th></tr>\n"
+              "<tr><td> b &lt; c|d </td>"
+              "<td style=\"text-align: right\"> 1 </td>"
+              "<td style=\"text-align: center\"> 2 </td></tr>\n</table>\nd");
+
+    // "\r\n" line endings are kept outside of the table's commands.
+    ASSERT_EQ(c.compile("| a | b |\r\n|---|---|\r\n| 1 | 2 |\r\n", latex),
+              sparkdown::COMPILE_OK);
+    EXPECT_EQ(latex,
+              "\\begin{longtable}{ll}\n\\hline\n"
+              " a & b  \\\\\n\\hline\n\\endhead\r\n"
+              " 1 & 2  \\\\\n\\hline\n\\end{longtable}\r\n");
+
+    ASSERT_TRUE(sparkdown::compile_stats::counting_allocations());
+    std::string table = "| n | square |\n|--:|--:|\n";
+    for (std::size_t i = 0; i < 10000; i++) {
+        table += "| " + std::to_string(i) + "\\| | " + std::to_string(i * i);
+        table += " |\n";
+    }
+    ASSERT_EQ(c.compile(table, latex), sparkdown::COMPILE_OK);
+    std::uint64_t before = sparkdown::compile_stats::thread_allocations();
+    ASSERT_EQ(c.compile(table, latex), sparkdown::COMPILE_OK);
+    EXPECT_EQ(sparkdown::compile_stats::thread_allocations(), before);
+}
+
+/**
+ * @brief Fan-out test.
+ * @details Ensures that several emitters are fed by a single parse,
+ *     and that the LaTeX emitter matches the plain `compile()`.
+ *
+ */
+TEST(compiler, fan_out) {
+    sparkdown::compiler c;
+    bracket_handler handler;
+    c.set_include_handler(&handler);
+    const std::string input = "* a & $x<y$\n$include: b\n```\n<i>\n```\n";
+
+    std::string expected;
+    ASSERT_EQ(c.compile(input, expected), sparkdown::COMPILE_OK);
+
+    sparkdown::compile_stats stats;
+    c.set_stats(&stats);
+    std::string latex = "leftover";
+    std::string html = "leftover";
+    sparkdown::latex_emitter latex_out(latex);
+    sparkdown::html_emitter html_out(html);
+    ASSERT_EQ(c.compile(input, {&latex_out, &html_out}), sparkdown::COMPILE_OK);
+
+    EXPECT_EQ(latex, expected);
+    EXPECT_EQ(html,
+              "<ul>\n<li>a &amp; $x&lt;y$\n</li></ul>\n[b]\n"
+              "<pre><code>&lt;i&gt;\n</code></pre>\n");
+    EXPECT_EQ(stats.bytes_in, input.size());
+    EXPECT_EQ(stats.bytes_out, latex.size() + html.size());
+}
+
+/**
+ * @brief `compiler#boundary()` test.
+ * @details Ensures that cuts are only made before lines
+ *     that close every list and table, and never inside of a region.
+ *
+ */
+TEST(compiler, boundary) {
+    EXPECT_EQ(sparkdown::compiler::boundary(""), 0);
+    EXPECT_EQ(sparkdown::compiler::boundary("a\nb\n"), 2);
+    EXPECT_EQ(sparkdown::compiler::boundary("a\n\nb"), 3);
+    EXPECT_EQ(sparkdown::compiler::boundary("a\n* b\n  c\n1. d\n-e"), 0);
+    EXPECT_EQ(sparkdown::compiler::boundary("$x\ny$\nz"), 6);
+    EXPECT_EQ(sparkdown::compiler::boundary("```\na\n```\nb"), 10);
+    EXPECT_EQ(sparkdown::compiler::boundary("a\n```\nb\nc"), 2);
+    EXPECT_EQ(sparkdown::compiler::boundary("a\n$b\nc"), 2);
+    EXPECT_EQ(sparkdown::compiler::boundary("% $\na"), 4);
+    EXPECT_EQ(sparkdown::compiler::boundary("|a|\n|-|\n|b|\n|c|"), 0);
+}
+
+/**
+ * @brief `compiler#boundary()` differential test.
+ * @details Cuts every prefix of realistic documents,
+ *     and ensures that compiling the two parts separately
+ *     gives the same output as compiling the whole.
+ *
+ */
+TEST(compiler, boundary_matches_whole) {
+    sparkdown::compiler c;
+    std::string whole;
+    std::string first;
+    std::string second;
+    for (std::uint64_t seed = 1; seed <= 4; seed++) {
+        const std::string document = sparkdown::corpus(seed).generate(8 << 10);
+        ASSERT_EQ(c.compile(document, whole), sparkdown::COMPILE_OK);
+
+        std::size_t cuts = 0;
+        for (std::size_t n = 0; n <= document.size(); n += 97) {
+            std::size_t cut = sparkdown::compiler::boundary(
+                std::string_view(document).substr(0, n));
+            if (cut == 0) continue;
+            cuts++;
+
+            ASSERT_EQ(c.compile(document.substr(0, cut), first),
+                      sparkdown::COMPILE_OK);
+            ASSERT_EQ(c.compile(document.substr(cut), second),
+                      sparkdown::COMPILE_OK);
+            EXPECT_EQ(first + second, whole) << "seed " << seed << ", " << cut;
+        }
+        EXPECT_GT(cuts, 0);
+    }
+}
+
+/**
+ * @brief Resumed `compiler#boundary()` test.
+ * @details Reads realistic documents a few bytes at a time,
+ *     cutting as the pipelined driver does,
+ *     and ensures that the resumed scans find the same cuts
+ *     as scanning all of the pending text each time.
+ *
+ */
+TEST(compiler, boundary_resumes) {
+    for (std::uint64_t seed = 1; seed <= 4; seed++) {
+        const std::string document = sparkdown::corpus(seed).generate(8 << 10);
+        std::string pending;
+        std::size_t resume = 0;
+        std::size_t cuts = 0;
+        for (std::size_t n = 0; n < document.size(); n += 1 + n % 13) {
+            pending += document.substr(n, 1 + n % 13);
+            std::size_t cut = sparkdown::compiler::boundary(pending, resume);
+            std::size_t expected = sparkdown::compiler::boundary(pending);
+            if (cut == 0) {
+                EXPECT_LE(expected, resume + 1) << "seed " << seed << ", " << n;
+                continue;
+            }
+            ASSERT_EQ(cut, expected) << "seed " << seed << ", " << n;
+            cuts++;
+            pending.erase(0, cut);
+            resume = resume > cut ? resume - cut : 0;
+        }
+        EXPECT_GT(cuts, 0);
+    }
+}
+
+/**
+ * @brief `compiler#section()` test.
+ * @details Ensures that a section runs from one headline to the next,
+ *     and that headlines inside of regions are not counted.
+ *
+ */
+TEST(compiler, section) {
+    const std::string_view text =
+        "$title: T\nintro\n# A\na\n```\n# code\n```\n## B\n$$\n# x\n$$\n"
+        "b\n#C\n### D\nd";
+    auto section = [&](std::size_t first, std::size_t last) {
+        return std::string(sparkdown::compiler::section(text, first, last));
+    };
+
+    EXPECT_EQ(section(0, 0), "$title: T\nintro\n");
+    EXPECT_EQ(section(2, 1), "$title: T\nintro\n");
+    EXPECT_EQ(section(3, 3), "# A\na\n```\n# code\n```\n");
+    EXPECT_EQ(section(6, 6), "# A\na\n```\n# code\n```\n");
+    EXPECT_EQ(section(10, 0), "## B\n$$\n# x\n$$\nb\n#C\n");
+    EXPECT_EQ(section(13, 13), "## B\n$$\n# x\n$$\nb\n#C\n");
+    EXPECT_EQ(section(14, 99), "### D\nd");
+    EXPECT_EQ(section(99, 99), "### D\nd");
+    EXPECT_EQ(section(4, 8), "# A\na\n```\n# code\n```\n## B\n$$\n# x\n$$\n"
+                             "b\n#C\n");
+    EXPECT_EQ(sparkdown::compiler::section("a\n$x\n# y", 3, 3), "a\n$x\n# y");
+    EXPECT_EQ(sparkdown::compiler::section("", 1, 1), "");
+}
+
+/**
+ * @brief `compiler#section()` differential test.
+ * @details Compiles the section around every line of realistic documents,
+ *     and ensures that its output is the matching part of the output
+ *     of the whole, and that only the section is lexed.
+ *
+ */
+TEST(compiler, section_matches_whole) {
+    sparkdown::compiler c;
+    std::string whole;
+    std::string before;
+    std::string part;
+    for (std::uint64_t seed = 1; seed <= 4; seed++) {
+        const std::string document = sparkdown::corpus(seed).generate(8 << 10);
+        const std::string_view text = document;
+        ASSERT_EQ(c.compile(document, whole), sparkdown::COMPILE_OK);
+
+        std::size_t lines = 1 + std::count(text.begin(), text.end(), '\n');
+        std::set<std::size_t> starts;
+        for (std::size_t line = 1; line <= lines; line += 7) {
+            std::string_view found =
+                sparkdown::compiler::section(text, line, line);
+            std::size_t start = found.data() - text.data();
+            ASSERT_FALSE(found.empty());
+            starts.insert(start);
+
+            ASSERT_EQ(c.compile(text.substr(0, start), before),
+                      sparkdown::COMPILE_OK);
+            sparkdown::compile_stats stats;
+            c.set_stats(&stats);
+            ASSERT_EQ(c.compile(found, part), sparkdown::COMPILE_OK);
+            c.set_stats(nullptr);
+            EXPECT_EQ(stats.bytes_in, found.size());
+            EXPECT_EQ(whole.substr(before.size(), part.size()), part)
+                << "seed " << seed << ", line " << line;
+        }
+        EXPECT_GT(starts.size(), 1);
+    }
+}
+
+/**
+ * @brief `compiler#local()` test.
+ * @details Ensures that each thread is given a compiler of its own,
+ *     and that a thread is given the same one every time.
+ *
+ */
+TEST(compiler, local) {
+    sparkdown::compiler *mine = &sparkdown::compiler::local();
+    EXPECT_EQ(&sparkdown::compiler::local(), mine);
+
+    sparkdown::compiler *theirs = nullptr;
+    std::thread([&] { theirs = &sparkdown::compiler::local(); }).join();
+    EXPECT_NE(theirs, mine);
+}
+
+/**
+ * @brief Concurrency stress test.
+ * @details Runs many threads, each compiling the same documents
+ *     with its own compiler, and ensures that every output matches
+ *     the output of a single thread. The threads share only
+ *     the constant tables, so the test runs clean under ThreadSanitizer:
+ *
+ *         bazel test --config=tsan //compiler:compiler.tests
+ *
+ */
+TEST(compiler, concurrent_compilation) {
+    const unsigned threads = 8;
+    const unsigned rounds = 4;
+
+    std::vector<std::string> documents;
+    for (std::uint64_t seed = 1; seed <= 4; seed++) {
+        documents.push_back(sparkdown::corpus(seed).generate(16 << 10));
+    }
+    std::vector<std::string> expected(documents.size());
+    {
+        sparkdown::compiler c;
+        for (std::size_t i = 0; i < documents.size(); i++) {
+            ASSERT_EQ(c.compile(documents[i], expected[i]),
+                      sparkdown::COMPILE_OK);
+        }
+    }
+
+    std::vector<unsigned> mismatches(threads, 0);
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; t++) {
+        pool.emplace_back([&, t] {
+            sparkdown::compiler &c = sparkdown::compiler::local();
+            std::string output;
+            for (unsigned round = 0; round < rounds; round++) {
+                for (std::size_t i = 0; i < documents.size(); i++) {
+                    // Each thread starts at a different document.
+                    std::size_t d = (i + t) % documents.size();
+                    if (c.compile(documents[d], output) !=
+                            sparkdown::COMPILE_OK ||
+                        output != expected[d]) {
+                        mismatches[t]++;
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread &thread : pool) thread.join();
+
+    for (unsigned t = 0; t < threads; t++) {
+        EXPECT_EQ(mismatches[t], 0) << "thread " << t;
+    }
+}
+
+/**
+ * @brief `compiler#describe()` test.
+ *
+ */
+TEST(compiler, describe) {
+    EXPECT_EQ(sparkdown::compiler::describe(sparkdown::COMPILE_OK), "success");
+    EXPECT_FALSE(
+        sparkdown::compiler::describe(sparkdown::COMPILE_UNTERMINATED_MATH)
+            .empty());
+    EXPECT_FALSE(
+        sparkdown::compiler::describe(sparkdown::COMPILE_UNTERMINATED_VERBATIM)
+            .empty());
+    EXPECT_FALSE(
+        sparkdown::compiler::describe(sparkdown::COMPILE_DAMAGED_TREE).empty());
+}
+
+#pragma clang diagnostic pop
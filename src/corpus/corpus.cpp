@@ -0,0 +1,301 @@
+/**
+ * @file corpus/corpus.cpp
+ * @package //corpus:corpus.lib
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `corpus` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `corpus` class,
+ *     which generates synthetic Sparkdown documents for benchmarking
+ *     and scale testing.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "corpus.hpp"
+
+#include <sstream>
+
+namespace sparkdown {
+
+namespace {
+
+/**
+ * @brief The words that generated text is made of.
+ *
+ */
+const char *const words[] = {
+    "the",      "a",          "of",        "and",      "to",
+    "is",       "in",         "that",      "for",      "with",
+    "graph",    "vertex",     "edge",      "tree",     "set",
+    "function", "derivative", "integral",  "limit",    "matrix",
+    "vector",   "proof",      "lemma",     "theorem",  "induction",
+    "algorithm", "runtime",   "memory",    "cache",    "pointer",
+    "compiler", "grammar",    "token",     "parser",   "state",
+    "entropy",  "energy",     "momentum",  "particle", "wave",
+    "note:",    "(see",       "above),",   "e.g.,",    "i.e.,",
+    "first",    "second",     "finally",   "always",   "never",
+};
+
+/**
+ * @brief The arrows that may appear in generated text.
+ *
+ */
+const char *const arrows[] = {"->", "-->", "<-", "<--", "<->", "=>", "==>"};
+
+/**
+ * @brief The formulas that may appear in generated math.
+ *
+ */
+const char *const formulas[] = {
+    "y = mx + b",
+    "\\sum_{i=1}^{n} i = \\frac{n(n+1)}{2}",
+    "e^{i\\pi} + 1 = 0",
+    "\\int_0^1 x^2 \\, dx = \\frac{1}{3}",
+    "f'(x) = \\lim_{h \\to 0} \\frac{f(x + h) - f(x)}{h}",
+    "\\nabla \\cdot \\mathbf{E} = \\frac{\\rho}{\\varepsilon_0}",
+    "T(n) = 2T(n/2) + O(n)",
+    "\\Pr[X \\geq a] \\leq \\frac{\\mathbb{E}[X]}{a}",
+};
+
+/**
+ * @brief The lines that generated verbatim text is made of.
+ *
+ */
+const char *const code[] = {
+    "int main(int argc, char **argv) {",
+    "    std::vector<int> values = {1, 2, 3};",
+    "    for (auto &v : values) v *= 2;",
+    "    printf(\"%d%%\\n\", total);",
+    "    return x & MASK_ALL | (y ^ ~z);",
+    "    // TODO: handle $HOME and #include <...>",
+    "}",
+    "def f(x): return x ** 2  # squared",
+};
+
+/**
+ * @brief Returns the number of elements in the given array.
+ *
+ */
+template <class T, std::size_t N>
+constexpr std::size_t count(const T (&)[N]) {
+    return N;
+}
+
+/**
+ * @brief The number of bytes to buffer before writing to the stream.
+ *
+ */
+constexpr std::size_t chunk_size = 1 << 16;
+
+}  // namespace
+
+bool corpus_mix::set(std::string_view name, unsigned value) {
+    if (name == "headers") {
+        this->headers = value;
+    } else if (name == "paragraphs") {
+        this->paragraphs = value;
+    } else if (name == "lists") {
+        this->lists = value;
+    } else if (name == "math") {
+        this->math = value;
+    } else if (name == "verbatim") {
+        this->verbatim = value;
+    } else if (name == "emphasis") {
+        this->emphasis = value;
+    } else if (name == "arrows") {
+        this->arrows = value;
+    } else if (name == "comments") {
+        this->comments = value;
+    } else if (name == "max_list_depth") {
+        this->max_list_depth = value;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+corpus::corpus(std::uint64_t seed, corpus_mix mix)
+    : _mix(mix), _seed(seed), _state(seed) {}
+
+std::uint64_t corpus::_next() {
+    std::uint64_t z = (this->_state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+std::size_t corpus::_below(std::size_t bound) {
+    return static_cast<std::size_t>(this->_next() % bound);
+}
+
+void corpus::_words(std::size_t number) {
+    for (std::size_t i = 0; i < number; i++) {
+        if (i > 0) this->_buffer += ' ';
+
+        const char *word = words[this->_below(count(words))];
+        std::size_t roll = this->_below(100);
+        std::size_t emphasis = this->_mix.emphasis;
+        std::size_t arrow = emphasis + this->_mix.arrows;
+        std::size_t math = arrow + this->_mix.math;
+
+        if (roll < emphasis) {
+            const char *marker = this->_below(2) ? "*" : "**";
+            this->_buffer += marker;
+            this->_buffer += word;
+            this->_buffer += marker;
+        } else if (roll < arrow) {
+            this->_buffer += arrows[this->_below(count(arrows))];
+            this->_buffer += ' ';
+            this->_buffer += word;
+        } else if (roll < math) {
+            this->_buffer += "$x_";
+            this->_buffer += std::to_string(this->_below(10));
+            this->_buffer += "^2$";
+        } else {
+            this->_buffer += word;
+        }
+    }
+}
+
+void corpus::_header() {
+    this->_buffer.append(1 + this->_below(3), '#');
+    this->_buffer += ' ';
+    this->_words(2 + this->_below(5));
+    this->_buffer += "\n\n";
+}
+
+void corpus::_paragraph() {
+    std::size_t lines = 1 + this->_below(5);
+    for (std::size_t i = 0; i < lines; i++) {
+        this->_words(5 + this->_below(8));
+        this->_buffer += '\n';
+    }
+    this->_buffer += '\n';
+}
+
+void corpus::_list(unsigned depth, unsigned indent) {
+    std::size_t kind = this->_below(3);
+    std::size_t items = 1 + this->_below(6);
+
+    for (std::size_t i = 0; i < items; i++) {
+        this->_buffer.append(indent, ' ');
+        if (kind == 0) {
+            this->_buffer += "* ";
+        } else if (kind == 1) {
+            this->_buffer += "- ";
+        } else {
+            this->_buffer += std::to_string(i + 1) + ". ";
+        }
+        this->_words(3 + this->_below(8));
+        this->_buffer += '\n';
+
+        if (this->_below(4) == 0) {
+            this->_buffer.append(indent + 2, ' ');
+            this->_words(3 + this->_below(8));
+            this->_buffer += '\n';
+        }
+        if (this->_below(8) == 0) {
+            this->_buffer.append(indent + 2, ' ');
+            this->_buffer += "\\\\ ";
+            this->_words(3 + this->_below(8));
+            this->_buffer += '\n';
+        }
+        if (depth < this->_mix.max_list_depth && this->_below(3) == 0) {
+            this->_list(depth + 1, indent + 2);
+        }
+    }
+
+    if (depth == 1) this->_buffer += '\n';
+}
+
+void corpus::_math() {
+    this->_buffer += "\\[\n  ";
+    this->_buffer += formulas[this->_below(count(formulas))];
+    this->_buffer += "\n\\]\n\n";
+}
+
+void corpus::_verbatim() {
+    this->_buffer += "```\n";
+    std::size_t lines = 2 + this->_below(7);
+    for (std::size_t i = 0; i < lines; i++) {
+        this->_buffer += code[this->_below(count(code))];
+        this->_buffer += '\n';
+    }
+    this->_buffer += "```\n\n";
+}
+
+void corpus::_comment() {
+    this->_buffer += "% ";
+    this->_buffer.append(words[this->_below(count(words))]);
+    this->_buffer += ' ';
+    this->_buffer.append(words[this->_below(count(words))]);
+    this->_buffer += '\n';
+}
+
+void corpus::generate(std::ostream &output, std::uint64_t size) {
+    this->_state = this->_seed;
+    this->_buffer.clear();
+    this->_buffer += "$title: ";
+    this->_words(3);
+    this->_buffer += "\n$author: Sparkdown Corpus\n$date: 2022\n\n";
+    this->_buffer += "=============\n\n";
+
+    const unsigned weights[] = {
+        this->_mix.headers, this->_mix.paragraphs, this->_mix.lists,
+        this->_mix.math,    this->_mix.verbatim,   this->_mix.comments,
+    };
+    unsigned total = 0;
+    for (unsigned weight : weights) total += weight;
+
+    std::uint64_t written = 0;
+    while (written + this->_buffer.size() < size) {
+        std::size_t roll = total ? this->_below(total) : 0;
+        std::size_t block = 0;
+        while (total && roll >= weights[block]) roll -= weights[block++];
+
+        switch (total ? block : 1) {
+            case 0:
+                this->_header();
+                break;
+            case 1:
+                this->_paragraph();
+                break;
+            case 2:
+                this->_list(1, 0);
+                break;
+            case 3:
+                this->_math();
+                break;
+            case 4:
+                this->_verbatim();
+                break;
+            default:
+                this->_comment();
+                break;
+        }
+
+        if (this->_buffer.size() >= chunk_size) {
+            output.write(this->_buffer.data(),
+                         static_cast<std::streamsize>(this->_buffer.size()));
+            written += this->_buffer.size();
+            this->_buffer.clear();
+        }
+    }
+
+    output.write(this->_buffer.data(),
+                 static_cast<std::streamsize>(this->_buffer.size()));
+    this->_buffer.clear();
+}
+
+std::string corpus::generate(std::uint64_t size) {
+    std::ostringstream output;
+    this->generate(output, size);
+    return output.str();
+}
+
+}  // namespace sparkdown
@@ -0,0 +1,191 @@
+/**
+ * @file corpus/corpus.hpp
+ * @package //corpus:corpus.lib
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `corpus` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `corpus` class,
+ *     which generates synthetic Sparkdown documents for benchmarking
+ *     and scale testing.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef CORPUS_HPP
+#define CORPUS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace sparkdown {
+
+/**
+ * @brief The relative weights of each kind of block in a generated document,
+ *     and other knobs.
+ * @details A weight of zero disables that kind of block.
+ *
+ */
+struct corpus_mix {
+    unsigned headers = 2;     // "#", "##", and "###" headers.
+    unsigned paragraphs = 8;  // Plain text, with inline features mixed in.
+    unsigned lists = 4;       // Nested "*", "-", and "1." lists.
+    unsigned math = 2;        // "\[ ... \]" blocks and "$...$" spans.
+    unsigned verbatim = 2;    // Triple-backtick blocks.
+    unsigned emphasis = 3;    // "*italic*" and "**bold**" spans.
+    unsigned arrows = 2;      // "->", "-->", and friends.
+    unsigned comments = 1;    // "% ..." lines.
+
+    /**
+     * @brief The deepest level of list nesting.
+     *
+     */
+    unsigned max_list_depth = 4;
+
+    /**
+     * @brief Sets the weight with the given name.
+     *
+     * @param name The name of the weight, e.g. "lists".
+     * @param value The new weight.
+     * @return True if the name was recognized.
+     */
+    bool set(std::string_view name, unsigned value);
+};
+
+/**
+ * @brief Generates synthetic Sparkdown documents.
+ * @details The output depends only on the seed, the mix, and the size,
+ *     and is the same on every platform:
+ *     the random number generator is built in,
+ *     rather than taken from the standard library.
+ *
+ *     Every document starts with head metadata ("$title: " and friends),
+ *     followed by blocks chosen at random according to the mix.
+ *     Documents are written in chunks, so gigabyte-sized documents
+ *     can be streamed without being held in memory.
+ *
+ */
+class corpus {
+   private:
+    /**
+     * @brief The mix of blocks to generate.
+     *
+     */
+    corpus_mix _mix;
+
+    /**
+     * @brief The seed of the random number generator.
+     *
+     */
+    std::uint64_t _seed;
+
+    /**
+     * @brief The state of the random number generator.
+     *
+     */
+    std::uint64_t _state;
+
+    /**
+     * @brief Holds the text generated but not yet written.
+     *
+     */
+    std::string _buffer;
+
+    /**
+     * @brief Returns the next pseudo-random number (SplitMix64).
+     *
+     * @return The next number.
+     */
+    std::uint64_t _next();
+
+    /**
+     * @brief Returns a pseudo-random number in `[0, bound)`.
+     *
+     * @param bound The exclusive upper bound. Must be positive.
+     * @return The number.
+     */
+    std::size_t _below(std::size_t bound);
+
+    /**
+     * @brief Appends a run of pseudo-random words to the buffer,
+     *     with inline features mixed in.
+     *
+     * @param count The number of words.
+     */
+    void _words(std::size_t count);
+
+    /**
+     * @brief Appends a header to the buffer.
+     *
+     */
+    void _header();
+
+    /**
+     * @brief Appends a paragraph to the buffer.
+     *
+     */
+    void _paragraph();
+
+    /**
+     * @brief Appends a list, and maybe nested lists, to the buffer.
+     *
+     * @param depth The nesting depth of the list, starting from 1.
+     * @param indent The indentation of the list items, in spaces.
+     */
+    void _list(unsigned depth, unsigned indent);
+
+    /**
+     * @brief Appends a block of math to the buffer.
+     *
+     */
+    void _math();
+
+    /**
+     * @brief Appends a block of verbatim text to the buffer.
+     *
+     */
+    void _verbatim();
+
+    /**
+     * @brief Appends a comment to the buffer.
+     *
+     */
+    void _comment();
+
+   public:
+    /**
+     * @brief Constructor.
+     *
+     * @param seed The seed of the random number generator.
+     * @param mix The mix of blocks to generate.
+     */
+    explicit corpus(std::uint64_t seed, corpus_mix mix = {});
+
+    /**
+     * @brief Writes a document of about the given size to the given stream.
+     * @details The document ends at a block boundary,
+     *     so it may be slightly larger than requested.
+     *
+     * @param output The stream to write to.
+     * @param size The size of the document, in bytes.
+     */
+    void generate(std::ostream &output, std::uint64_t size);
+
+    /**
+     * @brief Returns a document of about the given size.
+     * @details See `generate(std::ostream&, std::uint64_t)`.
+     *
+     * @param size The size of the document, in bytes.
+     * @return The document.
+     */
+    std::string generate(std::uint64_t size);
+};
+
+}  // namespace sparkdown
+
+#endif
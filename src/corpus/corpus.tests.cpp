@@ -0,0 +1,75 @@
+/**
+ * @file corpus/corpus.tests.cpp
+ * @package //corpus:corpus.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `corpus` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `corpus` class,
+ *     which generates synthetic Sparkdown documents for benchmarking
+ *     and scale testing.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "corpus.hpp"
+
+#include <gtest/gtest.h>
+
+/**
+ * @brief `corpus#generate()` determinism test.
+ * @details Ensures that the same seed gives the same document,
+ *     and that a different seed gives a different one.
+ *
+ */
+TEST(corpus, is_deterministic) {
+    sparkdown::corpus first(42);
+    sparkdown::corpus second(42);
+    sparkdown::corpus third(43);
+
+    std::string document = first.generate(100000);
+    EXPECT_EQ(document, second.generate(100000));
+    EXPECT_EQ(document, first.generate(100000));
+    EXPECT_NE(document, third.generate(100000));
+}
+
+/**
+ * @brief `corpus#generate()` size test.
+ * @details Ensures that the document is at least the requested size,
+ *     and not much larger, across the chunk boundary.
+ *
+ */
+TEST(corpus, honors_size) {
+    sparkdown::corpus c(1);
+
+    for (std::uint64_t size : {1000, 65536, 300000}) {
+        std::string document = c.generate(size);
+        EXPECT_GE(document.size(), size);
+        EXPECT_LT(document.size(), size + 4096);
+    }
+}
+
+/**
+ * @brief `corpus#generate()` mix test.
+ * @details Ensures that the document starts with head metadata,
+ *     and that disabling a kind of block removes it.
+ *
+ */
+TEST(corpus, honors_mix) {
+    std::string document = sparkdown::corpus(7).generate(50000);
+    EXPECT_EQ(document.rfind("$title: ", 0), 0);
+    EXPECT_NE(document.find("```"), std::string::npos);
+    EXPECT_NE(document.find("\\["), std::string::npos);
+
+    sparkdown::corpus_mix mix;
+    EXPECT_TRUE(mix.set("verbatim", 0));
+    EXPECT_TRUE(mix.set("math", 0));
+    EXPECT_FALSE(mix.set("tables", 1));
+
+    document = sparkdown::corpus(7, mix).generate(50000);
+    EXPECT_EQ(document.find("```"), std::string::npos);
+    EXPECT_EQ(document.find("\\["), std::string::npos);
+    EXPECT_EQ(document.find("$x_"), std::string::npos);
+}
@@ -0,0 +1,145 @@
+/**
+ * @file corpus/executable.cpp
+ * @package //corpus:corpus
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief Synthetic corpus generator command-line interface.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file contains the entry point of the corpus generator,
+ *     which writes reproducible synthetic Sparkdown documents
+ *     for benchmarking and scale testing.
+ *
+ *     Usage of this program:
+ *
+ *         `corpus --size 64M --seed 7 --out big._`
+ *
+ *             Sizes may use the suffixes `K`, `M`, and `G`.
+ *             Output is written to stdout by default.
+ *
+ *         The argument `--mix` adjusts the weights of the kinds of blocks:
+ *
+ *             `corpus --size 1G --mix lists=10,verbatim=0`
+ *
+ *             The weights are `headers`, `paragraphs`, `lists`, `math`,
+ *             `verbatim`, `emphasis`, `arrows`, and `comments`;
+ *             `max_list_depth` sets the deepest level of list nesting.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "arg.h/arg.h"
+#include "corpus.hpp"
+
+/**
+ * @brief Parses a size with an optional `K`, `M`, or `G` suffix.
+ *
+ * @param text The size to parse.
+ * @param size Receives the size, in bytes.
+ * @return True if the size was well-formed.
+ */
+static bool parse_size(const std::string &text, std::uint64_t &size) {
+    std::istringstream stream(text);
+    std::string suffix;
+    if (!(stream >> size)) return false;
+    stream >> suffix;
+
+    if (suffix == "K" || suffix == "k") {
+        size <<= 10;
+    } else if (suffix == "M" || suffix == "m") {
+        size <<= 20;
+    } else if (suffix == "G" || suffix == "g") {
+        size <<= 30;
+    } else if (!suffix.empty()) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Main program entry point.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments.
+ * @return 0 on success; 1 on failure.
+ */
+int main(int argc, char **argv) {
+    argh arguments(argc, argv);
+
+    if (arguments["-h"] || arguments["--help"]) {
+        std::cout << "Usage:" << std::endl
+                  << "    corpus --size <size> [options]" << std::endl
+                  << std::endl
+                  << "Options:" << std::endl
+                  << "    --size <size>        --  The size of the document,"
+                  << std::endl
+                  << "                             e.g. 100K, 64M, or 2G."
+                  << std::endl
+                  << "    --seed <number>      --  The random seed."
+                  << " Defaults to 1." << std::endl
+                  << "    --mix <weights>      --  Block weights, e.g."
+                  << std::endl
+                  << "                             lists=10,verbatim=0."
+                  << std::endl
+                  << "    -o / --out <file>    --  Write to the given file"
+                  << " instead of stdout." << std::endl;
+        return 0;
+    }
+
+    std::uint64_t size = 1 << 20;
+    if (arguments["--size"] && !parse_size(arguments("--size"), size)) {
+        std::cerr << "Error: invalid size \"" << arguments("--size")
+                  << "\". Exiting." << std::endl;
+        return 1;
+    }
+
+    std::uint64_t seed = 1;
+    if (arguments["--seed"]) {
+        std::istringstream stream(arguments("--seed"));
+        if (!(stream >> seed)) {
+            std::cerr << "Error: invalid seed \"" << arguments("--seed")
+                      << "\". Exiting." << std::endl;
+            return 1;
+        }
+    }
+
+    sparkdown::corpus_mix mix;
+    if (arguments["--mix"]) {
+        std::istringstream stream(arguments("--mix"));
+        for (std::string item; std::getline(stream, item, ',');) {
+            std::size_t equals = item.find('=');
+            unsigned value = 0;
+            std::istringstream number(
+                equals == std::string::npos ? "" : item.substr(equals + 1));
+            if (!(number >> value) || !mix.set(item.substr(0, equals), value)) {
+                std::cerr << "Error: invalid weight \"" << item
+                          << "\". Exiting." << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    std::string output;
+    if (arguments["-o"]) output = arguments("-o");
+    if (arguments["--out"]) output = arguments("--out");
+
+    sparkdown::corpus corpus(seed, mix);
+    if (output.empty()) {
+        corpus.generate(std::cout, size);
+    } else {
+        std::ofstream file(output, std::ios::binary);
+        corpus.generate(file, size);
+        if (!file) {
+            std::cerr << "Error: could not write \"" << output
+                      << "\". Exiting." << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,215 @@
+/**
+ * @file emitter/emitter.hpp
+ * @package //emitter:emitter
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `emitter` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `emitter` class,
+ *     which is the interface of every output backend.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef EMITTER_HPP
+#define EMITTER_HPP
+
+#include <string>
+#include <string_view>
+
+#include "state/state.hpp"
+
+namespace sparkdown {
+
+/**
+ * @brief An enumeration of the fields of the document head.
+ *
+ */
+enum head_field {
+    HEAD_TITLE,   // Given by "$title: ".
+    HEAD_AUTHOR,  // Given by "$author: ".
+    HEAD_DATE     // Given by "$date: ".
+};
+
+/**
+ * @brief Writes a parsed document in a single output format.
+ * @details The compiler walks the parsed tokens once,
+ *     calling the same methods on every emitter it was given,
+ *     so one parse can feed several backends at once.
+ *     Each emitter writes onto the end of its own output buffer.
+ *
+ *     Runs of plain text are given to `text()` whole,
+ *     so a backend can escape them in bulk.
+ *
+ */
+class emitter {
+   protected:
+    /**
+     * @brief The buffer that this emitter writes to.
+     *
+     */
+    std::string *_output;
+
+   public:
+    /**
+     * @brief Constructor.
+     *
+     * @param output The buffer to write to.
+     */
+    explicit emitter(std::string &output) : _output(&output) {}
+
+    /**
+     * @brief Destructor.
+     *
+     */
+    virtual ~emitter() = default;
+
+    emitter(const emitter &) = delete;
+    emitter &operator=(const emitter &) = delete;
+
+    /**
+     * @brief Returns the buffer that this emitter writes to.
+     *
+     * @return The buffer.
+     */
+    [[nodiscard]] std::string &output() const { return *this->_output; }
+
+    /**
+     * @brief Clears the output buffer, before a document is written.
+     * @details Its capacity is kept.
+     *
+     */
+    virtual void clear() { this->_output->clear(); }
+
+    /**
+     * @brief Writes a run of plain text.
+     *
+     * @param text The text, exactly as written in the input.
+     */
+    virtual void text(std::string_view text) = 0;
+
+    /**
+     * @brief Writes a verbatim block.
+     *
+     * @param contents The lines of the block, without the fences.
+     */
+    virtual void verbatim(std::string_view contents) = 0;
+
+    /**
+     * @brief Writes a math region.
+     *
+     * @param region The region, delimiters included.
+     */
+    virtual void math(std::string_view region) = 0;
+
+    /**
+     * @brief Writes a field of the document head.
+     *
+     * @param field The field.
+     * @param value The rest of the directive's line,
+     *     without trailing whitespace.
+     */
+    virtual void head(head_field field, std::string_view value) = 0;
+
+    /**
+     * @brief Writes an include directive.
+     * @details By default, the directive is left to the compiler's
+     *     include handler, which writes the included file
+     *     onto the end of the output buffer.
+     *
+     * @param path The path given by the directive.
+     * @return True if the emitter has written the directive itself.
+     */
+    virtual bool include(std::string_view path) {
+        (void)path;
+        return false;
+    }
+
+    /**
+     * @brief Writes the start of a section headline.
+     *
+     * @param level The level of the headline: 1 for a section,
+     *     2 for a subsection, or 3 for a subsubsection.
+     */
+    virtual void begin_heading(int level) = 0;
+
+    /**
+     * @brief Writes the end of a section headline.
+     *
+     * @param level The level of the headline.
+     */
+    virtual void end_heading(int level) = 0;
+
+    /**
+     * @brief Writes the start of a list.
+     *
+     * @param type The kind of list.
+     */
+    virtual void begin_list(list_type type) = 0;
+
+    /**
+     * @brief Writes the end of a list.
+     *
+     * @param type The kind of list.
+     */
+    virtual void end_list(list_type type) = 0;
+
+    /**
+     * @brief Writes the start of a list item.
+     *
+     */
+    virtual void item() = 0;
+
+    /**
+     * @brief Writes a right arrow.
+     *
+     */
+    virtual void arrow() = 0;
+
+    /**
+     * @brief Writes the start of a table.
+     *
+     * @param columns The alignment of each column, in order:
+     *     'l' for left, 'c' for center, or 'r' for right.
+     */
+    virtual void begin_table(std::string_view columns) = 0;
+
+    /**
+     * @brief Writes the start of a table row, and of its first cell.
+     *
+     * @param header Whether the row is the table's header.
+     */
+    virtual void begin_row(bool header) = 0;
+
+    /**
+     * @brief Writes the end of a cell, and the start of the next one.
+     *
+     * @param header Whether the row is the table's header.
+     */
+    virtual void next_cell(bool header) = 0;
+
+    /**
+     * @brief Writes the end of a table row, and of its last cell.
+     *
+     * @param header Whether the row is the table's header.
+     */
+    virtual void end_row(bool header) = 0;
+
+    /**
+     * @brief Writes a literal vertical bar within a table cell.
+     *
+     */
+    virtual void pipe() = 0;
+
+    /**
+     * @brief Writes the end of a table.
+     *
+     */
+    virtual void end_table() = 0;
+};
+
+}  // namespace sparkdown
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * @file emitter/html_emitter.cpp
+ * @package //emitter:html_emitter
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `html_emitter` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `html_emitter` class,
+ *     which writes a parsed document as an HTML fragment.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "html_emitter.hpp"
+
+#include "escape/escape.hpp"
+
+namespace sparkdown {
+
+void html_emitter::_begin_cell(bool header) {
+    *this->_output += header ? "<th" : "<td";
+    char align =
+        this->_column < this->_columns.size() ? this->_columns[this->_column]
+                                              : 'l';
+    if (align == 'c') *this->_output += " style=\"text-align: center\"";
+    if (align == 'r') *this->_output += " style=\"text-align: right\"";
+    *this->_output += '>';
+}
+
+void html_emitter::_escape(std::string_view text) {
+    escape::append(text, ESCAPE_HTML, *this->_output);
+}
+
+void html_emitter::clear() {
+    this->_output->clear();
+    this->_open_items.clear();
+}
+
+void html_emitter::text(std::string_view text) { this->_escape(text); }
+
+void html_emitter::verbatim(std::string_view contents) {
+    *this->_output += "<pre><code>";
+    this->_escape(contents);
+    *this->_output += "</code></pre>";
+}
+
+void html_emitter::math(std::string_view region) { this->_escape(region); }
+
+void html_emitter::head(head_field field, std::string_view value) {
+    *this->_output += field == HEAD_TITLE    ? "<h1 class=\"title\">"
+                      : field == HEAD_AUTHOR ? "<p class=\"author\">"
+                                             : "<p class=\"date\">";
+    this->_escape(value);
+    *this->_output += field == HEAD_TITLE ? "</h1>" : "</p>";
+}
+
+void html_emitter::begin_heading(int level) {
+    *this->_output += "<h";
+    *this->_output += static_cast<char>('0' + level);
+    *this->_output += '>';
+}
+
+void html_emitter::end_heading(int level) {
+    *this->_output += "</h";
+    *this->_output += static_cast<char>('0' + level);
+    *this->_output += '>';
+}
+
+void html_emitter::begin_list(list_type type) {
+    this->_open_items.push_back(false);
+    *this->_output += type == LIST_ITEMIZE ? "<ul>\n" : "<ol>\n";
+}
+
+void html_emitter::end_list(list_type type) {
+    if (!this->_open_items.empty()) {
+        if (this->_open_items.back()) *this->_output += "</li>";
+        this->_open_items.pop_back();
+    }
+    *this->_output += type == LIST_ITEMIZE ? "</ul>\n" : "</ol>\n";
+}
+
+void html_emitter::item() {
+    if (!this->_open_items.empty()) {
+        if (this->_open_items.back()) *this->_output += "</li>";
+        this->_open_items.back() = true;
+    }
+    *this->_output += "<li>";
+}
+
+void html_emitter::arrow() { *this->_output += "&rarr;"; }
+
+void html_emitter::begin_table(std::string_view columns) {
+    this->_columns = columns;
+    *this->_output += "<table>\n";
+}
+
+void html_emitter::begin_row(bool header) {
+    this->_column = 0;
+    *this->_output += "<tr>";
+    this->_begin_cell(header);
+}
+
+void html_emitter::next_cell(bool header) {
+    *this->_output += header ? "</th>" : "</td>";
+    this->_column++;
+    this->_begin_cell(header);
+}
+
+void html_emitter::end_row(bool header) {
+    *this->_output += header ? "</th></tr>" : "</td></tr>";
+}
+
+void html_emitter::pipe() { *this->_output += '|'; }
+
+void html_emitter::end_table() { *this->_output += "\n</table>"; }
+
+}  // namespace sparkdown
@@ -0,0 +1,147 @@
+/**
+ * @file emitter/html_emitter.hpp
+ * @package //emitter:html_emitter
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `html_emitter` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `html_emitter` class,
+ *     which writes a parsed document as an HTML fragment.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef HTML_EMITTER_HPP
+#define HTML_EMITTER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "emitter.hpp"
+
+namespace sparkdown {
+
+/**
+ * @brief Writes a parsed document as an HTML fragment.
+ * @details The fragment is meant to be placed in the body of a page.
+ *     Text is escaped, but otherwise copied as-is.
+ *     Math regions keep their delimiters,
+ *     so that they can be typeset in the browser, e.g. by MathJax.
+ *
+ */
+class html_emitter : public emitter {
+   private:
+    /**
+     * @brief The column alignments of the table being written.
+     *
+     */
+    std::string _columns;
+
+    /**
+     * @brief The column of the cell being written.
+     *
+     */
+    std::size_t _column = 0;
+
+    /**
+     * @brief Whether each open list, innermost last,
+     *     has an item that has not yet been closed.
+     *
+     */
+    std::vector<bool> _open_items;
+
+    /**
+     * @brief Writes the start of a cell in the current column.
+     *
+     * @param header Whether the cell is in the header row.
+     */
+    void _begin_cell(bool header);
+
+    /**
+     * @brief Writes the given text, escaping "&", "<", and ">".
+     * @details Uses `escape::append()`, which checks 16 bytes at a time.
+     *
+     * @param text The text to write.
+     */
+    void _escape(std::string_view text);
+
+   public:
+    using emitter::emitter;
+
+    /**
+     * @brief Clears the output buffer and the open lists.
+     *
+     */
+    void clear() override;
+
+    void text(std::string_view text) override;
+
+    /**
+     * @brief Writes a verbatim block as a `pre` element.
+     *
+     * @param contents The lines of the block, without the fences.
+     */
+    void verbatim(std::string_view contents) override;
+
+    void math(std::string_view region) override;
+
+    /**
+     * @brief Writes the title as an `h1` element,
+     *     and the author or date as a `p` element,
+     *     each with the field's name as its class.
+     *
+     * @param field The field.
+     * @param value The value, as written in the input.
+     */
+    void head(head_field field, std::string_view value) override;
+
+    void begin_heading(int level) override;
+
+    void end_heading(int level) override;
+
+    void begin_list(list_type type) override;
+
+    /**
+     * @brief Writes the end of a `ul` or `ol` element,
+     *     closing its last item first.
+     *
+     * @param type The type of the list.
+     */
+    void end_list(list_type type) override;
+
+    /**
+     * @brief Writes the start of an `li` element,
+     *     closing the list's previous item first.
+     *
+     */
+    void item() override;
+
+    void arrow() override;
+
+    void begin_table(std::string_view columns) override;
+
+    /**
+     * @brief Writes the start of a `tr` element, and of its first cell.
+     * @details Header cells are `th` elements; the others are `td`.
+     *     Cells in centered and right-aligned columns are given
+     *     a `text-align` style.
+     *
+     * @param header Whether the row is the table's header.
+     */
+    void begin_row(bool header) override;
+
+    void next_cell(bool header) override;
+
+    void end_row(bool header) override;
+
+    void pipe() override;
+
+    void end_table() override;
+};
+
+}  // namespace sparkdown
+
+#endif
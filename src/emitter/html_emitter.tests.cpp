@@ -0,0 +1,137 @@
+/**
+ * @file emitter/html_emitter.tests.cpp
+ * @package //emitter:html_emitter.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `html_emitter` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `html_emitter` class,
+ *     which writes a parsed document as an HTML fragment.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunknown-pragmas"
+#pragma ide diagnostic ignored "UnusedLocalVariable"
+
+#include "html_emitter.hpp"
+
+#include <gtest/gtest.h>
+
+/**
+ * @brief Ensures that text, math, and verbatim blocks are escaped.
+ *
+ */
+TEST(html_emitter, escapes) {
+    std::string output;
+    sparkdown::html_emitter e(output);
+
+    e.text("a & b <c> d");
+    e.math("$x < y$");
+    e.verbatim("#include <x>\n");
+    EXPECT_EQ(output,
+              "a &amp; b &lt;c&gt; d$x &lt; y$"
+              "<pre><code>#include &lt;x&gt;\n</code></pre>");
+}
+
+/**
+ * @brief Ensures that lists become `ul` and `ol` elements,
+ *     with every item closed, and nested lists inside their items.
+ *
+ */
+TEST(html_emitter, lists) {
+    std::string output;
+    sparkdown::html_emitter e(output);
+
+    e.begin_list(sparkdown::LIST_ITEMIZE);
+    e.item();
+    e.text("a ");
+    e.arrow();
+    e.text(" b\n");
+    e.begin_list(sparkdown::LIST_ENUMERATE);
+    e.item();
+    e.text("c\n");
+    e.item();
+    e.text("d\n");
+    e.end_list(sparkdown::LIST_ENUMERATE);
+    e.item();
+    e.text("e\n");
+    e.end_list(sparkdown::LIST_ITEMIZE);
+    EXPECT_EQ(output,
+              "<ul>\n<li>a &rarr; b\n"
+              "<ol>\n<li>c\n</li><li>d\n</li></ol>\n"
+              "</li><li>e\n</li></ul>\n");
+
+    // A cleared emitter starts with no lists open.
+    e.begin_list(sparkdown::LIST_ITEMIZE);
+    e.item();
+    e.clear();
+    e.begin_list(sparkdown::LIST_ITEMIZE);
+    e.item();
+    e.end_list(sparkdown::LIST_ITEMIZE);
+    EXPECT_EQ(output, "<ul>\n<li></li></ul>\n");
+}
+
+/**
+ * @brief Ensures that headlines become `h1` to `h3` elements.
+ *
+ */
+TEST(html_emitter, headings) {
+    std::string output;
+    sparkdown::html_emitter e(output);
+
+    e.begin_heading(2);
+    e.text("A & B");
+    e.end_heading(2);
+    EXPECT_EQ(output, "<h2>A &amp; B</h2>");
+}
+
+/**
+ * @brief Ensures that the head fields are escaped,
+ *     and marked with their names.
+ *
+ */
+TEST(html_emitter, head) {
+    std::string output;
+    sparkdown::html_emitter e(output);
+
+    e.head(sparkdown::HEAD_TITLE, "A & B");
+    e.head(sparkdown::HEAD_AUTHOR, "C");
+    e.head(sparkdown::HEAD_DATE, "D");
+    EXPECT_EQ(output,
+              "<h1 class=\"title\">A &amp; B</h1><p class=\"author\">C</p>"
+              "<p class=\"date\">D</p>");
+}
+
+/**
+ * @brief Ensures that tables become `table` elements,
+ *     with header cells and aligned columns.
+ *
+ */
+TEST(html_emitter, tables) {
+    std::string output;
+    sparkdown::html_emitter e(output);
+
+    e.begin_table("lr");
+    e.begin_row(true);
+    e.text("A");
+    e.pipe();
+    e.next_cell(true);
+    e.text("B");
+    e.end_row(true);
+    e.begin_row(false);
+    e.text("<");
+    e.next_cell(false);
+    e.text("1");
+    e.end_row(false);
+    e.end_table();
+    EXPECT_EQ(output,
+              "<table>\n<tr><th>A|</th><th style=\"text-align: right\">B</th>"
+              "</tr><tr><td>&lt;</td><td style=\"text-align: right\">1</td>"
+              "</tr>\n</table>");
+}
+
+#pragma clang diagnostic pop
@@ -0,0 +1,97 @@
+/**
+ * @file emitter/latex_emitter.cpp
+ * @package //emitter:latex_emitter
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `latex_emitter` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `latex_emitter` class,
+ *     which writes a parsed document as LaTeX code.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "latex_emitter.hpp"
+
+namespace sparkdown {
+
+void latex_emitter::text(std::string_view text) { this->_output->append(text); }
+
+void latex_emitter::verbatim(std::string_view contents) {
+    static constexpr std::string_view end = "\\end{verbatim}";
+
+    *this->_output += "\\begin{verbatim}\n";
+    std::size_t found;
+    while ((found = contents.find(end)) != std::string_view::npos) {
+        this->_output->append(contents.substr(0, found));
+        *this->_output +=
+            "\\end{verbatim}\\verb|\\end{verbatim}|\\begin{verbatim}";
+        contents.remove_prefix(found + end.size());
+    }
+    this->_output->append(contents);
+    *this->_output += "\\end{verbatim}";
+}
+
+void latex_emitter::math(std::string_view region) {
+    this->_output->append(region);
+}
+
+void latex_emitter::head(head_field field, std::string_view value) {
+    *this->_output += field == HEAD_TITLE    ? "\\title{"
+                      : field == HEAD_AUTHOR ? "\\author{"
+                                             : "\\date{";
+    this->_output->append(value);
+    *this->_output += '}';
+}
+
+void latex_emitter::begin_heading(int level) {
+    *this->_output += level == 1   ? "\\section{"
+                      : level == 2 ? "\\subsection{"
+                                   : "\\subsubsection{";
+}
+
+void latex_emitter::end_heading([[maybe_unused]] int level) {
+    *this->_output += '}';
+}
+
+void latex_emitter::begin_list(list_type type) {
+    *this->_output += type == LIST_ITEMIZE ? "\\begin{itemize}\n"
+                                           : "\\begin{enumerate}\n";
+}
+
+void latex_emitter::end_list(list_type type) {
+    *this->_output +=
+        type == LIST_ITEMIZE ? "\\end{itemize}\n" : "\\end{enumerate}\n";
+}
+
+void latex_emitter::item() { *this->_output += "\\item "; }
+
+void latex_emitter::arrow() { *this->_output += "$\\rightarrow$"; }
+
+void latex_emitter::begin_table(std::string_view columns) {
+    *this->_output += "\\begin{longtable}{";
+    this->_output->append(columns);
+    *this->_output += "}\n\\hline\n";
+}
+
+void latex_emitter::begin_row([[maybe_unused]] bool header) {}
+
+void latex_emitter::next_cell([[maybe_unused]] bool header) {
+    *this->_output += '&';
+}
+
+void latex_emitter::end_row(bool header) {
+    *this->_output += header ? " \\\\\n\\hline\n\\endhead" : " \\\\";
+}
+
+void latex_emitter::pipe() { *this->_output += "\\textbar{}"; }
+
+void latex_emitter::end_table() {
+    *this->_output += "\n\\hline\n\\end{longtable}";
+}
+
+}  // namespace sparkdown
@@ -0,0 +1,91 @@
+/**
+ * @file emitter/latex_emitter.hpp
+ * @package //emitter:latex_emitter
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `latex_emitter` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `latex_emitter` class,
+ *     which writes a parsed document as LaTeX code.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef LATEX_EMITTER_HPP
+#define LATEX_EMITTER_HPP
+
+#include "emitter.hpp"
+
+namespace sparkdown {
+
+/**
+ * @brief Writes a parsed document as LaTeX code.
+ * @details Sparkdown text is a superset of LaTeX,
+ *     so plain text and math are copied as-is.
+ *
+ */
+class latex_emitter : public emitter {
+   public:
+    using emitter::emitter;
+
+    void text(std::string_view text) override;
+
+    /**
+     * @brief Writes a verbatim block.
+     * @details The contents are copied as-is into a `verbatim` environment,
+     *     except for "\end{verbatim}",
+     *     which would otherwise end the environment early.
+     *
+     * @param contents The lines of the block, without the fences.
+     */
+    void verbatim(std::string_view contents) override;
+
+    void math(std::string_view region) override;
+
+    /**
+     * @brief Writes a `\title`, `\author`, or `\date` command,
+     *     for use by `\maketitle`.
+     *
+     * @param field The field.
+     * @param value The value, as written in the input.
+     */
+    void head(head_field field, std::string_view value) override;
+
+    void begin_heading(int level) override;
+
+    void end_heading(int level) override;
+
+    void begin_list(list_type type) override;
+
+    void end_list(list_type type) override;
+
+    void item() override;
+
+    void arrow() override;
+
+    /**
+     * @brief Writes the start of a `longtable` environment.
+     * @details A `longtable` is broken across pages,
+     *     and its header row is repeated on each.
+     *     The document must load the `longtable` package.
+     *
+     * @param columns The alignment of each column.
+     */
+    void begin_table(std::string_view columns) override;
+
+    void begin_row(bool header) override;
+
+    void next_cell(bool header) override;
+
+    void end_row(bool header) override;
+
+    void pipe() override;
+
+    void end_table() override;
+};
+
+}  // namespace sparkdown
+
+#endif
@@ -0,0 +1,131 @@
+/**
+ * @file emitter/latex_emitter.tests.cpp
+ * @package //emitter:latex_emitter.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `latex_emitter` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `latex_emitter` class,
+ *     which writes a parsed document as LaTeX code.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunknown-pragmas"
+#pragma ide diagnostic ignored "UnusedLocalVariable"
+
+#include "latex_emitter.hpp"
+
+#include <gtest/gtest.h>
+
+/**
+ * @brief Ensures that text and math are copied as-is.
+ *
+ */
+TEST(latex_emitter, passes_through) {
+    std::string output = "a";
+    sparkdown::latex_emitter e(output);
+
+    e.text(" \\textbf{b} & c < d");
+    e.math("$x_1$");
+    EXPECT_EQ(output, "a \\textbf{b} & c < d$x_1$");
+    EXPECT_EQ(&e.output(), &output);
+}
+
+/**
+ * @brief Ensures that verbatim blocks cannot end their environment early.
+ *
+ */
+TEST(latex_emitter, verbatim) {
+    std::string output;
+    sparkdown::latex_emitter e(output);
+
+    e.verbatim("a\n\\end{verbatim}\n");
+    EXPECT_EQ(output,
+              "\\begin{verbatim}\na\n\\end{verbatim}\\verb|\\end{verbatim}|"
+              "\\begin{verbatim}\n\\end{verbatim}");
+}
+
+/**
+ * @brief Ensures that lists become `itemize` and `enumerate` environments.
+ *
+ */
+TEST(latex_emitter, lists) {
+    std::string output;
+    sparkdown::latex_emitter e(output);
+
+    e.begin_list(sparkdown::LIST_ENUMERATE);
+    e.item();
+    e.text("a ");
+    e.arrow();
+    e.text(" b\n");
+    e.end_list(sparkdown::LIST_ENUMERATE);
+    e.begin_list(sparkdown::LIST_ITEMIZE);
+    e.end_list(sparkdown::LIST_ITEMIZE);
+    EXPECT_EQ(output,
+              "\\begin{enumerate}\n\\item a $\\rightarrow$ b\n"
+              "\\end{enumerate}\n\\begin{itemize}\n\\end{itemize}\n");
+}
+
+/**
+ * @brief Ensures that headlines become sectioning commands.
+ *
+ */
+TEST(latex_emitter, headings) {
+    std::string output;
+    sparkdown::latex_emitter e(output);
+
+    for (int level = 1; level <= 3; level++) {
+        e.begin_heading(level);
+        e.text("A");
+        e.end_heading(level);
+    }
+    EXPECT_EQ(output, "\\section{A}\\subsection{A}\\subsubsection{A}");
+}
+
+/**
+ * @brief Ensures that the head fields become
+ *     `\title`, `\author`, and `\date` commands.
+ *
+ */
+TEST(latex_emitter, head) {
+    std::string output;
+    sparkdown::latex_emitter e(output);
+
+    e.head(sparkdown::HEAD_TITLE, "T");
+    e.head(sparkdown::HEAD_AUTHOR, "A");
+    e.head(sparkdown::HEAD_DATE, "D");
+    EXPECT_EQ(output, "\\title{T}\\author{A}\\date{D}");
+}
+
+/**
+ * @brief Ensures that tables become `longtable` environments,
+ *     with their header rows repeated on each page.
+ *
+ */
+TEST(latex_emitter, tables) {
+    std::string output;
+    sparkdown::latex_emitter e(output);
+
+    e.begin_table("lcr");
+    e.begin_row(true);
+    e.text("A");
+    e.pipe();
+    e.next_cell(true);
+    e.text("B");
+    e.next_cell(true);
+    e.end_row(true);
+    e.begin_row(false);
+    e.text("1");
+    e.end_row(false);
+    e.end_table();
+    EXPECT_EQ(output,
+              "\\begin{longtable}{lcr}\n\\hline\n"
+              "A\\textbar{}&B& \\\\\n\\hline\n\\endhead"
+              "1 \\\\\n\\hline\n\\end{longtable}");
+}
+
+#pragma clang diagnostic pop
@@ -0,0 +1,196 @@
+/**
+ * @file escape/escape.cpp
+ * @package //escape:escape
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `escape` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `escape` class,
+ *     which escapes the characters that are special to LaTeX.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "escape.hpp"
+
+#include <array>
+#include <cstddef>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace sparkdown {
+
+namespace {
+
+/**
+ * @brief The replacements for a single context.
+ *
+ */
+struct table {
+    /**
+     * @brief The replacement for each byte; empty if it needs none.
+     *
+     */
+    std::array<std::string_view, 256> replacements{};
+
+    /**
+     * @brief The bytes that have replacements.
+     *
+     */
+    std::array<char, 16> specials{};
+
+    /**
+     * @brief The number of entries in `specials`.
+     *
+     */
+    std::size_t count = 0;
+
+    /**
+     * @brief Adds a replacement to the table.
+     *
+     * @param c The byte to replace.
+     * @param replacement The replacement.
+     * @return This table.
+     */
+    constexpr table &add(char c, std::string_view replacement) {
+        this->replacements[static_cast<unsigned char>(c)] = replacement;
+        this->specials[this->count++] = c;
+        return *this;
+    }
+};
+
+/**
+ * @brief Returns the replacements for running text.
+ *
+ * @return The table.
+ */
+constexpr table text_table() {
+    table t;
+    t.add('&', "\\&")
+        .add('%', "\\%")
+        .add('$', "\\$")
+        .add('#', "\\#")
+        .add('_', "\\_")
+        .add('{', "\\{")
+        .add('}', "\\}")
+        .add('~', "\\textasciitilde{}")
+        .add('^', "\\textasciicircum{}")
+        .add('\\', "\\textbackslash{}");
+    return t;
+}
+
+/**
+ * @brief Returns the replacements for inline code.
+ * @details The OT1 encoding prints these as other glyphs.
+ *
+ * @return The table.
+ */
+constexpr table verbatim_table() {
+    table t = text_table();
+    t.add('<', "\\textless{}")
+        .add('>', "\\textgreater{}")
+        .add('"', "\\textquotedbl{}");
+    return t;
+}
+
+/**
+ * @brief Returns the replacements for URLs.
+ *
+ * @return The table.
+ */
+constexpr table url_table() {
+    table t;
+    t.add('%', "\\%")
+        .add('#', "\\#")
+        .add('\\', "\\%5C")
+        .add('{', "\\%7B")
+        .add('}', "\\%7D")
+        .add(' ', "\\%20");
+    return t;
+}
+
+/**
+ * @brief Returns the replacements for HTML text.
+ *
+ * @return The table.
+ */
+constexpr table html_table() {
+    table t;
+    t.add('&', "&amp;").add('<', "&lt;").add('>', "&gt;");
+    return t;
+}
+
+/**
+ * @brief The replacements for each context, indexed by `escape_context`.
+ *
+ */
+constexpr std::array<table, 4> tables = {text_table(), verbatim_table(),
+                                         url_table(), html_table()};
+
+}  // namespace
+
+void escape::append(std::string_view input, escape_context context,
+                    std::string &output) {
+#ifdef __SSE2__
+    const table &t = tables[context];
+    const char *data = input.data();
+    const std::size_t size = input.size();
+
+    __m128i specials[sizeof(t.specials)];
+    for (std::size_t k = 0; k < t.count; k++) {
+        specials[k] = _mm_set1_epi8(t.specials[k]);
+    }
+
+    // `clean` is the start of the run of bytes not yet written.
+    std::size_t clean = 0;
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        __m128i hits = _mm_setzero_si128();
+        for (std::size_t k = 0; k < t.count; k++) {
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, specials[k]));
+        }
+
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+        while (mask) {
+            std::size_t at = i + static_cast<std::size_t>(__builtin_ctz(mask));
+            output.append(data + clean, at - clean);
+            output.append(t.replacements[static_cast<unsigned char>(data[at])]);
+            clean = at + 1;
+            mask &= mask - 1;
+        }
+    }
+    output.append(data + clean, i - clean);
+
+    // The last few bytes are too few for a whole chunk.
+    append_scalar(input.substr(i), context, output);
+#else
+    append_scalar(input, context, output);
+#endif
+}
+
+void escape::append_scalar(std::string_view input, escape_context context,
+                           std::string &output) {
+    const table &t = tables[context];
+
+    std::size_t clean = 0;
+    for (std::size_t i = 0; i < input.size(); i++) {
+        std::string_view replacement =
+            t.replacements[static_cast<unsigned char>(input[i])];
+        if (replacement.empty()) continue;
+
+        output.append(input, clean, i - clean);
+        output.append(replacement);
+        clean = i + 1;
+    }
+    output.append(input, clean, std::string_view::npos);
+}
+
+}  // namespace sparkdown
@@ -0,0 +1,76 @@
+/**
+ * @file escape/escape.hpp
+ * @package //escape:escape
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `escape` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `escape` class,
+ *     which escapes the characters that are special to LaTeX or HTML.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef ESCAPE_HPP
+#define ESCAPE_HPP
+
+#include <string>
+#include <string_view>
+
+namespace sparkdown {
+
+/**
+ * @brief An enumeration of the contexts that text can be escaped for.
+ * @details Each context has its own table of replacements.
+ *
+ */
+enum escape_context {
+    ESCAPE_TEXT,      // Running text:
+                      //     & % $ # _ { } ~ ^ \ are made literal.
+    ESCAPE_VERBATIM,  // Inline code, in a typewriter font:
+                      //     as for text, plus < > and ".
+    ESCAPE_URL,       // The argument of `\url` or `\href`:
+                      //     % and # are escaped, and \ { } and spaces
+                      //     are percent-encoded.
+    ESCAPE_HTML,      // HTML text: & < and > become entities.
+};
+
+/**
+ * @brief Escapes text so that LaTeX, or a browser, prints it literally.
+ * @details Where SSE2 is available, `append()` checks 16 bytes at a time
+ *     for characters that need escaping, copies each run of clean bytes
+ *     in one go, and writes a precomputed replacement for each special one.
+ *     `append_scalar()` does the same one byte at a time;
+ *     it is the reference that `append()` is tested against.
+ *
+ */
+class escape {
+   public:
+    /**
+     * @brief Escapes the given text and writes it onto the end of the output.
+     *
+     * @param input The text to escape.
+     * @param context The context the text will appear in.
+     * @param output The string to write to.
+     */
+    static void append(std::string_view input, escape_context context,
+                       std::string &output);
+
+    /**
+     * @brief Escapes the given text and writes it onto the end of the output,
+     *     one byte at a time.
+     * @details Produces exactly the same output as `append()`.
+     *
+     * @param input The text to escape.
+     * @param context The context the text will appear in.
+     * @param output The string to write to.
+     */
+    static void append_scalar(std::string_view input, escape_context context,
+                              std::string &output);
+};
+
+}  // namespace sparkdown
+
+#endif
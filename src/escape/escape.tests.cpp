@@ -0,0 +1,123 @@
+/**
+ * @file escape/escape.tests.cpp
+ * @package //escape:escape.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `escape` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `escape` class,
+ *     which escapes the characters that are special to LaTeX.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunknown-pragmas"
+#pragma ide diagnostic ignored "UnusedLocalVariable"
+
+#include "escape.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "corpus/corpus.hpp"
+
+/**
+ * @brief All of the contexts.
+ *
+ */
+static const sparkdown::escape_context contexts[] = {
+    sparkdown::ESCAPE_TEXT, sparkdown::ESCAPE_VERBATIM, sparkdown::ESCAPE_URL,
+    sparkdown::ESCAPE_HTML};
+
+/**
+ * @brief Escapes the given text with both implementations,
+ *     and ensures that they agree.
+ *
+ * @param input The text to escape.
+ * @param context The context to escape for.
+ * @return The escaped text.
+ */
+static std::string escaped(std::string_view input,
+                           sparkdown::escape_context context) {
+    std::string fast = "prefix";
+    std::string scalar = "prefix";
+    sparkdown::escape::append(input, context, fast);
+    sparkdown::escape::append_scalar(input, context, scalar);
+    EXPECT_EQ(fast, scalar) << "context " << context << ": " << input;
+    return fast.substr(6);
+}
+
+/**
+ * @brief `escape#append()` text context test.
+ *
+ */
+TEST(escape, text) {
+    EXPECT_EQ(escaped("", sparkdown::ESCAPE_TEXT), "");
+    EXPECT_EQ(escaped("plain text", sparkdown::ESCAPE_TEXT), "plain text");
+    EXPECT_EQ(escaped("& % $ # _ { } ~ ^ \\", sparkdown::ESCAPE_TEXT),
+              "\\& \\% \\$ \\# \\_ \\{ \\} \\textasciitilde{} "
+              "\\textasciicircum{} \\textbackslash{}");
+    EXPECT_EQ(escaped("a<b>\"", sparkdown::ESCAPE_TEXT), "a<b>\"");
+}
+
+/**
+ * @brief `escape#append()` verbatim context test.
+ *
+ */
+TEST(escape, verbatim) {
+    EXPECT_EQ(escaped("if (a < b && c) s = \"x_y\";",
+                      sparkdown::ESCAPE_VERBATIM),
+              "if (a \\textless{} b \\&\\& c) s = "
+              "\\textquotedbl{}x\\_y\\textquotedbl{};");
+}
+
+/**
+ * @brief `escape#append()` URL context test.
+ *
+ */
+TEST(escape, url) {
+    EXPECT_EQ(escaped("https://a.b/c_d~e?f=1&g=%20#h", sparkdown::ESCAPE_URL),
+              "https://a.b/c_d~e?f=1&g=\\%20\\#h");
+    EXPECT_EQ(escaped("a b\\{c}", sparkdown::ESCAPE_URL),
+              "a\\%20b\\%5C\\%7Bc\\%7D");
+}
+
+/**
+ * @brief `escape#append()` HTML context test.
+ *
+ */
+TEST(escape, html) {
+    EXPECT_EQ(escaped("a & b <c> \"d\" $e$", sparkdown::ESCAPE_HTML),
+              "a &amp; b &lt;c&gt; \"d\" $e$");
+}
+
+/**
+ * @brief Differential test against the scalar reference.
+ * @details Escapes random text, dense with special characters,
+ *     of every length around the 16-byte chunk size,
+ *     and realistic documents.
+ *
+ */
+TEST(escape, matches_scalar) {
+    std::mt19937 random(1);
+    const std::string alphabet = "ab &%$#_{}~^\\<>\" \n\xff";
+    for (sparkdown::escape_context context : contexts) {
+        for (std::size_t size = 0; size < 100; size++) {
+            for (int trial = 0; trial < 10; trial++) {
+                std::string input;
+                for (std::size_t i = 0; i < size; i++) {
+                    input += alphabet[random() % alphabet.size()];
+                }
+                escaped(input, context);
+            }
+        }
+
+        escaped(sparkdown::corpus(1).generate(1 << 16), context);
+    }
+}
+
+#pragma clang diagnostic pop
@@ -0,0 +1,160 @@
+/**
+ * @file fuzz/complexity.fuzz.cpp
+ * @package //fuzz:complexity.fuzz
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief Fuzzer for super-linear inputs.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file is a libFuzzer target that runs each input
+ *     through the whole pipeline (lexer, parser, and emitter)
+ *     and scores it by the work done per input byte,
+ *     as counted by `compile_stats::work_per_byte()`:
+ *     the bytes scanned for regions, the tokens lexed and visited,
+ *     and the tokens and bytes emitted.
+ *
+ *     The score is fed back to libFuzzer as extra coverage,
+ *     so the fuzzer keeps any input that does more work per byte
+ *     than those it has seen, and climbs towards the worst cases.
+ *
+ *     An input is flagged as super-linear if either:
+ *
+ *         - its score is above `max_work_per_byte`; or
+ *         - repeating it `repeats` times makes the pipeline do more than
+ *           `max_growth` times as much work per byte,
+ *           and the compile ends the same way both times.
+ *
+ *     A flagged input is written to the directory named by
+ *     `$SPARKDOWN_REGRESSIONS` (by default, the working directory)
+ *     as `<content hash>._`, and the fuzzer stops.
+ *     Copy it into `//bench:regressions`
+ *     to keep it as a regression benchmark.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "compiler/compiler.hpp"
+#include "hash/hash.hpp"
+#include "stats/stats.hpp"
+
+/**
+ * @brief The most work per byte that any input may take.
+ * @details Each pattern visits each token once,
+ *     and may look a short way ahead; anything far above that
+ *     means some pattern is rescanning.
+ *
+ */
+static const double max_work_per_byte = 64;
+
+/**
+ * @brief The number of times an input is repeated to measure its growth.
+ *
+ */
+static const std::size_t repeats = 8;
+
+/**
+ * @brief The most that the work per byte may grow
+ *     when the input is repeated.
+ *
+ */
+static const double max_growth = 2;
+
+/**
+ * @brief The smallest input whose growth is measured.
+ * @details Below this, fixed costs dominate the work per byte.
+ *
+ */
+static const std::size_t min_growth_size = 16;
+
+/**
+ * @brief The work per byte of each input, in eighths, as extra coverage.
+ * @details libFuzzer treats every nonzero counter in this section
+ *     as a feature, so an input that reaches a new bucket is kept.
+ *
+ */
+__attribute__((used, section("__libfuzzer_extra_counters")))
+static std::uint8_t work_buckets[1024];
+
+/**
+ * @brief Transpiles the given input and returns the work per byte.
+ * @details An input that fails to compile (e.g., unterminated math)
+ *     is scored by the work done up to the failure,
+ *     since a rescan may come before it.
+ *
+ * @param input The Sparkdown text to transpile.
+ * @param status Set to the result of the compile.
+ * @return The work done per byte of input.
+ */
+static double score(std::string_view input,
+                    sparkdown::compile_status &status) {
+    static sparkdown::compiler compiler;
+    static std::string output;
+
+    sparkdown::compile_stats stats;
+    compiler.set_stats(&stats);
+    status = compiler.compile(input, output);
+    compiler.set_stats(nullptr);
+
+    return stats.work_per_byte();
+}
+
+/**
+ * @brief Saves the given input as a regression case and stops the fuzzer.
+ *
+ * @param input The offending input.
+ * @param reason Why the input was flagged.
+ */
+[[noreturn]] static void flag(std::string_view input,
+                              const std::string &reason) {
+    const char *dir = std::getenv("SPARKDOWN_REGRESSIONS");
+    std::string path = std::string(dir ? dir : ".") + "/" +
+                       sparkdown::hash::to_hex(sparkdown::hash::of(input)) +
+                       "._";
+    std::ofstream(path, std::ios::binary) << input;
+
+    std::cerr << "Super-linear input (" << reason << "), saved to " << path
+              << std::endl;
+    std::abort();
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t *data,
+                                      std::size_t size) {
+    std::string_view input(reinterpret_cast<const char *>(data), size);
+
+    sparkdown::compile_status status;
+    double work = score(input, status);
+    work_buckets[std::min<std::size_t>(static_cast<std::size_t>(work * 8),
+                                       sizeof(work_buckets) - 1)] = 1;
+
+    if (work > max_work_per_byte) {
+        flag(input, std::to_string(work) + " units of work per byte");
+    }
+
+    // Guards against dividing by zero.
+    if (size >= min_growth_size && work > 0) {
+        std::string repeated;
+        repeated.reserve(size * repeats);
+        for (std::size_t i = 0; i < repeats; i++) repeated += input;
+
+        // Repeating an input can close a region that it left open,
+        // so that it gets much further; only like is compared with like.
+        sparkdown::compile_status repeated_status;
+        double growth = score(repeated, repeated_status) / work;
+        if (repeated_status == status && growth > max_growth) {
+            flag(input, "work per byte grows " + std::to_string(growth) +
+                            "x when repeated " + std::to_string(repeats) +
+                            " times");
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file hash/hash.cpp
+ * @package //hash:hash
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `hash` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `hash` class,
+ *     which computes content hashes for change detection.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "hash.hpp"
+
+namespace sparkdown {
+
+std::uint64_t hash::of(std::string_view bytes, std::uint64_t seed) {
+    std::uint64_t value = seed;
+    for (char c : bytes) {
+        value ^= static_cast<unsigned char>(c);
+        value *= 0x100000001b3ULL;
+    }
+    return value;
+}
+
+std::string hash::to_hex(std::uint64_t value) {
+    static const char digits[] = "0123456789abcdef";
+
+    std::string hex(16, '0');
+    for (int i = 15; i >= 0; i--) {
+        hex[i] = digits[value & 0xf];
+        value >>= 4;
+    }
+    return hex;
+}
+
+bool hash::from_hex(std::string_view hex, std::uint64_t &value) {
+    if (hex.size() != 16) return false;
+
+    std::uint64_t result = 0;
+    for (char c : hex) {
+        result <<= 4;
+        if (c >= '0' && c <= '9') {
+            result |= c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            result |= c - 'a' + 10;
+        } else {
+            return false;
+        }
+    }
+
+    value = result;
+    return true;
+}
+
+}  // namespace sparkdown
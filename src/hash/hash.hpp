@@ -0,0 +1,64 @@
+/**
+ * @file hash/hash.hpp
+ * @package //hash:hash
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `hash` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `hash` class,
+ *     which computes content hashes for change detection.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef HASH_HPP
+#define HASH_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace sparkdown {
+
+/**
+ * @brief Computes content hashes for change detection.
+ * @details The hash is 64-bit FNV-1a. It is stable across platforms and
+ *     releases, so it may be stored on disk; it is not cryptographic.
+ *
+ */
+class hash {
+   public:
+    /**
+     * @brief Hashes the given bytes.
+     *
+     * @param bytes The bytes to hash.
+     * @param seed The hash of any preceding bytes,
+     *     so that a sequence can be hashed piece by piece.
+     * @return The hash of the bytes.
+     */
+    static std::uint64_t of(std::string_view bytes,
+                            std::uint64_t seed = 0xcbf29ce484222325ULL);
+
+    /**
+     * @brief Formats the given hash as 16 lowercase hexadecimal digits.
+     *
+     * @param value The hash to format.
+     * @return The formatted hash.
+     */
+    static std::string to_hex(std::uint64_t value);
+
+    /**
+     * @brief Parses a hash formatted by `to_hex()`.
+     *
+     * @param hex The formatted hash.
+     * @param value Receives the hash.
+     * @return True if the string was a well-formed hash.
+     */
+    static bool from_hex(std::string_view hex, std::uint64_t &value);
+};
+
+}  // namespace sparkdown
+
+#endif
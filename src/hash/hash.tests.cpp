@@ -0,0 +1,51 @@
+/**
+ * @file hash/hash.tests.cpp
+ * @package //hash:hash.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `hash` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `hash` class,
+ *     which computes content hashes for change detection.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "hash.hpp"
+
+#include <gtest/gtest.h>
+
+/**
+ * @brief `hash#of()` test.
+ * @details Checks against the published FNV-1a test vectors,
+ *     and ensures that hashing piece by piece matches hashing all at once.
+ *
+ */
+TEST(hash, of) {
+    EXPECT_EQ(sparkdown::hash::of(""), 0xcbf29ce484222325ULL);
+    EXPECT_EQ(sparkdown::hash::of("a"), 0xaf63dc4c8601ec8cULL);
+    EXPECT_EQ(sparkdown::hash::of("foobar"), 0x85944171f73967e8ULL);
+
+    EXPECT_EQ(sparkdown::hash::of("bar", sparkdown::hash::of("foo")),
+              sparkdown::hash::of("foobar"));
+}
+
+/**
+ * @brief `hash#to_hex()` and `hash#from_hex()` test.
+ *
+ */
+TEST(hash, hex_round_trip) {
+    EXPECT_EQ(sparkdown::hash::to_hex(0), "0000000000000000");
+    EXPECT_EQ(sparkdown::hash::to_hex(0x85944171f73967e8ULL),
+              "85944171f73967e8");
+
+    std::uint64_t value = 0;
+    EXPECT_TRUE(sparkdown::hash::from_hex("85944171f73967e8", value));
+    EXPECT_EQ(value, 0x85944171f73967e8ULL);
+
+    EXPECT_FALSE(sparkdown::hash::from_hex("85944171f73967e", value));
+    EXPECT_FALSE(sparkdown::hash::from_hex("85944171F73967E8", value));
+    EXPECT_FALSE(sparkdown::hash::from_hex("85944171f73967g8", value));
+}
@@ -19,20 +19,50 @@
 
 namespace sparkdown {
 
-lexer::lexer() = default;
+lexer::lexer(std::pmr::memory_resource *resource)
+    : _tokens(resource), _spare(resource) {}
 
-void lexer::lex(const std::string &str) {
-    for (char c : str) {
-        this->_tokens.emplace_back(c);
+std::pmr::memory_resource *lexer::resource() const {
+    return this->_tokens.get_allocator().resource();
+}
+
+void lexer::lex(std::string_view str) {
+    const char *next = str.data();
+    const char *end = next + str.size();
+
+    // Spare nodes are reused first; only the rest are allocated.
+    for (; next != end && !this->_spare.empty(); next++) {
+        this->_tokens.splice(this->_tokens.end(), this->_spare,
+                             this->_spare.begin());
+        this->_tokens.back() = *next;
+    }
+    for (; next != end; next++) this->_tokens.emplace_back(*next);
+}
+
+void lexer::append(token t) {
+    if (this->_spare.empty()) {
+        this->_tokens.push_back(t);
+    } else {
+        this->_tokens.splice(this->_tokens.end(), this->_spare,
+                             this->_spare.begin());
+        this->_tokens.back() = t;
     }
 }
 
-std::list<token> lexer::get_tokens() {
-    std::list<token> tokens(this->_tokens);
+token_list lexer::get_tokens() {
+    token_list tokens(this->_tokens, this->resource());
 
-    this->_tokens.clear();
+    this->recycle(this->_tokens);
 
     return tokens;
 }
 
+void lexer::get_tokens(token_list &tokens) {
+    tokens.splice(tokens.end(), this->_tokens);
+}
+
+void lexer::recycle(token_list &tokens) {
+    this->_spare.splice(this->_spare.end(), tokens);
+}
+
 }  // namespace sparkdown
@@ -16,8 +16,9 @@
 #ifndef LEXER_HPP
 #define LEXER_HPP
 
-#include <list>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
 #include "token/token.hpp"
 
@@ -36,28 +37,75 @@ class lexer {
      * @brief Contains the current sequence of tokens.
      *
      */
-    std::list<token> _tokens;
+    token_list _tokens;
+
+    /**
+     * @brief Holds list nodes that are no longer in use.
+     * @details Nodes are spliced back into `_tokens` by `lex()`
+     *     instead of being reallocated.
+     *
+     */
+    token_list _spare;
 
    public:
     /**
      * @brief Constructor.
      *
+     * @param resource The memory resource to draw the token nodes from.
+     *     The lists given to `get_tokens()` and `recycle()`
+     *     must use the same resource.
+     */
+    explicit lexer(
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    /**
+     * @brief Returns the memory resource the token nodes are drawn from.
+     *
+     * @return The memory resource.
      */
-    lexer();
+    [[nodiscard]] std::pmr::memory_resource *resource() const;
 
     /**
      * @brief Lexes the given string into a sequence of tokens.
      *
      * @param str The string to lex.
      */
-    void lex(const std::string &str);
+    void lex(std::string_view str);
+
+    /**
+     * @brief Appends a single token to the sequence.
+     * @details Used for placeholders that stand in for text
+     *     that is not lexed, such as verbatim blocks.
+     *
+     * @param t The token to append.
+     */
+    void append(token t);
 
     /**
      * @brief Returns a copy of the token sequence and flushes the buffer.
+     * @details The copy uses the lexer's memory resource.
      *
      * @return A copy of the token sequence.
      */
-    std::list<token> get_tokens();
+    token_list get_tokens();
+
+    /**
+     * @brief Moves the token sequence onto the end of the given list
+     *     and flushes the buffer.
+     * @details Unlike `get_tokens()`, no tokens are copied.
+     *
+     * @param tokens The list to receive the token sequence.
+     */
+    void get_tokens(token_list &tokens);
+
+    /**
+     * @brief Takes ownership of the nodes of the given list
+     *     so that later calls to `lex()` can reuse them.
+     * @details The given list is left empty.
+     *
+     * @param tokens The list of tokens that are no longer needed.
+     */
+    void recycle(token_list &tokens);
 };
 
 }  // namespace sparkdown
@@ -17,6 +17,12 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
 #include "token/token.hpp"
 
 /**
@@ -26,7 +32,7 @@
  */
 TEST(lexer, handles_empty_string) {
     sparkdown::lexer lexer;
-    std::list<sparkdown::token> tokens;
+    sparkdown::token_list tokens;
     EXPECT_TRUE(tokens.empty());
 
     lexer.lex("");
@@ -40,7 +46,7 @@ TEST(lexer, handles_empty_string) {
  */
 TEST(lexer, handles_simple_string) {
     sparkdown::lexer lexer;
-    std::list<sparkdown::token> tokens_list;
+    sparkdown::token_list tokens_list;
     std::vector<sparkdown::token> tokens_vec;
 
     lexer.lex("abc");
@@ -66,7 +72,7 @@ TEST(lexer, handles_simple_string) {
  */
 TEST(lexer, flushes_buffer) {
     sparkdown::lexer lexer;
-    std::list<sparkdown::token> tokens;
+    sparkdown::token_list tokens;
 
     lexer.lex("abc");
     tokens = lexer.get_tokens();
@@ -83,7 +89,7 @@ TEST(lexer, flushes_buffer) {
  */
 TEST(lexer, is_reusable) {
     sparkdown::lexer lexer;
-    std::list<sparkdown::token> tokens_list;
+    sparkdown::token_list tokens_list;
     std::vector<sparkdown::token> tokens_vec;
 
     lexer.lex("abc");
@@ -114,3 +120,93 @@ TEST(lexer, is_reusable) {
     EXPECT_EQ(tokens_vec[2].type, sparkdown::token_type::CHAR_NUMBER);
     EXPECT_EQ(tokens_vec[2].value, '3');
 }
+
+/**
+ * @brief Ensures that `lexer#get_tokens(token_list &)` moves the tokens
+ *     onto the end of the given list and flushes the buffer.
+ *
+ */
+TEST(lexer, moves_tokens) {
+    sparkdown::lexer lexer;
+    sparkdown::token_list tokens = {'x'};
+
+    lexer.lex("abc");
+    lexer.get_tokens(tokens);
+
+    sparkdown::token_list expected = {'x', 'a', 'b', 'c'};
+    EXPECT_EQ(tokens, expected);
+    EXPECT_TRUE(lexer.get_tokens().empty());
+}
+
+/**
+ * @brief Ensures that recycled nodes are reused by later calls to
+ *     `lexer#lex()`, and that they hold the newly lexed tokens.
+ *
+ */
+TEST(lexer, reuses_recycled_tokens) {
+    sparkdown::lexer lexer;
+    sparkdown::token_list tokens;
+
+    lexer.lex("a$c");
+    lexer.get_tokens(tokens);
+    const sparkdown::token *first = &tokens.front();
+
+    lexer.recycle(tokens);
+    EXPECT_TRUE(tokens.empty());
+
+    lexer.lex("1#");
+    lexer.get_tokens(tokens);
+
+    sparkdown::token_list expected = {'1', '#'};
+    EXPECT_EQ(tokens, expected);
+    EXPECT_EQ(&tokens.front(), first);
+    EXPECT_EQ(tokens.front().type, sparkdown::token_type::CHAR_NUMBER);
+}
+
+/**
+ * @brief Ensures that `lexer#append()` appends a single token
+ *     between lexed strings, reusing recycled nodes.
+ *
+ */
+TEST(lexer, appends_tokens) {
+    sparkdown::lexer lexer;
+    sparkdown::token_list tokens;
+
+    lexer.lex("ab");
+    lexer.get_tokens(tokens);
+    const sparkdown::token *first = &tokens.front();
+    lexer.recycle(tokens);
+
+    lexer.append(sparkdown::token_type::COMP_VERBATIM);
+    lexer.lex("c");
+    lexer.get_tokens(tokens);
+
+    sparkdown::token_list expected = {
+        sparkdown::token_type::COMP_VERBATIM, 'c'};
+    EXPECT_EQ(tokens, expected);
+    EXPECT_EQ(&tokens.front(), first);
+}
+
+/**
+ * @brief Ensures that the lexer draws its token nodes
+ *     from the given memory resource.
+ * @details The arena has no upstream resource,
+ *     so any allocation that misses it throws.
+ *
+ */
+TEST(lexer, uses_memory_resource) {
+    std::array<std::byte, 4096> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+                                              std::pmr::null_memory_resource());
+    sparkdown::lexer lexer(&arena);
+    EXPECT_EQ(lexer.resource(), &arena);
+
+    sparkdown::token_list tokens(&arena);
+    lexer.lex("abc");
+    lexer.get_tokens(tokens);
+
+    sparkdown::token_list expected = {'a', 'b', 'c'};
+    EXPECT_EQ(tokens, expected);
+    EXPECT_EQ(tokens.get_allocator().resource(), &arena);
+    EXPECT_EQ(lexer.get_tokens().get_allocator().resource(), &arena);
+}
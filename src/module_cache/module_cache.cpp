@@ -0,0 +1,286 @@
+/**
+ * @file module_cache/module_cache.cpp
+ * @package //module_cache:module_cache
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `module_cache` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `module_cache` class,
+ *     which transpiles Sparkdown files and the files they include,
+ *     caching the result for each file.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "module_cache.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include "hash/hash.hpp"
+#include "output/output.hpp"
+#include "sparkdown/version.hpp"
+#include "trace/trace.hpp"
+
+namespace sparkdown {
+
+/**
+ * @brief The first line of every module file in the disk cache.
+ *
+ */
+static const char *const disk_header = "sparkdown-module " SPARKDOWN_VERSION;
+
+compile_status module_cache::recorder::include(std::string_view path,
+                                               std::string &output) {
+    this->target->includes.emplace_back(output.size(), path);
+    return COMPILE_OK;
+}
+
+module_cache::module_cache(std::filesystem::path disk,
+                           std::pmr::memory_resource *resource)
+    : _compiler(resource), _disk(std::move(disk)), _parses(0), _stats(nullptr) {
+    this->_compiler.set_include_handler(&this->_recorder);
+}
+
+compile_status module_cache::compile(const std::filesystem::path &file,
+                                     std::string &output) {
+    output.clear();
+    this->_dependencies.clear();
+    this->_error_path.clear();
+
+    std::error_code error;
+    std::filesystem::path path = std::filesystem::weakly_canonical(file, error);
+    if (error) path = file;
+
+    return this->_expand(path.string(), output);
+}
+
+compile_status module_cache::compile(std::string_view input,
+                                     const std::filesystem::path &directory,
+                                     std::string &output) {
+    output.clear();
+    this->_dependencies.clear();
+    this->_error_path.clear();
+
+    module value;
+    compile_status status = this->_parse(input, value);
+    if (status != COMPILE_OK) return status;
+
+    std::error_code error;
+    std::filesystem::path base =
+        std::filesystem::weakly_canonical(directory, error);
+    if (error) base = directory;
+
+    return this->_assemble(value, base, output);
+}
+
+const std::vector<std::filesystem::path> &module_cache::dependencies() const {
+    return this->_dependencies;
+}
+
+const std::filesystem::path &module_cache::error_path() const {
+    return this->_error_path;
+}
+
+std::size_t module_cache::parses() const { return this->_parses; }
+
+void module_cache::set_stats(compile_stats *stats) {
+    this->_stats = stats;
+    this->_compiler.set_stats(stats);
+}
+
+compile_status module_cache::_parse(std::string_view input, module &result) {
+    this->_parses++;
+    result.includes.clear();
+    this->_recorder.target = &result;
+    return this->_compiler.compile(input, result.latex);
+}
+
+compile_status module_cache::_load(const std::string &path,
+                                   const module *&result) {
+    std::error_code error;
+    std::uintmax_t size = std::filesystem::file_size(path, error);
+    if (error) {
+        this->_error_path = path;
+        return COMPILE_INCLUDE_NOT_FOUND;
+    }
+    std::int64_t modified = std::filesystem::last_write_time(path, error)
+                                .time_since_epoch()
+                                .count();
+
+    auto found = this->_memory.find(path);
+    if (found != this->_memory.end() && found->second.size == size &&
+        found->second.modified == modified) {
+        result = &found->second.value;
+        return COMPILE_OK;
+    }
+
+    {
+        SPARKDOWN_TRACE_SPAN("io", "read", path);
+        phase_timer timer(this->_stats ? &this->_stats->read : nullptr);
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            this->_error_path = path;
+            return COMPILE_INCLUDE_NOT_FOUND;
+        }
+        this->_input.assign(std::istreambuf_iterator<char>(file),
+                            std::istreambuf_iterator<char>());
+    }
+    std::uint64_t content_hash = hash::of(this->_input);
+
+    if (found != this->_memory.end() && found->second.hash == content_hash) {
+        found->second.size = size;
+        found->second.modified = modified;
+        result = &found->second.value;
+        return COMPILE_OK;
+    }
+
+    SPARKDOWN_TRACE_SPAN("module_cache", "load", path);
+    module value;
+    if (!this->_read_disk(content_hash, value)) {
+        compile_status status = this->_parse(this->_input, value);
+        if (status != COMPILE_OK) {
+            this->_error_path = path;
+            return status;
+        }
+        this->_write_disk(content_hash, value);
+    }
+
+    cached_module &slot = this->_memory[path];
+    slot.size = size;
+    slot.modified = modified;
+    slot.hash = content_hash;
+    slot.value = std::move(value);
+    result = &slot.value;
+    return COMPILE_OK;
+}
+
+compile_status module_cache::_expand(const std::string &path,
+                                     std::string &output) {
+    if (std::find(this->_stack.begin(), this->_stack.end(), path) !=
+        this->_stack.end()) {
+        this->_error_path = path;
+        return COMPILE_INCLUDE_CYCLE;
+    }
+
+    const module *value = nullptr;
+    compile_status status = this->_load(path, value);
+    if (status != COMPILE_OK) return status;
+
+    this->_stack.push_back(path);
+    status = this->_assemble(
+        *value, std::filesystem::path(path).parent_path(), output);
+    this->_stack.pop_back();
+
+    return status;
+}
+
+compile_status module_cache::_assemble(const module &value,
+                                       const std::filesystem::path &directory,
+                                       std::string &output) {
+    std::size_t written = 0;
+    for (const auto &[offset, relative] : value.includes) {
+        output.append(value.latex, written, offset - written);
+        written = offset;
+
+        std::error_code error;
+        std::filesystem::path path =
+            std::filesystem::weakly_canonical(directory / relative, error);
+        if (error) path = directory / relative;
+
+        if (std::find(this->_dependencies.begin(), this->_dependencies.end(),
+                      path) == this->_dependencies.end()) {
+            this->_dependencies.push_back(path);
+        }
+
+        compile_status status = this->_expand(path.string(), output);
+        if (status != COMPILE_OK) return status;
+    }
+    output.append(value.latex, written, std::string::npos);
+
+    return COMPILE_OK;
+}
+
+bool module_cache::_read_disk(std::uint64_t content_hash,
+                              module &result) const {
+    if (this->_disk.empty()) return false;
+
+    std::filesystem::path path =
+        this->_disk / (hash::to_hex(content_hash) + ".module");
+    std::error_code error;
+    std::uintmax_t file_size = std::filesystem::file_size(path, error);
+    if (error) return false;
+
+    std::ifstream file(path, std::ios::binary);
+    // Sizes read from the file are checked against the bytes left in it,
+    // so that a truncated or corrupt module cannot cause a huge allocation.
+    auto fits = [&](std::size_t length) {
+        std::streamoff position = file.tellg();
+        if (position < 0) return false;
+        std::uintmax_t read = static_cast<std::uintmax_t>(position);
+        return read <= file_size && length <= file_size - read;
+    };
+
+    std::string line;
+    if (!std::getline(file, line) || line != disk_header) return false;
+
+    // The header is followed by the size of the LaTeX code
+    // and the number of includes, then the LaTeX code itself,
+    // then the offset, path size, and path of each include.
+    std::size_t size = 0;
+    std::size_t count = 0;
+    if (!(file >> size >> count) || file.get() != '\n' || !fits(size)) {
+        return false;
+    }
+
+    result.latex.resize(size);
+    if (!file.read(result.latex.data(), static_cast<std::streamsize>(size))) {
+        return false;
+    }
+
+    result.includes.clear();
+    std::size_t previous = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        std::size_t offset = 0;
+        std::size_t length = 0;
+        if (!(file >> offset >> length) || file.get() != '\n' ||
+            offset < previous || offset > size || !fits(length)) {
+            return false;
+        }
+        previous = offset;
+
+        std::string include(length, '\0');
+        if (!file.read(include.data(), static_cast<std::streamsize>(length))) {
+            return false;
+        }
+        result.includes.emplace_back(offset, std::move(include));
+    }
+
+    return true;
+}
+
+void module_cache::_write_disk(std::uint64_t content_hash,
+                               const module &value) const {
+    if (this->_disk.empty()) return;
+
+    std::ostringstream contents;
+    contents << disk_header << '\n'
+             << value.latex.size() << ' ' << value.includes.size() << '\n'
+             << value.latex;
+    for (const auto &[offset, path] : value.includes) {
+        contents << offset << ' ' << path.size() << '\n' << path;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(this->_disk, error);
+    output::write(this->_disk / (hash::to_hex(content_hash) + ".module"),
+                  contents.str());
+}
+
+}  // namespace sparkdown
@@ -0,0 +1,302 @@
+/**
+ * @file module_cache/module_cache.hpp
+ * @package //module_cache:module_cache
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `module_cache` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `module_cache` class,
+ *     which transpiles Sparkdown files and the files they include,
+ *     caching the result for each file.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef MODULE_CACHE_HPP
+#define MODULE_CACHE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "compiler/compiler.hpp"
+
+namespace sparkdown {
+
+/**
+ * @brief Transpiles Sparkdown files, expanding their include directives,
+ *     and caches the result for each file.
+ * @details Each file is compiled on its own into a "module":
+ *     its LaTeX code, with the positions and paths of its include directives
+ *     left unexpanded. The modules are then stitched together.
+ *     So when one included file is edited,
+ *     only that file has to be parsed again.
+ *
+ *     Modules are cached in memory for the lifetime of the `module_cache`,
+ *     keyed by file path and checked against the file's size,
+ *     modification time, and content hash.
+ *     If a cache directory is given, modules are also stored on disk,
+ *     keyed by content hash, so that they survive between runs.
+ *
+ *     Include paths are relative to the directory of the including file.
+ *     A file that includes itself, perhaps through other files,
+ *     fails with `COMPILE_INCLUDE_CYCLE`.
+ *
+ *     A `module_cache` is not thread-safe;
+ *     use one instance per thread.
+ *
+ */
+class module_cache {
+   private:
+    /**
+     * @brief The LaTeX code of a single file, with its includes unexpanded.
+     *
+     */
+    struct module {
+        /**
+         * @brief The LaTeX code of the file, without its includes.
+         *
+         */
+        std::string latex;
+
+        /**
+         * @brief The include directives of the file, in order,
+         *     as offsets into `latex` and paths as written.
+         *
+         */
+        std::vector<std::pair<std::size_t, std::string>> includes;
+    };
+
+    /**
+     * @brief A module in the memory cache,
+     *     with the details of the file it was compiled from.
+     *
+     */
+    struct cached_module {
+        std::uintmax_t size = 0;
+        std::int64_t modified = 0;
+        std::uint64_t hash = 0;
+        module value;
+    };
+
+    /**
+     * @brief Records include directives into a module
+     *     instead of expanding them.
+     *
+     */
+    class recorder : public include_handler {
+       public:
+        /**
+         * @brief The module being compiled.
+         *
+         */
+        module *target = nullptr;
+
+        compile_status include(std::string_view path,
+                               std::string &output) override;
+    };
+
+    /**
+     * @brief The compiler used to compile each module.
+     *
+     */
+    compiler _compiler;
+
+    /**
+     * @brief The include handler given to `_compiler`.
+     *
+     */
+    recorder _recorder;
+
+    /**
+     * @brief The directory of the disk cache. May be empty.
+     *
+     */
+    std::filesystem::path _disk;
+
+    /**
+     * @brief The memory cache, keyed by canonical file path.
+     *
+     */
+    std::map<std::string, cached_module> _memory;
+
+    /**
+     * @brief Holds the contents of the file being loaded.
+     *
+     */
+    std::string _input;
+
+    /**
+     * @brief The files currently being expanded, outermost first.
+     *
+     */
+    std::vector<std::string> _stack;
+
+    /**
+     * @brief The files included by the last compilation.
+     *
+     */
+    std::vector<std::filesystem::path> _dependencies;
+
+    /**
+     * @brief The file that caused the last failure.
+     *
+     */
+    std::filesystem::path _error_path;
+
+    /**
+     * @brief The number of files parsed so far.
+     *
+     */
+    std::size_t _parses;
+
+    /**
+     * @brief Receives the statistics of each compilation. May be null.
+     *
+     */
+    compile_stats *_stats;
+
+    /**
+     * @brief Compiles the given input into a module.
+     *
+     * @param input The Sparkdown text to compile.
+     * @param result Receives the module.
+     * @return `COMPILE_OK` on success; otherwise, the reason for failure.
+     */
+    compile_status _parse(std::string_view input, module &result);
+
+    /**
+     * @brief Loads the module of the given file,
+     *     from the memory cache, the disk cache, or by compiling it.
+     *
+     * @param path The canonical path of the file.
+     * @param result Receives a pointer to the module.
+     * @return `COMPILE_OK` on success; otherwise, the reason for failure.
+     */
+    compile_status _load(const std::string &path, const module *&result);
+
+    /**
+     * @brief Writes the LaTeX code of the given file,
+     *     with its includes expanded, onto the end of the output.
+     *
+     * @param path The canonical path of the file.
+     * @param output The string to write to.
+     * @return `COMPILE_OK` on success; otherwise, the reason for failure.
+     */
+    compile_status _expand(const std::string &path, std::string &output);
+
+    /**
+     * @brief Writes the given module, with its includes expanded,
+     *     onto the end of the output.
+     *
+     * @param value The module to write.
+     * @param directory The directory to resolve include paths against.
+     * @param output The string to write to.
+     * @return `COMPILE_OK` on success; otherwise, the reason for failure.
+     */
+    compile_status _assemble(const module &value,
+                             const std::filesystem::path &directory,
+                             std::string &output);
+
+    /**
+     * @brief Reads a module from the disk cache.
+     *
+     * @param hash The content hash of the file.
+     * @param result Receives the module.
+     * @return True if the module was found.
+     */
+    bool _read_disk(std::uint64_t hash, module &result) const;
+
+    /**
+     * @brief Writes a module to the disk cache.
+     *
+     * @param hash The content hash of the file.
+     * @param value The module to write.
+     */
+    void _write_disk(std::uint64_t hash, const module &value) const;
+
+   public:
+    /**
+     * @brief Constructor.
+     *
+     * @param disk The directory of the disk cache.
+     *     Leave empty to cache in memory only.
+     * @param resource The memory resource to draw the compiler's
+     *     token buffers from. It must outlive the cache.
+     */
+    explicit module_cache(
+        std::filesystem::path disk = {},
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    module_cache(const module_cache &) = delete;
+    module_cache &operator=(const module_cache &) = delete;
+
+    /**
+     * @brief Sets the statistics that each compilation adds to.
+     * @details Records the reading of files, as well as everything
+     *     recorded by `compiler::set_stats()`.
+     *     Files found in the memory cache are neither read nor compiled,
+     *     so they add nothing.
+     *
+     * @param stats The statistics, or null to stop recording.
+     */
+    void set_stats(compile_stats *stats);
+
+    /**
+     * @brief Transpiles the given file, expanding its includes.
+     *
+     * @param file The Sparkdown file to transpile.
+     * @param output The buffer to write the LaTeX code to.
+     * @return `COMPILE_OK` on success; otherwise, the reason for failure.
+     */
+    compile_status compile(const std::filesystem::path &file,
+                           std::string &output);
+
+    /**
+     * @brief Transpiles the given Sparkdown text, expanding its includes.
+     * @details The text itself is not cached.
+     *
+     * @param input The Sparkdown text to transpile.
+     * @param directory The directory to resolve include paths against.
+     * @param output The buffer to write the LaTeX code to.
+     * @return `COMPILE_OK` on success; otherwise, the reason for failure.
+     */
+    compile_status compile(std::string_view input,
+                           const std::filesystem::path &directory,
+                           std::string &output);
+
+    /**
+     * @brief Returns the files included by the last compilation,
+     *     directly or indirectly.
+     *
+     * @return The canonical paths of the included files.
+     */
+    [[nodiscard]] const std::vector<std::filesystem::path> &dependencies()
+        const;
+
+    /**
+     * @brief Returns the file that caused the last failure.
+     *
+     * @return The path of the file.
+     */
+    [[nodiscard]] const std::filesystem::path &error_path() const;
+
+    /**
+     * @brief Returns the number of files that have been parsed,
+     *     as opposed to being found in a cache.
+     *
+     * @return The number of files parsed.
+     */
+    [[nodiscard]] std::size_t parses() const;
+};
+
+}  // namespace sparkdown
+
+#endif
@@ -0,0 +1,183 @@
+/**
+ * @file module_cache/module_cache.tests.cpp
+ * @package //module_cache:module_cache.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `module_cache` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `module_cache` class,
+ *     which transpiles Sparkdown files and the files they include,
+ *     caching the result for each file.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "module_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include "scratch/scratch.hpp"
+
+/**
+ * @brief `module_cache#compile()` test.
+ * @details Ensures that includes are expanded, recursively,
+ *     relative to the directory of the including file.
+ *
+ */
+TEST(module_cache, expands_includes) {
+    std::filesystem::path dir =
+        sparkdown::scratch::directory("module-cache-expand");
+    sparkdown::scratch::write_file(dir / "main._",
+                                   "start\n$include: ch/one._\nend");
+    sparkdown::scratch::write_file(dir / "ch" / "one._",
+                                   "one\n$include: two._");
+    sparkdown::scratch::write_file(dir / "ch" / "two._", "two");
+
+    sparkdown::module_cache cache;
+    std::string output;
+    EXPECT_EQ(cache.compile(dir / "main._", output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(output, "start\none\ntwo\nend");
+    EXPECT_EQ(cache.dependencies().size(), 2);
+
+    EXPECT_EQ(cache.compile("top\n$include: main._", dir, output),
+              sparkdown::COMPILE_OK);
+    EXPECT_EQ(output, "top\nstart\none\ntwo\nend");
+
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief `module_cache#compile()` caching test.
+ * @details Ensures that only the edited file is parsed again.
+ *
+ */
+TEST(module_cache, reparses_only_changed_files) {
+    std::filesystem::path dir =
+        sparkdown::scratch::directory("module-cache-changed");
+    sparkdown::scratch::write_file(dir / "main._",
+                                   "$include: a._\n$include: b._");
+    sparkdown::scratch::write_file(dir / "a._", "alpha");
+    sparkdown::scratch::write_file(dir / "b._", "beta");
+
+    sparkdown::module_cache cache;
+    std::string output;
+    EXPECT_EQ(cache.compile(dir / "main._", output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(cache.parses(), 3);
+
+    EXPECT_EQ(cache.compile(dir / "main._", output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(cache.parses(), 3);
+
+    sparkdown::scratch::write_file(dir / "b._", "BETA, edited");
+    EXPECT_EQ(cache.compile(dir / "main._", output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(output, "alpha\nBETA, edited");
+    EXPECT_EQ(cache.parses(), 4);
+
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief `module_cache#compile()` disk cache test.
+ * @details Ensures that a new cache finds the modules on disk.
+ *
+ */
+TEST(module_cache, reuses_disk_cache) {
+    std::filesystem::path dir =
+        sparkdown::scratch::directory("module-cache-disk");
+    sparkdown::scratch::write_file(dir / "main._", "x\n$include: a._\ny");
+    sparkdown::scratch::write_file(dir / "a._", "alpha");
+
+    std::string first;
+    {
+        sparkdown::module_cache cache(dir / "cache");
+        EXPECT_EQ(cache.compile(dir / "main._", first), sparkdown::COMPILE_OK);
+        EXPECT_EQ(cache.parses(), 2);
+    }
+
+    sparkdown::module_cache cache(dir / "cache");
+    std::string second;
+    EXPECT_EQ(cache.compile(dir / "main._", second), sparkdown::COMPILE_OK);
+    EXPECT_EQ(cache.parses(), 0);
+    EXPECT_EQ(second, first);
+
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief `module_cache#compile()` corrupt disk cache test.
+ * @details Ensures that modules on disk whose sizes do not fit the file,
+ *     whether overstated or cut short, are parsed again.
+ *
+ */
+TEST(module_cache, rejects_corrupt_disk_cache) {
+    std::filesystem::path dir =
+        sparkdown::scratch::directory("module-cache-corrupt");
+    sparkdown::scratch::write_file(dir / "main._", "x\n$include: a._\ny");
+    sparkdown::scratch::write_file(dir / "a._", "alpha");
+    std::filesystem::path disk = dir / "cache";
+
+    std::string expected;
+    {
+        sparkdown::module_cache cache(disk);
+        EXPECT_EQ(cache.compile(dir / "main._", expected),
+                  sparkdown::COMPILE_OK);
+    }
+
+    // Overstates the size of the LaTeX code of every module.
+    for (const auto &entry : std::filesystem::directory_iterator(disk)) {
+        std::string contents = sparkdown::scratch::read_file(entry.path());
+        std::size_t line = contents.find('\n') + 1;
+        contents.replace(line, contents.find(' ', line) - line,
+                         "1000000000000000");
+        sparkdown::scratch::write_file(entry.path(), contents);
+    }
+    {
+        sparkdown::module_cache cache(disk);
+        std::string output;
+        EXPECT_EQ(cache.compile(dir / "main._", output), sparkdown::COMPILE_OK);
+        EXPECT_EQ(cache.parses(), 2);
+        EXPECT_EQ(output, expected);
+    }
+
+    // Cuts every module short.
+    for (const auto &entry : std::filesystem::directory_iterator(disk)) {
+        std::filesystem::resize_file(entry.path(), entry.file_size() - 2);
+    }
+    sparkdown::module_cache cache(disk);
+    std::string output;
+    EXPECT_EQ(cache.compile(dir / "main._", output), sparkdown::COMPILE_OK);
+    EXPECT_EQ(cache.parses(), 2);
+    EXPECT_EQ(output, expected);
+
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief `module_cache#compile()` error test.
+ * @details Ensures that include cycles and missing files are reported,
+ *     along with the file that caused them.
+ *
+ */
+TEST(module_cache, reports_errors) {
+    std::filesystem::path dir =
+        sparkdown::scratch::directory("module-cache-errors");
+    sparkdown::scratch::write_file(dir / "self._", "$include: self._");
+    sparkdown::scratch::write_file(dir / "a._", "$include: b._");
+    sparkdown::scratch::write_file(dir / "b._", "$include: a._");
+    sparkdown::scratch::write_file(dir / "missing._", "$include: nowhere._");
+
+    sparkdown::module_cache cache;
+    std::string output;
+    EXPECT_EQ(cache.compile(dir / "self._", output),
+              sparkdown::COMPILE_INCLUDE_CYCLE);
+    EXPECT_EQ(cache.compile(dir / "a._", output),
+              sparkdown::COMPILE_INCLUDE_CYCLE);
+    EXPECT_EQ(cache.error_path().filename(), "a._");
+
+    EXPECT_EQ(cache.compile(dir / "missing._", output),
+              sparkdown::COMPILE_INCLUDE_NOT_FOUND);
+    EXPECT_EQ(cache.error_path().filename(), "nowhere._");
+
+    std::filesystem::remove_all(dir);
+}
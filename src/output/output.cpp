@@ -0,0 +1,144 @@
+/**
+ * @file output/output.cpp
+ * @package //output:output
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `output` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `output` class,
+ *     which writes generated files to disk.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "output.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "trace/trace.hpp"
+
+namespace sparkdown {
+
+bool output::matches(const std::filesystem::path &path,
+                     std::string_view contents) {
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(path, error)) return false;
+    if (std::filesystem::file_size(path, error) != contents.size() || error) {
+        return false;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    char buffer[1 << 16];
+    std::size_t offset = 0;
+    while (offset < contents.size()) {
+        std::size_t count = std::min(sizeof(buffer), contents.size() - offset);
+        if (!file.read(buffer, static_cast<std::streamsize>(count))) {
+            return false;
+        }
+        if (std::memcmp(buffer, contents.data() + offset, count) != 0) {
+            return false;
+        }
+        offset += count;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Writes the whole of the given contents to the given descriptor.
+ *
+ * @param descriptor The open file descriptor to write to.
+ * @param contents The contents to write.
+ * @return True if every byte was written.
+ */
+static bool write_all(int descriptor, std::string_view contents) {
+    while (!contents.empty()) {
+        ssize_t count = ::write(descriptor, contents.data(), contents.size());
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        contents.remove_prefix(static_cast<std::size_t>(count));
+    }
+    return true;
+}
+
+std::filesystem::path output::temporary(const std::filesystem::path &path) {
+    static std::atomic<unsigned> counter = 0;
+    std::filesystem::path result = path;
+    result += "." + std::to_string(getpid()) + "." +
+              std::to_string(counter++) + ".tmp";
+    return result;
+}
+
+write_result output::write(const std::filesystem::path &path,
+                           std::string_view contents) {
+    SPARKDOWN_TRACE_SPAN("io", "write", path.native());
+    if (matches(path, contents)) return WRITE_UNCHANGED;
+
+    // Devices, pipes, and the like cannot be replaced by a rename,
+    // so they are written to directly.
+    struct stat existing {};
+    bool exists = ::stat(path.c_str(), &existing) == 0;
+    if (exists && !S_ISREG(existing.st_mode)) {
+        int descriptor = ::open(path.c_str(), O_WRONLY | O_CLOEXEC);
+        if (descriptor < 0) return WRITE_FAILED;
+        bool written = write_all(descriptor, contents);
+        return ::close(descriptor) == 0 && written ? WRITE_CHANGED
+                                                    : WRITE_FAILED;
+    }
+
+    // Renaming over a symlink would replace the link itself,
+    // so the file it points to is the one that gets replaced,
+    // even when that file does not exist yet.
+    std::error_code error;
+    std::filesystem::path target = path;
+    for (int links = 0;
+         links < 40 && std::filesystem::is_symlink(target, error); ++links) {
+        std::filesystem::path link = std::filesystem::read_symlink(target,
+                                                                   error);
+        if (error) return WRITE_FAILED;
+        target = target.parent_path() / link;
+    }
+    target = std::filesystem::weakly_canonical(target, error);
+    if (error) return WRITE_FAILED;
+
+    std::filesystem::path temporary = output::temporary(target);
+
+    int descriptor = ::open(temporary.c_str(),
+                            O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+    if (descriptor < 0) return WRITE_FAILED;
+
+    // The replacement keeps the permissions of the file it replaces,
+    // and its contents reach the disk before the rename makes it visible.
+    bool written = write_all(descriptor, contents) &&
+                   (!exists ||
+                    ::fchmod(descriptor, existing.st_mode & 07777) == 0) &&
+                   ::fsync(descriptor) == 0;
+    if (::close(descriptor) != 0) written = false;
+
+    if (written) std::filesystem::rename(temporary, target, error);
+    if (!written || error) {
+        std::filesystem::remove(temporary, error);
+        return WRITE_FAILED;
+    }
+
+    return WRITE_CHANGED;
+}
+
+}  // namespace sparkdown
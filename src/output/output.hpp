@@ -0,0 +1,89 @@
+/**
+ * @file output/output.hpp
+ * @package //output:output
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `output` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `output` class,
+ *     which writes generated files to disk.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef OUTPUT_HPP
+#define OUTPUT_HPP
+
+#include <filesystem>
+#include <string_view>
+
+namespace sparkdown {
+
+/**
+ * @brief An enumeration of the possible results of writing a file.
+ *
+ */
+enum write_result {
+    WRITE_CHANGED,    // The file was created or its contents were replaced.
+    WRITE_UNCHANGED,  // The file already held the same contents.
+    WRITE_FAILED,     // The file could not be written.
+};
+
+/**
+ * @brief Writes generated files to disk.
+ * @details Tools watching the output (e.g., `latexmk`) rebuild whenever
+ *     a file is rewritten, even when its contents are the same;
+ *     so files whose contents have not changed are left untouched.
+ *
+ *     Files that have changed are written to a temporary file
+ *     in the same directory, which is then renamed over the destination,
+ *     so readers never see a partially-written file.
+ *     The temporary file takes the permissions of the file it replaces,
+ *     and is synced to disk before the rename.
+ *     Symlinks are followed, so the file they point to is the one replaced;
+ *     destinations that are not regular files (e.g., `/dev/stdout`)
+ *     are written to directly.
+ *
+ */
+class output {
+   public:
+    /**
+     * @brief Reports whether the given file holds exactly the given contents.
+     * @details The file sizes are compared first;
+     *     the contents are only read when the sizes match.
+     *
+     * @param path The file to compare.
+     * @param contents The contents to compare against.
+     * @return True if the file exists and holds exactly the given contents.
+     */
+    static bool matches(const std::filesystem::path &path,
+                        std::string_view contents);
+
+    /**
+     * @brief Returns a name for a temporary file beside the given file.
+     * @details The name is unique to this process and this call,
+     *     and is in the same directory as the file,
+     *     so that renaming it over the file does not cross filesystems.
+     *
+     * @param path The file that the temporary file will replace.
+     * @return The path to the temporary file.
+     */
+    static std::filesystem::path temporary(const std::filesystem::path &path);
+
+    /**
+     * @brief Atomically writes the given contents to the given file,
+     *     unless the file already holds them.
+     *
+     * @param path The file to write.
+     * @param contents The contents to write.
+     * @return Whether the file was changed, was unchanged, or failed.
+     */
+    static write_result write(const std::filesystem::path &path,
+                              std::string_view contents);
+};
+
+}  // namespace sparkdown
+
+#endif
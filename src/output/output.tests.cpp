@@ -0,0 +1,166 @@
+/**
+ * @file output/output.tests.cpp
+ * @package //output:output.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `output` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `output` class,
+ *     which writes generated files to disk.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "output.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iterator>
+#include <string>
+
+#include "scratch/scratch.hpp"
+
+/**
+ * @brief `output#write()` test.
+ * @details Ensures that a new file is created,
+ *     and that rewriting the same contents leaves it untouched.
+ *
+ */
+TEST(output, skips_identical_contents) {
+    std::filesystem::path dir =
+        sparkdown::scratch::directory("output-identical");
+    std::filesystem::path file = dir / "out.tex";
+
+    EXPECT_EQ(sparkdown::output::write(file, "abc"), sparkdown::WRITE_CHANGED);
+    EXPECT_EQ(sparkdown::scratch::read_file(file), "abc");
+
+    auto modified = std::filesystem::last_write_time(file);
+    std::filesystem::last_write_time(file, modified - std::chrono::hours(1));
+    modified = std::filesystem::last_write_time(file);
+
+    EXPECT_EQ(sparkdown::output::write(file, "abc"),
+              sparkdown::WRITE_UNCHANGED);
+    EXPECT_EQ(std::filesystem::last_write_time(file), modified);
+
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief `output#write()` test.
+ * @details Ensures that changed contents are written,
+ *     whether or not the size changes,
+ *     and that no temporary files are left behind.
+ *
+ */
+TEST(output, replaces_changed_contents) {
+    std::filesystem::path dir = sparkdown::scratch::directory("output-changed");
+    std::filesystem::path file = dir / "out.tex";
+
+    EXPECT_EQ(sparkdown::output::write(file, "abc"), sparkdown::WRITE_CHANGED);
+    EXPECT_EQ(sparkdown::output::write(file, "abd"), sparkdown::WRITE_CHANGED);
+    EXPECT_EQ(sparkdown::scratch::read_file(file), "abd");
+    EXPECT_EQ(sparkdown::output::write(file, "abcdef"),
+              sparkdown::WRITE_CHANGED);
+    EXPECT_EQ(sparkdown::scratch::read_file(file), "abcdef");
+    EXPECT_EQ(sparkdown::output::write(file, ""), sparkdown::WRITE_CHANGED);
+    EXPECT_EQ(sparkdown::scratch::read_file(file), "");
+
+    auto entries = std::distance(std::filesystem::directory_iterator(dir),
+                                 std::filesystem::directory_iterator());
+    EXPECT_EQ(entries, 1);
+
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief `output#write()` symlink test.
+ * @details Ensures that a symlinked destination keeps its link,
+ *     and that the file it points to is the one replaced.
+ *
+ */
+TEST(output, follows_symlinks) {
+    std::filesystem::path dir = sparkdown::scratch::directory("output-symlink");
+    std::filesystem::path file = dir / "out.tex";
+    std::filesystem::path link = dir / "link.tex";
+    std::filesystem::create_symlink(file, link);
+
+    EXPECT_EQ(sparkdown::output::write(link, "abc"), sparkdown::WRITE_CHANGED);
+    EXPECT_EQ(sparkdown::output::write(link, "abd"), sparkdown::WRITE_CHANGED);
+    EXPECT_TRUE(std::filesystem::is_symlink(link));
+    EXPECT_EQ(sparkdown::scratch::read_file(file), "abd");
+    EXPECT_EQ(sparkdown::output::write(link, "abd"),
+              sparkdown::WRITE_UNCHANGED);
+
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief `output#write()` permissions test.
+ * @details Ensures that a replaced file keeps its permissions.
+ *
+ */
+TEST(output, keeps_permissions) {
+    std::filesystem::path dir =
+        sparkdown::scratch::directory("output-permissions");
+    std::filesystem::path file = dir / "out.tex";
+    const auto mode = std::filesystem::perms::owner_read |
+                      std::filesystem::perms::owner_write |
+                      std::filesystem::perms::owner_exec;
+
+    EXPECT_EQ(sparkdown::output::write(file, "abc"), sparkdown::WRITE_CHANGED);
+    std::filesystem::permissions(file, mode);
+    EXPECT_EQ(sparkdown::output::write(file, "abd"), sparkdown::WRITE_CHANGED);
+    EXPECT_EQ(std::filesystem::status(file).permissions(), mode);
+
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief `output#write()` device test.
+ * @details Ensures that a destination that is not a regular file
+ *     is written to directly, rather than replaced.
+ *
+ */
+TEST(output, writes_devices_directly) {
+    EXPECT_EQ(sparkdown::output::write("/dev/null", "abc"),
+              sparkdown::WRITE_CHANGED);
+    EXPECT_TRUE(std::filesystem::is_character_file("/dev/null"));
+}
+
+/**
+ * @brief `output#matches()` test.
+ *
+ */
+TEST(output, matches) {
+    std::filesystem::path dir = sparkdown::scratch::directory("output-matches");
+    std::filesystem::path file = dir / "out.tex";
+
+    EXPECT_FALSE(sparkdown::output::matches(file, ""));
+
+    std::string large(200000, 'x');
+    sparkdown::output::write(file, large);
+    EXPECT_TRUE(sparkdown::output::matches(file, large));
+
+    large.back() = 'y';
+    EXPECT_FALSE(sparkdown::output::matches(file, large));
+    EXPECT_FALSE(sparkdown::output::matches(dir, ""));
+
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief `output#write()` failure test.
+ * @details Ensures that a failed write is reported.
+ *
+ */
+TEST(output, reports_failure) {
+    std::filesystem::path dir = sparkdown::scratch::directory("output-failure");
+
+    EXPECT_EQ(sparkdown::output::write(dir / "missing" / "out.tex", "abc"),
+              sparkdown::WRITE_FAILED);
+
+    std::filesystem::remove_all(dir);
+}
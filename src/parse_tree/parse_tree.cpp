@@ -0,0 +1,217 @@
+/**
+ * @file parse_tree/parse_tree.cpp
+ * @package //parse_tree:parse_tree
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `parse_tree` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `parse_tree` class,
+ *     which maps a saved parse tree into memory
+ *     and replays it into emitters.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "parse_tree.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <utility>
+
+#include "trace/trace.hpp"
+
+namespace sparkdown {
+
+const tree_header &parse_tree::_header() const {
+    return *reinterpret_cast<const tree_header *>(this->_data);
+}
+
+parse_tree::parse_tree() : _data(nullptr), _size(0) {}
+
+parse_tree::~parse_tree() { this->close(); }
+
+parse_tree::parse_tree(parse_tree &&other) noexcept
+    : _data(std::exchange(other._data, nullptr)),
+      _size(std::exchange(other._size, 0)) {}
+
+parse_tree &parse_tree::operator=(parse_tree &&other) noexcept {
+    if (this != &other) {
+        this->close();
+        this->_data = std::exchange(other._data, nullptr);
+        this->_size = std::exchange(other._size, 0);
+    }
+    return *this;
+}
+
+bool parse_tree::open(const std::filesystem::path &path,
+                      std::uint64_t input_hash) {
+    SPARKDOWN_TRACE_SPAN("parse_tree", "open");
+    this->close();
+
+    int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0) return false;
+    struct stat status {};
+    void *data = MAP_FAILED;
+    if (fstat(file, &status) == 0 &&
+        static_cast<std::size_t>(status.st_size) >= sizeof(tree_header)) {
+        data = mmap(nullptr, static_cast<std::size_t>(status.st_size),
+                    PROT_READ, MAP_PRIVATE, file, 0);
+    }
+    // The mapping holds its own reference to the file.
+    ::close(file);
+    if (data == MAP_FAILED) return false;
+    this->_data = static_cast<const char *>(data);
+    this->_size = static_cast<std::size_t>(status.st_size);
+
+    // The version is padded with null characters.
+    char version[sizeof(tree_header::version)] = {};
+    std::memcpy(version, SPARKDOWN_VERSION, sizeof(SPARKDOWN_VERSION));
+
+    const tree_header &header = this->_header();
+    std::size_t space = this->_size - sizeof(tree_header);
+    bool valid = std::memcmp(header.magic, "sparkdwn", 8) == 0 &&
+                 header.format == tree_format &&
+                 header.byte_order == tree_byte_order &&
+                 header.input_hash == input_hash &&
+                 std::memcmp(header.version, version, sizeof(version)) == 0 &&
+                 header.node_count <= space / sizeof(tree_node) &&
+                 header.text_size ==
+                     space - header.node_count * sizeof(tree_node);
+    if (!valid) this->close();
+    return valid;
+}
+
+void parse_tree::close() {
+    if (!this->_data) return;
+    munmap(const_cast<char *>(this->_data), this->_size);
+    this->_data = nullptr;
+    this->_size = 0;
+}
+
+bool parse_tree::is_open() const { return this->_data != nullptr; }
+
+std::size_t parse_tree::node_count() const {
+    return this->_data ? this->_header().node_count : 0;
+}
+
+compile_status parse_tree::emit(const std::vector<emitter *> &emitters,
+                                include_handler *handler) const {
+    SPARKDOWN_TRACE_SPAN("parse_tree", "emit");
+    for (emitter *e : emitters) e->clear();
+    if (!this->_data) return COMPILE_DAMAGED_TREE;
+
+    const tree_header &header = this->_header();
+    const auto *nodes =
+        reinterpret_cast<const tree_node *>(this->_data + sizeof(tree_header));
+    const auto *text =
+        reinterpret_cast<const char *>(nodes + header.node_count);
+
+    for (std::uint64_t n = 0; n < header.node_count; n++) {
+        const tree_node &node = nodes[n];
+        if (node.offset > header.text_size ||
+            node.size > header.text_size - node.offset) {
+            return COMPILE_DAMAGED_TREE;
+        }
+        std::string_view value(text + node.offset, node.size);
+
+        switch (node.type) {
+            case NODE_TEXT:
+                for (emitter *e : emitters) e->text(value);
+                break;
+            case NODE_VERBATIM:
+                for (emitter *e : emitters) e->verbatim(value);
+                break;
+            case NODE_MATH:
+                for (emitter *e : emitters) e->math(value);
+                break;
+            case NODE_INCLUDE:
+                for (emitter *e : emitters) {
+                    if (e->include(value)) continue;
+                    if (!handler) return COMPILE_INCLUDE_UNSUPPORTED;
+                    compile_status status =
+                        handler->include(value, e->output());
+                    if (status != COMPILE_OK) return status;
+                }
+                break;
+            case NODE_HEAD: {
+                if (node.argument > HEAD_DATE) return COMPILE_DAMAGED_TREE;
+                auto field = static_cast<head_field>(node.argument);
+                for (emitter *e : emitters) e->head(field, value);
+                break;
+            }
+            case NODE_BEGIN_HEADING:
+            case NODE_END_HEADING: {
+                if (node.argument > 3) return COMPILE_DAMAGED_TREE;
+                int level = static_cast<int>(node.argument);
+                for (emitter *e : emitters) {
+                    if (node.type == NODE_BEGIN_HEADING) {
+                        e->begin_heading(level);
+                    } else {
+                        e->end_heading(level);
+                    }
+                }
+                break;
+            }
+            case NODE_BEGIN_LIST:
+            case NODE_END_LIST: {
+                if (node.argument > LIST_ENUMERATE) return COMPILE_DAMAGED_TREE;
+                auto type = static_cast<list_type>(node.argument);
+                for (emitter *e : emitters) {
+                    if (node.type == NODE_BEGIN_LIST) {
+                        e->begin_list(type);
+                    } else {
+                        e->end_list(type);
+                    }
+                }
+                break;
+            }
+            case NODE_ITEM:
+                for (emitter *e : emitters) e->item();
+                break;
+            case NODE_ARROW:
+                for (emitter *e : emitters) e->arrow();
+                break;
+            case NODE_PIPE:
+                for (emitter *e : emitters) e->pipe();
+                break;
+            case NODE_BEGIN_TABLE:
+                if (value.find_first_not_of("lcr") != std::string_view::npos) {
+                    return COMPILE_DAMAGED_TREE;
+                }
+                for (emitter *e : emitters) e->begin_table(value);
+                break;
+            case NODE_BEGIN_ROW:
+            case NODE_NEXT_CELL:
+            case NODE_END_ROW: {
+                if (node.argument > 1) return COMPILE_DAMAGED_TREE;
+                bool header = node.argument == 1;
+                for (emitter *e : emitters) {
+                    if (node.type == NODE_BEGIN_ROW) {
+                        e->begin_row(header);
+                    } else if (node.type == NODE_NEXT_CELL) {
+                        e->next_cell(header);
+                    } else {
+                        e->end_row(header);
+                    }
+                }
+                break;
+            }
+            case NODE_END_TABLE:
+                for (emitter *e : emitters) e->end_table();
+                break;
+            default:
+                return COMPILE_DAMAGED_TREE;
+        }
+    }
+    return COMPILE_OK;
+}
+
+}  // namespace sparkdown
@@ -0,0 +1,280 @@
+/**
+ * @file parse_tree/parse_tree.hpp
+ * @package //parse_tree:parse_tree
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `parse_tree` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the binary format of a saved parse tree,
+ *     and the `parse_tree` class, which maps a saved tree into memory
+ *     and replays it into emitters.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef PARSE_TREE_HPP
+#define PARSE_TREE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+#include "compiler/compiler.hpp"
+#include "emitter/emitter.hpp"
+#include "sparkdown/version.hpp"
+
+namespace sparkdown {
+
+/**
+ * @brief The version of the parse tree format.
+ * @details Bumped whenever the layout of the file changes.
+ *
+ */
+constexpr std::uint32_t tree_format = 4;
+
+/**
+ * @brief Written into every header, to reject trees saved
+ *     on a machine of the other byte order.
+ *
+ */
+constexpr std::uint32_t tree_byte_order = 0x01020304;
+
+/**
+ * @brief An enumeration of the events stored in a parse tree,
+ *     one for each method of `emitter`.
+ *
+ */
+enum tree_node_type {
+    NODE_TEXT,           // A run of plain text.
+    NODE_VERBATIM,       // A verbatim block, without the fences.
+    NODE_MATH,           // A math region, delimiters included.
+    NODE_INCLUDE,        // An include directive; the text is the path.
+    NODE_BEGIN_HEADING,  // The start of a headline; the argument is its level.
+    NODE_END_HEADING,    // The end of a headline; the argument is its level.
+    NODE_BEGIN_LIST,     // The start of a list; the argument is its type.
+    NODE_END_LIST,       // The end of a list; the argument is its type.
+    NODE_ITEM,           // The start of a list item.
+    NODE_ARROW,          // A right arrow.
+    NODE_BEGIN_TABLE,    // The start of a table; the text is its alignments.
+    NODE_BEGIN_ROW,      // The start of a row; the argument is 1 in a header.
+    NODE_NEXT_CELL,      // A new cell; the argument is 1 in a header.
+    NODE_END_ROW,        // The end of a row; the argument is 1 in a header.
+    NODE_END_TABLE,      // The end of a table.
+    NODE_HEAD,           // A head field; the argument is the field.
+    NODE_PIPE,           // A literal bar within a table cell.
+};
+
+/**
+ * @brief The header at the start of a saved parse tree.
+ *
+ */
+struct tree_header {
+    /**
+     * @brief Always "sparkdwn".
+     *
+     */
+    char magic[8];
+
+    /**
+     * @brief The format of the file: `tree_format`.
+     *
+     */
+    std::uint32_t format;
+
+    /**
+     * @brief `tree_byte_order`, as written by the saving machine.
+     *
+     */
+    std::uint32_t byte_order;
+
+    /**
+     * @brief The content hash of the Sparkdown text that was parsed.
+     *
+     */
+    std::uint64_t input_hash;
+
+    /**
+     * @brief The Sparkdown version that saved the tree,
+     *     padded with null characters.
+     *
+     */
+    char version[16];
+
+    /**
+     * @brief The number of nodes that follow the header.
+     *
+     */
+    std::uint64_t node_count;
+
+    /**
+     * @brief The number of bytes of text that follow the nodes.
+     *
+     */
+    std::uint64_t text_size;
+};
+
+/**
+ * @brief A single event of a saved parse tree.
+ * @details Text is stored as an offset into the text that follows the nodes,
+ *     rather than as a pointer, so that the tree can be mapped
+ *     at any address.
+ *
+ */
+struct tree_node {
+    /**
+     * @brief The kind of event: a `tree_node_type`.
+     *
+     */
+    std::uint32_t type;
+
+    /**
+     * @brief The level of a headline, the type of a list,
+     *     the field of a head directive, or whether a table row is a header.
+     *
+     */
+    std::uint32_t argument;
+
+    /**
+     * @brief The start of the event's text.
+     *
+     */
+    std::uint64_t offset;
+
+    /**
+     * @brief The length of the event's text.
+     *
+     */
+    std::uint64_t size;
+};
+
+static_assert(sizeof(tree_header) == 56 && sizeof(tree_header) % 8 == 0,
+              "the nodes must be aligned after the header");
+static_assert(sizeof(tree_node) == 24, "tree nodes must not be padded");
+static_assert(sizeof(SPARKDOWN_VERSION) <= sizeof(tree_header::version),
+              "the version must fit in the header");
+
+/**
+ * @brief A saved parse tree, mapped into memory.
+ * @details A parse tree is saved by a `tree_emitter` after parsing.
+ *     The file is the header, then the array of nodes,
+ *     then the text that the nodes refer to, all in native byte order.
+ *     Opening a tree maps the file and checks its header;
+ *     nothing is copied or decoded, so replaying a large document
+ *     costs no more than walking its nodes.
+ *
+ *     A tree is only opened if its header names the expected input hash,
+ *     the current format, and the current Sparkdown version,
+ *     so a stale tree is simply rebuilt by the caller.
+ *     The nodes themselves are checked while they are replayed.
+ *
+ *     An open tree may be replayed by several threads at once.
+ *
+ */
+class parse_tree {
+   private:
+    /**
+     * @brief The mapped file, or null if no tree is open.
+     *
+     */
+    const char *_data;
+
+    /**
+     * @brief The size of the mapped file.
+     *
+     */
+    std::size_t _size;
+
+    /**
+     * @brief Returns the header of the mapped file.
+     *
+     * @return The header.
+     */
+    [[nodiscard]] const tree_header &_header() const;
+
+   public:
+    /**
+     * @brief Constructor. No tree is open.
+     *
+     */
+    parse_tree();
+
+    /**
+     * @brief Destructor. Unmaps the tree, if one is open.
+     *
+     */
+    ~parse_tree();
+
+    parse_tree(const parse_tree &) = delete;
+    parse_tree &operator=(const parse_tree &) = delete;
+
+    /**
+     * @brief Move constructor. The other tree is left closed.
+     *
+     * @param other The tree to move.
+     */
+    parse_tree(parse_tree &&other) noexcept;
+
+    /**
+     * @brief Move assignment. The other tree is left closed.
+     *
+     * @param other The tree to move.
+     * @return This tree.
+     */
+    parse_tree &operator=(parse_tree &&other) noexcept;
+
+    /**
+     * @brief Maps the given saved tree into memory.
+     * @details Any tree already open is closed first.
+     *
+     * @param path The saved tree.
+     * @param input_hash The content hash of the Sparkdown text
+     *     that the tree must have been parsed from.
+     * @return True if the file exists, its header is current,
+     *     and it was parsed from the expected text.
+     */
+    bool open(const std::filesystem::path &path, std::uint64_t input_hash);
+
+    /**
+     * @brief Unmaps the tree, if one is open.
+     *
+     */
+    void close();
+
+    /**
+     * @brief Reports whether a tree is open.
+     *
+     * @return True if a tree is open.
+     */
+    [[nodiscard]] bool is_open() const;
+
+    /**
+     * @brief Returns the number of nodes in the open tree.
+     *
+     * @return The number of nodes.
+     */
+    [[nodiscard]] std::size_t node_count() const;
+
+    /**
+     * @brief Replays the open tree into the given emitters,
+     *     as if its text had been compiled with them.
+     * @details Each emitter is cleared first, as by `compiler#compile()`.
+     *     Include directives are handed to each emitter,
+     *     and then to the handler, as the compiler does.
+     *
+     * @param emitters The emitters to write with.
+     * @param handler The include handler, or null.
+     * @return `COMPILE_OK` on success; `COMPILE_DAMAGED_TREE` if a node
+     *     is malformed, in which case the output is incomplete;
+     *     otherwise, the failure of an include directive.
+     */
+    compile_status emit(const std::vector<emitter *> &emitters,
+                        include_handler *handler = nullptr) const;
+};
+
+}  // namespace sparkdown
+
+#endif
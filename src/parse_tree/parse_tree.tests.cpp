@@ -0,0 +1,231 @@
+/**
+ * @file parse_tree/parse_tree.tests.cpp
+ * @package //parse_tree:parse_tree.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `parse_tree` and `tree_emitter` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `tree_emitter` class, which saves parse trees,
+ *     and the `parse_tree` class, which maps and replays them.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunknown-pragmas"
+#pragma ide diagnostic ignored "UnusedLocalVariable"
+
+#include "parse_tree.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+
+#include "corpus/corpus.hpp"
+#include "emitter/html_emitter.hpp"
+#include "emitter/latex_emitter.hpp"
+#include "hash/hash.hpp"
+#include "scratch/scratch.hpp"
+#include "tree_emitter.hpp"
+
+/**
+ * @brief Include handler for testing.
+ * @details Writes the path of each include in brackets.
+ *
+ */
+class bracket_handler : public sparkdown::include_handler {
+   public:
+    sparkdown::compile_status include(std::string_view path,
+                                      std::string &output) override {
+        if (path == "missing._") return sparkdown::COMPILE_INCLUDE_NOT_FOUND;
+        output += "[";
+        output += path;
+        output += "]";
+        return sparkdown::COMPILE_OK;
+    }
+};
+
+/**
+ * @brief `tree_emitter` test.
+ * @details Ensures that every event is recorded with its text,
+ *     and that include directives need no handler.
+ *
+ */
+TEST(parse_tree, tree_emitter) {
+    sparkdown::compiler c;
+    std::string text;
+    sparkdown::tree_emitter tree(text);
+
+    EXPECT_EQ(c.compile("# A\n* b -> $c$\n$include: d._\n", {&tree}),
+              sparkdown::COMPILE_OK);
+    EXPECT_NE(text.find("d._"), std::string::npos);
+    ASSERT_FALSE(tree.nodes().empty());
+    EXPECT_EQ(tree.nodes().front().type, sparkdown::NODE_BEGIN_HEADING);
+    EXPECT_EQ(tree.nodes().front().argument, 1);
+
+    std::size_t includes = 0;
+    for (const sparkdown::tree_node &node : tree.nodes()) {
+        EXPECT_LE(node.offset + node.size, text.size());
+        if (node.type != sparkdown::NODE_INCLUDE) continue;
+        EXPECT_EQ(text.substr(node.offset, node.size), "d._");
+        includes++;
+    }
+    EXPECT_EQ(includes, 1);
+
+    // Compiling again starts a new tree.
+    EXPECT_EQ(c.compile("plain", {&tree}), sparkdown::COMPILE_OK);
+    ASSERT_EQ(tree.nodes().size(), 1);
+    EXPECT_EQ(text, "plain");
+}
+
+/**
+ * @brief `parse_tree#emit()` test.
+ * @details Ensures that replaying a saved tree of a generated document
+ *     gives the same output as compiling it, with each backend,
+ *     tables included, and that include directives
+ *     are handed to the handler.
+ *
+ */
+TEST(parse_tree, emit) {
+    std::filesystem::path dir = sparkdown::scratch::directory("tree-emit");
+    const std::string document =
+        sparkdown::corpus(7).generate(64 << 10) + "\n$include: b._\n" +
+        "| a | b |\n|:-:|--:|\n| 1\\|2 | 3 |\n";
+    const std::uint64_t hash = sparkdown::hash::of(document);
+
+    sparkdown::compiler c;
+    bracket_handler handler;
+    c.set_include_handler(&handler);
+    std::string latex;
+    std::string html;
+    std::string text;
+    sparkdown::latex_emitter latex_emitter(latex);
+    sparkdown::html_emitter html_emitter(html);
+    sparkdown::tree_emitter tree_emitter(text);
+    ASSERT_EQ(
+        c.compile(document, {&latex_emitter, &html_emitter, &tree_emitter}),
+        sparkdown::COMPILE_OK);
+    EXPECT_NE(latex.find("[b._]"), std::string::npos);
+    EXPECT_EQ(tree_emitter.save(dir / "tree", hash), sparkdown::WRITE_CHANGED);
+
+    sparkdown::parse_tree tree;
+    ASSERT_TRUE(tree.open(dir / "tree", hash));
+    EXPECT_EQ(tree.node_count(), tree_emitter.nodes().size());
+
+    std::string replayed_latex = "stale";
+    std::string replayed_html;
+    sparkdown::latex_emitter replayed_latex_emitter(replayed_latex);
+    sparkdown::html_emitter replayed_html_emitter(replayed_html);
+    EXPECT_EQ(tree.emit({&replayed_latex_emitter, &replayed_html_emitter}),
+              sparkdown::COMPILE_INCLUDE_UNSUPPORTED);
+    EXPECT_EQ(tree.emit({&replayed_latex_emitter, &replayed_html_emitter},
+                        &handler),
+              sparkdown::COMPILE_OK);
+    EXPECT_EQ(replayed_latex, latex);
+    EXPECT_EQ(replayed_html, html);
+
+    // A moved tree stays open.
+    sparkdown::parse_tree moved(std::move(tree));
+    EXPECT_FALSE(tree.is_open());
+    ASSERT_TRUE(moved.is_open());
+    EXPECT_EQ(moved.emit({&replayed_latex_emitter}, &handler),
+              sparkdown::COMPILE_OK);
+    EXPECT_EQ(replayed_latex, latex);
+}
+
+/**
+ * @brief `parse_tree#open()` test.
+ * @details Ensures that missing, truncated, foreign, and stale files
+ *     are not opened.
+ *
+ */
+TEST(parse_tree, open) {
+    std::filesystem::path dir = sparkdown::scratch::directory("tree-open");
+    sparkdown::compiler c;
+    std::string text;
+    sparkdown::tree_emitter tree_emitter(text);
+    ASSERT_EQ(c.compile("# A\nb", {&tree_emitter}), sparkdown::COMPILE_OK);
+    std::string contents;
+    tree_emitter.serialize(42, contents);
+
+    auto write = [&](const std::string &name, const std::string &bytes) {
+        std::ofstream(dir / name, std::ios::binary) << bytes;
+        return dir / name;
+    };
+
+    sparkdown::parse_tree tree;
+    EXPECT_TRUE(tree.open(write("good", contents), 42));
+    EXPECT_FALSE(tree.open(dir / "good", 43));
+    EXPECT_FALSE(tree.is_open());
+    EXPECT_FALSE(tree.open(dir / "missing", 42));
+    EXPECT_FALSE(tree.open(write("empty", ""), 42));
+    EXPECT_FALSE(tree.open(write("short", contents.substr(0, 40)), 42));
+    EXPECT_FALSE(tree.open(
+        write("truncated", contents.substr(0, contents.size() - 1)), 42));
+    EXPECT_FALSE(tree.open(write("long", contents + "x"), 42));
+
+    std::string stale = contents;
+    stale[offsetof(sparkdown::tree_header, version)] ^= 1;
+    EXPECT_FALSE(tree.open(write("stale", stale), 42));
+
+    std::string foreign = contents;
+    foreign[0] = 'S';
+    EXPECT_FALSE(tree.open(write("foreign", foreign), 42));
+
+    std::string format = contents;
+    format[offsetof(sparkdown::tree_header, format)] ^= 1;
+    EXPECT_FALSE(tree.open(write("format", format), 42));
+
+    std::string latex;
+    sparkdown::latex_emitter latex_emitter(latex);
+    EXPECT_EQ(tree.emit({&latex_emitter}), sparkdown::COMPILE_DAMAGED_TREE);
+}
+
+/**
+ * @brief `parse_tree#emit()` damage test.
+ * @details Ensures that nodes with text out of bounds, unknown types,
+ *     or arguments out of range are reported rather than followed.
+ *
+ */
+TEST(parse_tree, damaged) {
+    std::filesystem::path dir = sparkdown::scratch::directory("tree-damaged");
+    sparkdown::compiler c;
+    std::string text;
+    sparkdown::tree_emitter tree_emitter(text);
+    ASSERT_EQ(c.compile("# A\n* b\n", {&tree_emitter}), sparkdown::COMPILE_OK);
+    std::string contents;
+    tree_emitter.serialize(1, contents);
+
+    const std::size_t nodes = sizeof(sparkdown::tree_header);
+    const std::pair<std::size_t, std::uint64_t> damage[] = {
+        {offsetof(sparkdown::tree_node, offset), text.size() + 1},
+        {offsetof(sparkdown::tree_node, size), text.size() + 1},
+        {offsetof(sparkdown::tree_node, size), ~std::uint64_t(0)},
+        {offsetof(sparkdown::tree_node, type), sparkdown::NODE_PIPE + 1},
+        {offsetof(sparkdown::tree_node, argument), 4},
+    };
+    for (const auto &[field, value] : damage) {
+        std::string damaged = contents;
+        if (field == offsetof(sparkdown::tree_node, type) ||
+            field == offsetof(sparkdown::tree_node, argument)) {
+            auto narrow = static_cast<std::uint32_t>(value);
+            std::memcpy(&damaged[nodes + field], &narrow, sizeof(narrow));
+        } else {
+            std::memcpy(&damaged[nodes + field], &value, sizeof(value));
+        }
+        std::ofstream(dir / "tree", std::ios::binary) << damaged;
+
+        sparkdown::parse_tree tree;
+        ASSERT_TRUE(tree.open(dir / "tree", 1)) << field;
+        std::string latex;
+        sparkdown::latex_emitter latex_emitter(latex);
+        EXPECT_EQ(tree.emit({&latex_emitter}), sparkdown::COMPILE_DAMAGED_TREE)
+            << field << " " << value;
+    }
+}
+
+#pragma clang diagnostic pop
@@ -0,0 +1,133 @@
+/**
+ * @file parse_tree/tree_emitter.cpp
+ * @package //parse_tree:parse_tree
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `tree_emitter` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `tree_emitter` class,
+ *     which records a parsed document so that it can be saved
+ *     as a parse tree.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "tree_emitter.hpp"
+
+#include <cstring>
+
+namespace sparkdown {
+
+void tree_emitter::_record(tree_node_type type, std::uint32_t argument,
+                           std::string_view text) {
+    tree_node node{};
+    node.type = type;
+    node.argument = argument;
+    node.offset = this->_output->size();
+    node.size = text.size();
+    this->_output->append(text);
+    this->_nodes.push_back(node);
+}
+
+void tree_emitter::clear() {
+    this->_output->clear();
+    this->_nodes.clear();
+}
+
+void tree_emitter::text(std::string_view text) {
+    this->_record(NODE_TEXT, 0, text);
+}
+
+void tree_emitter::verbatim(std::string_view contents) {
+    this->_record(NODE_VERBATIM, 0, contents);
+}
+
+void tree_emitter::math(std::string_view region) {
+    this->_record(NODE_MATH, 0, region);
+}
+
+bool tree_emitter::include(std::string_view path) {
+    this->_record(NODE_INCLUDE, 0, path);
+    return true;
+}
+
+void tree_emitter::head(head_field field, std::string_view value) {
+    this->_record(NODE_HEAD, field, value);
+}
+
+void tree_emitter::begin_heading(int level) {
+    this->_record(NODE_BEGIN_HEADING, static_cast<std::uint32_t>(level));
+}
+
+void tree_emitter::end_heading(int level) {
+    this->_record(NODE_END_HEADING, static_cast<std::uint32_t>(level));
+}
+
+void tree_emitter::begin_list(list_type type) {
+    this->_record(NODE_BEGIN_LIST, type);
+}
+
+void tree_emitter::end_list(list_type type) {
+    this->_record(NODE_END_LIST, type);
+}
+
+void tree_emitter::item() { this->_record(NODE_ITEM, 0); }
+
+void tree_emitter::arrow() { this->_record(NODE_ARROW, 0); }
+
+void tree_emitter::begin_table(std::string_view columns) {
+    this->_record(NODE_BEGIN_TABLE, 0, columns);
+}
+
+void tree_emitter::begin_row(bool header) {
+    this->_record(NODE_BEGIN_ROW, header);
+}
+
+void tree_emitter::next_cell(bool header) {
+    this->_record(NODE_NEXT_CELL, header);
+}
+
+void tree_emitter::end_row(bool header) {
+    this->_record(NODE_END_ROW, header);
+}
+
+void tree_emitter::pipe() { this->_record(NODE_PIPE, 0); }
+
+void tree_emitter::end_table() { this->_record(NODE_END_TABLE, 0); }
+
+const std::vector<tree_node> &tree_emitter::nodes() const {
+    return this->_nodes;
+}
+
+void tree_emitter::serialize(std::uint64_t input_hash,
+                             std::string &result) const {
+    tree_header header{};
+    std::memcpy(header.magic, "sparkdwn", sizeof(header.magic));
+    header.format = tree_format;
+    header.byte_order = tree_byte_order;
+    header.input_hash = input_hash;
+    std::memcpy(header.version, SPARKDOWN_VERSION, sizeof(SPARKDOWN_VERSION));
+    header.node_count = this->_nodes.size();
+    header.text_size = this->_output->size();
+
+    result.clear();
+    result.reserve(sizeof(header) + this->_nodes.size() * sizeof(tree_node) +
+                   this->_output->size());
+    result.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    result.append(reinterpret_cast<const char *>(this->_nodes.data()),
+                  this->_nodes.size() * sizeof(tree_node));
+    result.append(*this->_output);
+}
+
+write_result tree_emitter::save(const std::filesystem::path &path,
+                                std::uint64_t input_hash) const {
+    std::string contents;
+    this->serialize(input_hash, contents);
+    return output::write(path, contents);
+}
+
+}  // namespace sparkdown
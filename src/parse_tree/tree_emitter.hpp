@@ -0,0 +1,142 @@
+/**
+ * @file parse_tree/tree_emitter.hpp
+ * @package //parse_tree:parse_tree
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `tree_emitter` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `tree_emitter` class,
+ *     which records a parsed document so that it can be saved
+ *     as a parse tree.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef TREE_EMITTER_HPP
+#define TREE_EMITTER_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "output/output.hpp"
+#include "parse_tree.hpp"
+
+namespace sparkdown {
+
+/**
+ * @brief Records a parsed document as the nodes of a parse tree.
+ * @details Given to `compiler#compile()` alongside the other emitters,
+ *     it records every event instead of writing it out.
+ *     The text of the events is gathered in the output buffer,
+ *     which becomes the text section of the saved tree.
+ *
+ *     Include directives are recorded, not followed,
+ *     so a saved tree depends only on the file it was parsed from.
+ *
+ */
+class tree_emitter : public emitter {
+   private:
+    /**
+     * @brief The nodes recorded so far.
+     *
+     */
+    std::vector<tree_node> _nodes;
+
+    /**
+     * @brief Records a single node.
+     *
+     * @param type The kind of event.
+     * @param argument The level of a headline, the type of a list,
+     *     the field of a head directive, or whether a table row is a header.
+     * @param text The text of the event, copied to the output buffer.
+     */
+    void _record(tree_node_type type, std::uint32_t argument,
+                 std::string_view text = {});
+
+   public:
+    using emitter::emitter;
+
+    /**
+     * @brief Clears the output buffer and the recorded nodes.
+     *
+     */
+    void clear() override;
+
+    void text(std::string_view text) override;
+
+    void verbatim(std::string_view contents) override;
+
+    void math(std::string_view region) override;
+
+    /**
+     * @brief Records an include directive.
+     *
+     * @param path The path given by the directive.
+     * @return Always true: the included file is not written.
+     */
+    bool include(std::string_view path) override;
+
+    void head(head_field field, std::string_view value) override;
+
+    void begin_heading(int level) override;
+
+    void end_heading(int level) override;
+
+    void begin_list(list_type type) override;
+
+    void end_list(list_type type) override;
+
+    void item() override;
+
+    void arrow() override;
+
+    void begin_table(std::string_view columns) override;
+
+    void begin_row(bool header) override;
+
+    void next_cell(bool header) override;
+
+    void end_row(bool header) override;
+
+    void pipe() override;
+
+    void end_table() override;
+
+    /**
+     * @brief Returns the nodes recorded so far.
+     *
+     * @return The nodes.
+     */
+    [[nodiscard]] const std::vector<tree_node> &nodes() const;
+
+    /**
+     * @brief Writes the recorded document in the parse tree format.
+     *
+     * @param input_hash The content hash of the Sparkdown text
+     *     that was parsed.
+     * @param result The buffer to write the tree to. Cleared first.
+     */
+    void serialize(std::uint64_t input_hash, std::string &result) const;
+
+    /**
+     * @brief Saves the recorded document as a parse tree.
+     * @details The file is written with `output::write()`,
+     *     so it is replaced atomically, and left alone if unchanged.
+     *
+     * @param path The file to write.
+     * @param input_hash The content hash of the Sparkdown text
+     *     that was parsed.
+     * @return Whether the file was changed, was unchanged, or failed.
+     */
+    write_result save(const std::filesystem::path &path,
+                      std::uint64_t input_hash) const;
+};
+
+}  // namespace sparkdown
+
+#endif
@@ -22,6 +22,7 @@
 #define PARSER_HPP
 
 #include <iostream>
+#include <memory_resource>
 #include <string>
 #include <tuple>
 
@@ -32,6 +33,11 @@ namespace sparkdown {
 
 /**
  * @brief Parses a sequence of tokens into a model of syntactic meaning.
+ * @details A parser, its state, and its patterns make up
+ *     a single parse context. The patterns keep a pointer
+ *     to the parser's state, so a parser is never copied,
+ *     and it must not be used by more than one thread at a time.
+ *     Parsers on different threads share nothing mutable.
  *
  */
 template <class... pattern_list>
@@ -53,6 +59,7 @@ class parser {
     void _apply_pattern(P &p, token_list &tokens,
                         token_list::iterator &position) {
         if (p.usable()) {
+            this->_state.visit();
             position = p.match(tokens, position);
         }
     }
@@ -67,6 +74,52 @@ class parser {
                    _patterns);
     }
 
+    /**
+     * @brief Constructs a parser whose patterns draw their memory
+     *     from the given resource.
+     * @details The token sequences given to `parse()` and `recycle()`
+     *     must use the same resource, since the patterns splice
+     *     nodes to and from them.
+     *     Every pattern must be constructible from the resource.
+     *
+     * @param resource The memory resource of the parsed token sequences.
+     */
+    explicit parser(std::pmr::memory_resource *resource)
+        : _state(resource), _patterns(pattern_list(resource)...) {
+        std::apply([this](auto &...p) { ((p.set_state(&this->_state)), ...); },
+                   _patterns);
+    }
+
+    parser(const parser &) = delete;
+    parser &operator=(const parser &) = delete;
+
+    /**
+     * @brief Returns the parser to its initial state,
+     *     so that it can be reused for a new document.
+     *
+     */
+    void reset() {
+        this->_state.reset();
+        std::apply([](auto &...p) { ((p.reset()), ...); }, _patterns);
+    }
+
+    /**
+     * @brief Moves the nodes of the tokens removed by the patterns
+     *     onto the end of the given list, so that they can be reused.
+     *
+     * @param spare The list to receive the nodes.
+     */
+    void recycle(token_list &spare) {
+        std::apply([&](auto &...p) { ((p.recycle(spare)), ...); }, _patterns);
+    }
+
+    /**
+     * @brief Returns the current state of the parser.
+     *
+     * @return The current state of the parser.
+     */
+    [[nodiscard]] const state &get_state() const { return this->_state; }
+
     /**
      * @brief Parses the given sequence of tokens.
      * @details Note that it operates in-place on the input list.
@@ -84,6 +137,7 @@ class parser {
                 },
                 _patterns);
         }
+        std::apply([&](auto &...p) { ((p.finish(tokens)), ...); }, _patterns);
     }
 };
 
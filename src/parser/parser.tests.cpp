@@ -279,4 +279,35 @@ TEST(parser, parse_change) {
     EXPECT_EQ(input, expected);
 }
 
+/**
+ * @brief `parser#reset()` test.
+ * @details Ensures that resetting the parser restores its initial state.
+ *
+ */
+TEST(parser, reset) {
+    sparkdown::token_list input = {'a', '$', 'b'};
+    sparkdown::parser<dummy_pattern_5> parser;
+
+    parser.parse(input);
+    EXPECT_TRUE(parser.get_state().is_math());
+
+    parser.reset();
+    EXPECT_FALSE(parser.get_state().is_math());
+    EXPECT_TRUE(parser.get_state().is_head());
+    EXPECT_EQ(parser.get_state().visits(), 0);
+}
+
+/**
+ * @brief `parser#parse()` work test.
+ * @details Ensures that each usable pattern visits each position once.
+ *
+ */
+TEST(parser, counts_visits) {
+    sparkdown::token_list input = {'a', 'b', 'c', '1', '2', '3'};
+    sparkdown::parser<dummy_pattern_3, dummy_pattern_3> parser;
+
+    parser.parse(input);
+    EXPECT_EQ(parser.get_state().visits(), 12);
+}
+
 #pragma clang diagnostic pop
\ No newline at end of file
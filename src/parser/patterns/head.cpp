@@ -0,0 +1,62 @@
+/**
+ * @file parser/patterns/head.cpp
+ * @package //parser/patterns:head
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `head` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `head` class,
+ *     which is the pattern-matching rule for the head directives.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "head.hpp"
+
+#include <iterator>
+
+namespace sparkdown {
+
+bool head::usable() const {
+    return !this->_state->is_math() && !this->_state->is_verbatim();
+}
+
+void head::reset() {}
+
+token_list::iterator head::match(token_list &tokens,
+                                 token_list::iterator position) {
+    if (position->type != token_type::CHAR_DOLLAR) return position;
+
+    // The directive must start a line.
+    if (position != tokens.begin() && std::prev(position)->value != '\n') {
+        return position;
+    }
+
+    // Every token compared after the "$" is a lookahead.
+    for (std::size_t i = 0; i < std::size(directives); i++) {
+        auto end = std::next(position);
+        const char *c = directives[i] + 1;
+        std::size_t lookahead = 0;
+        while (*c && end != tokens.end()) {
+            lookahead++;
+            if (end->value != *c) break;
+            c++;
+            end++;
+        }
+        this->_state->visit(lookahead);
+        if (*c) continue;
+
+        // The "$" becomes the head token; the rest is kept for reuse.
+        *position = types[i];
+        this->_spare.splice(this->_spare.end(), tokens, std::next(position),
+                            end);
+        return position;
+    }
+    return position;
+}
+
+}  // namespace sparkdown
@@ -0,0 +1,80 @@
+/**
+ * @file parser/patterns/head.hpp
+ * @package //parser/patterns:head
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `head` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `head` class,
+ *     which is the pattern-matching rule for the head directives.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef HEAD_HPP
+#define HEAD_HPP
+
+#include "pattern.hpp"
+
+namespace sparkdown {
+
+/**
+ * @brief Matches the head directives, which give the document's metadata.
+ * @details Each directive takes up a whole line:
+ *
+ *         $title: Notes on Sparkdown
+ *         $author: Cayden Lund
+ *         $date: Fall 2022
+ *
+ *     The leading "$title: ", "$author: ", or "$date: " is replaced with
+ *     a `COMP_TITLE`, `COMP_AUTHOR`, or `COMP_DATE` token;
+ *     the rest of the line (the value) is left as-is for the emitter.
+ *     The "$" is rewritten in place, and the nodes of the other tokens
+ *     are kept for reuse, so a warm parse does not allocate.
+ *
+ */
+class head : public pattern {
+   public:
+    using pattern::pattern;
+
+    /**
+     * @brief The text of each directive, up to the value.
+     *
+     */
+    static constexpr const char *directives[] = {"$title: ", "$author: ",
+                                                 "$date: "};
+
+    /**
+     * @brief The token that replaces each of `directives`.
+     *
+     */
+    static constexpr token_type types[] = {
+        token_type::COMP_TITLE, token_type::COMP_AUTHOR, token_type::COMP_DATE};
+
+    /**
+     * @brief Reports whether this pattern is usable in the current state.
+     * @details The directives are not recognized in math or verbatim text.
+     *
+     * @return True outside of math and verbatim text.
+     */
+    [[nodiscard]] bool usable() const override;
+
+    void reset() override;
+
+    /**
+     * @brief Replaces a directive at the start of a line
+     *     with its head token.
+     *
+     * @param tokens The list of tokens.
+     * @param position The current position in the list.
+     * @return The new position in the list.
+     */
+    token_list::iterator match(token_list &tokens,
+                               token_list::iterator position) override;
+};
+
+}  // namespace sparkdown
+
+#endif
@@ -0,0 +1,89 @@
+/**
+ * @file parser/patterns/head.tests.cpp
+ * @package //parser/patterns:head.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `head` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `head` class,
+ *     which is the pattern-matching rule for the head directives.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunknown-pragmas"
+#pragma ide diagnostic ignored "UnusedLocalVariable"
+
+#include "head.hpp"
+
+#include <gtest/gtest.h>
+
+#include "parser/parser.hpp"
+
+/**
+ * @brief Lexes the given string into a token list.
+ *
+ * @param str The string to lex.
+ * @return The token list.
+ */
+static sparkdown::token_list to_tokens(const std::string &str) {
+    return {str.begin(), str.end()};
+}
+
+/**
+ * @brief Ensures that each directive is replaced with its token
+ *     at the start of the input and at the start of a line.
+ *
+ */
+TEST(head, matches_directives) {
+    sparkdown::parser<sparkdown::head> parser;
+
+    sparkdown::token_list input =
+        to_tokens("$title: T\n$author: A\n$date: D\nb");
+    sparkdown::token_list expected = to_tokens("T\nA\nD\nb");
+    expected.insert(expected.begin(), sparkdown::token_type::COMP_TITLE);
+    expected.insert(std::next(expected.begin(), 3),
+                    sparkdown::token_type::COMP_AUTHOR);
+    expected.insert(std::next(expected.begin(), 6),
+                    sparkdown::token_type::COMP_DATE);
+
+    parser.parse(input);
+    EXPECT_EQ(input, expected);
+}
+
+/**
+ * @brief Ensures that a directive is left alone
+ *     when it does not start a line or is incomplete.
+ *
+ */
+TEST(head, ignores_non_directives) {
+    sparkdown::parser<sparkdown::head> parser;
+
+    for (const char *text : {"a $title: b", "$title:b", "$titl", "$date",
+                             "$", "$include: a._"}) {
+        sparkdown::token_list input = to_tokens(text);
+        sparkdown::token_list expected = to_tokens(text);
+        parser.reset();
+        parser.parse(input);
+        EXPECT_EQ(input, expected) << text;
+    }
+}
+
+/**
+ * @brief Ensures that the tokens looked ahead at are reported as visited.
+ *
+ */
+TEST(head, counts_lookahead) {
+    sparkdown::parser<sparkdown::head> parser;
+
+    // Three positions, plus two tokens compared against "$title: ",
+    // one against "$author: ", and one against "$date: ".
+    sparkdown::token_list input = to_tokens("$tx");
+    parser.parse(input);
+    EXPECT_EQ(parser.get_state().visits(), 7);
+}
+
+#pragma clang diagnostic pop
@@ -0,0 +1,86 @@
+/**
+ * @file parser/patterns/heading.cpp
+ * @package //parser/patterns:heading
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `heading` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `heading` class,
+ *     which is the pattern-matching rule for section headlines.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "heading.hpp"
+
+#include <iterator>
+
+namespace sparkdown {
+
+bool heading::usable() const {
+    return !this->_state->is_math() && !this->_state->is_verbatim();
+}
+
+void heading::reset() { this->_open = false; }
+
+void heading::_end(token_list &tokens, token_list::iterator position) {
+    if (this->_spare.empty()) {
+        tokens.insert(position, token_type::COMP_END_HEADING);
+    } else {
+        tokens.splice(position, this->_spare, this->_spare.begin());
+        *std::prev(position) = token_type::COMP_END_HEADING;
+    }
+    this->_open = false;
+}
+
+token_list::iterator heading::match(token_list &tokens,
+                                    token_list::iterator position) {
+    if (this->_open) {
+        // A "\r\n" line ending is kept out of the headline.
+        if (position->value == '\n' ||
+            (position->value == '\r' && std::next(position) != tokens.end() &&
+             std::next(position)->value == '\n')) {
+            this->_end(tokens, position);
+        }
+        return position;
+    }
+
+    if (position->type != token_type::CHAR_HASH) return position;
+    if (position != tokens.begin() && std::prev(position)->value != '\n') {
+        return position;
+    }
+
+    // Count the "#" characters, up to one more than the deepest level.
+    auto end = position;
+    int level = 0;
+    while (end != tokens.end() && end->type == token_type::CHAR_HASH &&
+           level < 4) {
+        end++;
+        level++;
+    }
+    this->_state->visit(level);
+    if (level > 3 || end == tokens.end() ||
+        end->type != token_type::CHAR_SPACE) {
+        return position;
+    }
+
+    // The first "#" becomes the headline token; the rest, and the space,
+    // are kept for reuse.
+    *position = level == 1   ? token_type::COMP_SECTION
+                : level == 2 ? token_type::COMP_SUBSECTION
+                             : token_type::COMP_SUBSUBSECTION;
+    this->_spare.splice(this->_spare.end(), tokens, std::next(position),
+                        std::next(end));
+    this->_open = true;
+    return position;
+}
+
+void heading::finish(token_list &tokens) {
+    if (this->_open) this->_end(tokens, tokens.end());
+}
+
+}  // namespace sparkdown
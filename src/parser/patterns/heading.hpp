@@ -0,0 +1,88 @@
+/**
+ * @file parser/patterns/heading.hpp
+ * @package //parser/patterns:heading
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `heading` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `heading` class,
+ *     which is the pattern-matching rule for section headlines.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef HEADING_HPP
+#define HEADING_HPP
+
+#include "pattern.hpp"
+
+namespace sparkdown {
+
+/**
+ * @brief Matches section headlines.
+ * @details A headline takes up a whole line,
+ *     starting with one to three "#" characters and a space:
+ *
+ *         # Section.
+ *         ## Subsection.
+ *         ### Subsubsection.
+ *
+ *     The leading "#" characters and space are replaced with a
+ *     `COMP_SECTION`, `COMP_SUBSECTION`, or `COMP_SUBSUBSECTION` token,
+ *     and a `COMP_END_HEADING` token is inserted at the end of the line,
+ *     before the "\r" of a "\r\n" line ending.
+ *
+ */
+class heading : public pattern {
+   private:
+    /**
+     * @brief Whether the current line is a headline.
+     *
+     */
+    bool _open = false;
+
+    /**
+     * @brief Inserts a `COMP_END_HEADING` token before the given position.
+     *
+     * @param tokens The list of tokens.
+     * @param position The position to insert before.
+     */
+    void _end(token_list &tokens, token_list::iterator position);
+
+   public:
+    using pattern::pattern;
+
+    /**
+     * @brief Reports whether this pattern is usable in the current state.
+     * @details Headlines are not recognized in math or verbatim text.
+     *
+     * @return True outside of math and verbatim text.
+     */
+    [[nodiscard]] bool usable() const override;
+
+    void reset() override;
+
+    /**
+     * @brief Replaces the "#" characters at the start of a headline,
+     *     and ends the headline at the end of its line.
+     *
+     * @param tokens The list of tokens.
+     * @param position The current position in the list.
+     * @return The new position in the list.
+     */
+    token_list::iterator match(token_list &tokens,
+                               token_list::iterator position) override;
+
+    /**
+     * @brief Ends a headline on the last line of the input.
+     *
+     * @param tokens The list of tokens.
+     */
+    void finish(token_list &tokens) override;
+};
+
+}  // namespace sparkdown
+
+#endif
@@ -0,0 +1,110 @@
+/**
+ * @file parser/patterns/heading.tests.cpp
+ * @package //parser/patterns:heading.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `heading` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `heading` class,
+ *     which is the pattern-matching rule for section headlines.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunknown-pragmas"
+#pragma ide diagnostic ignored "UnusedLocalVariable"
+
+#include "heading.hpp"
+
+#include <gtest/gtest.h>
+
+#include "parser/parser.hpp"
+
+/**
+ * @brief Parses the given string with the `heading` pattern,
+ *     and writes the result back out as text.
+ * @details The headline tokens are written as HTML-like tags,
+ *     so that the expected results are easy to read.
+ *
+ * @param parser The parser to use.
+ * @param str The string to parse.
+ * @return The parsed text.
+ */
+static std::string parse(sparkdown::parser<sparkdown::heading> &parser,
+                         const std::string &str) {
+    sparkdown::token_list tokens(str.begin(), str.end());
+    parser.reset();
+    parser.parse(tokens);
+
+    std::string result;
+    for (const sparkdown::token &t : tokens) {
+        switch (t.type) {
+            case sparkdown::token_type::COMP_SECTION:
+                result += "<h1>";
+                break;
+            case sparkdown::token_type::COMP_SUBSECTION:
+                result += "<h2>";
+                break;
+            case sparkdown::token_type::COMP_SUBSUBSECTION:
+                result += "<h3>";
+                break;
+            case sparkdown::token_type::COMP_END_HEADING:
+                result += "</h>";
+                break;
+            default:
+                result += t.value;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Ensures that headlines of each level are matched,
+ *     and end at the end of their line, before any "\r\n".
+ *
+ */
+TEST(heading, levels) {
+    sparkdown::parser<sparkdown::heading> parser;
+
+    EXPECT_EQ(parse(parser, "# A\n## B\n### C"),
+              "<h1>A</h>\n<h2>B</h>\n<h3>C</h>");
+    EXPECT_EQ(parse(parser, "text\n# A b\n\nmore"),
+              "text\n<h1>A b</h>\n\nmore");
+    EXPECT_EQ(parse(parser, "# A\r\n## B\r\ntext\r"),
+              "<h1>A</h>\r\n<h2>B</h>\r\ntext\r");
+    EXPECT_EQ(parse(parser, "# A\rB\n"), "<h1>A\rB</h>\n");
+}
+
+/**
+ * @brief Ensures that text that only looks like a headline is left alone.
+ *
+ */
+TEST(heading, non_headings) {
+    sparkdown::parser<sparkdown::heading> parser;
+
+    for (const char *text :
+         {"a # b", "#hashtag", "#### deep", "#", " # indented"}) {
+        EXPECT_EQ(parse(parser, text), text) << text;
+    }
+}
+
+/**
+ * @brief Ensures that the removed tokens are handed back for reuse.
+ *
+ */
+TEST(heading, recycle) {
+    sparkdown::parser<sparkdown::heading> parser;
+
+    sparkdown::token_list tokens = {'#', '#', ' ', 'a', '\n'};
+    parser.parse(tokens);
+    EXPECT_EQ(tokens.size(), 4);
+
+    sparkdown::token_list spare;
+    parser.recycle(spare);
+    EXPECT_EQ(spare.size(), 1);
+}
+
+#pragma clang diagnostic pop
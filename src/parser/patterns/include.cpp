@@ -0,0 +1,57 @@
+/**
+ * @file parser/patterns/include.cpp
+ * @package //parser/patterns:include
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `include` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `include` class,
+ *     which is the pattern-matching rule for the include directive.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "include.hpp"
+
+#include <iterator>
+
+namespace sparkdown {
+
+bool include::usable() const {
+    return !this->_state->is_math() && !this->_state->is_verbatim();
+}
+
+void include::reset() {}
+
+token_list::iterator include::match(token_list &tokens,
+                                    token_list::iterator position) {
+    if (position->type != token_type::CHAR_DOLLAR) return position;
+
+    // The directive must start a line.
+    if (position != tokens.begin() && std::prev(position)->value != '\n') {
+        return position;
+    }
+
+    // Every token after the first is a lookahead.
+    auto end = position;
+    std::size_t lookahead = 0;
+    for (const char *c = directive; *c; c++, end++) {
+        if (end == tokens.end() || end->value != *c) {
+            this->_state->visit(lookahead);
+            return position;
+        }
+        if (end != position) lookahead++;
+    }
+    this->_state->visit(lookahead);
+
+    // The "$" becomes the directive token; the rest is kept for reuse.
+    *position = token_type::COMP_INCLUDE;
+    this->_spare.splice(this->_spare.end(), tokens, std::next(position), end);
+    return position;
+}
+
+}  // namespace sparkdown
@@ -0,0 +1,69 @@
+/**
+ * @file parser/patterns/include.hpp
+ * @package //parser/patterns:include
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `include` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `include` class,
+ *     which is the pattern-matching rule for the include directive.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef INCLUDE_HPP
+#define INCLUDE_HPP
+
+#include "pattern.hpp"
+
+namespace sparkdown {
+
+/**
+ * @brief Matches the include directive, which pulls in another file.
+ * @details The directive takes up a whole line:
+ *
+ *         $include: chapters/intro._
+ *
+ *     The leading "$include: " is replaced with a `COMP_INCLUDE` token;
+ *     the rest of the line (the path) is left as-is for the emitter.
+ *     The "$" is rewritten in place, and the nodes of the other tokens
+ *     are kept for reuse, so a warm parse does not allocate.
+ *
+ */
+class include : public pattern {
+   public:
+    using pattern::pattern;
+
+    /**
+     * @brief The text of the directive, up to the path.
+     *
+     */
+    static constexpr const char *directive = "$include: ";
+
+    /**
+     * @brief Reports whether this pattern is usable in the current state.
+     * @details The directive is not recognized in math or verbatim text.
+     *
+     * @return True outside of math and verbatim text.
+     */
+    [[nodiscard]] bool usable() const override;
+
+    void reset() override;
+
+    /**
+     * @brief Replaces the directive at the start of a line
+     *     with a `COMP_INCLUDE` token.
+     *
+     * @param tokens The list of tokens.
+     * @param position The current position in the list.
+     * @return The new position in the list.
+     */
+    token_list::iterator match(token_list &tokens,
+                               token_list::iterator position) override;
+};
+
+}  // namespace sparkdown
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * @file parser/patterns/include.tests.cpp
+ * @package //parser/patterns:include.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `include` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `include` class,
+ *     which is the pattern-matching rule for the include directive.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "include.hpp"
+
+#include <gtest/gtest.h>
+
+#include "parser/parser.hpp"
+
+/**
+ * @brief Lexes the given string into a token list.
+ *
+ * @param str The string to lex.
+ * @return The token list.
+ */
+static sparkdown::token_list to_tokens(const std::string &str) {
+    return {str.begin(), str.end()};
+}
+
+/**
+ * @brief Ensures that the directive is matched at the start of the input
+ *     and at the start of a line.
+ *
+ */
+TEST(include, matches_directive) {
+    sparkdown::parser<sparkdown::include> parser;
+
+    sparkdown::token_list input = to_tokens("$include: a._\nb\n$include: c._");
+    sparkdown::token_list expected = to_tokens("a._\nb\nc._");
+    expected.insert(expected.begin(), sparkdown::token_type::COMP_INCLUDE);
+    expected.insert(std::next(expected.begin(), 7),
+                    sparkdown::token_type::COMP_INCLUDE);
+
+    parser.parse(input);
+    EXPECT_EQ(input, expected);
+}
+
+/**
+ * @brief Ensures that the directive is left alone
+ *     when it does not start a line or is incomplete.
+ *
+ */
+TEST(include, ignores_non_directives) {
+    sparkdown::parser<sparkdown::include> parser;
+
+    for (const char *text :
+         {"a $include: b._", "$include:b._", "$includ", "$"}) {
+        sparkdown::token_list input = to_tokens(text);
+        sparkdown::token_list expected = to_tokens(text);
+        parser.reset();
+        parser.parse(input);
+        EXPECT_EQ(input, expected) << text;
+    }
+}
+
+/**
+ * @brief Ensures that the tokens looked ahead at are reported as visited.
+ *
+ */
+TEST(include, counts_lookahead) {
+    sparkdown::parser<sparkdown::include> parser;
+
+    // Seven positions, plus six tokens after the `$`.
+    sparkdown::token_list input = to_tokens("$includ");
+    parser.parse(input);
+    EXPECT_EQ(parser.get_state().visits(), 13);
+}
@@ -0,0 +1,145 @@
+/**
+ * @file parser/patterns/list.cpp
+ * @package //parser/patterns:list
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `list` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `list` class,
+ *     which is the pattern-matching rule for nested lists.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "list.hpp"
+
+#include <iterator>
+
+namespace sparkdown {
+
+bool list::usable() const {
+    return !this->_state->is_math() && !this->_state->is_verbatim();
+}
+
+void list::reset() {
+    while (this->_spare.size() > this->_owned) this->_spare.pop_back();
+}
+
+token_list::iterator list::_insert(token_list &tokens,
+                                   token_list::iterator position, token t) {
+    if (this->_spare.empty()) {
+        this->_owned++;
+        return tokens.insert(position, t);
+    }
+
+    tokens.splice(position, this->_spare, this->_spare.begin());
+    auto inserted = std::prev(position);
+    *inserted = t;
+    return inserted;
+}
+
+void list::_close(token_list &tokens, token_list::iterator position) {
+    this->_insert(tokens, position,
+                  this->_state->list_kind() == LIST_ITEMIZE
+                      ? token_type::COMP_END_ITEMIZE
+                      : token_type::COMP_END_ENUMERATE);
+    this->_state->close_list();
+}
+
+token_list::iterator list::match(token_list &tokens,
+                                 token_list::iterator position) {
+    // Only the start of a line can open, continue, or close a list.
+    if (position != tokens.begin() && std::prev(position)->value != '\n') {
+        return position;
+    }
+
+    // Measure the indentation.
+    auto marker = position;
+    std::size_t indent = 0;
+    while (marker != tokens.end() &&
+           marker->type == token_type::CHAR_SPACE) {
+        marker++;
+        indent++;
+    }
+    this->_state->visit(indent);
+    if (marker == tokens.end() || marker->value == '\n') return position;
+
+    // Look for an item marker.
+    auto content = std::next(marker);
+    list_type type = LIST_ITEMIZE;
+    bool is_item = false;
+    if (marker->type == token_type::CHAR_STAR ||
+        marker->type == token_type::CHAR_DASH) {
+        is_item = true;
+    } else if (marker->type == token_type::CHAR_NUMBER) {
+        while (content != tokens.end() &&
+               content->type == token_type::CHAR_NUMBER) {
+            this->_state->visit();
+            content++;
+        }
+        type = LIST_ENUMERATE;
+        is_item = content != tokens.end() &&
+                  content->type == token_type::CHAR_PERIOD;
+        if (is_item) content++;
+    }
+    if (is_item) {
+        this->_state->visit();
+        is_item = content != tokens.end() &&
+                  content->type == token_type::CHAR_SPACE;
+    }
+
+    if (!is_item) {
+        // The line continues the items indented less than it.
+        while (this->_state->list_depth() > 0 &&
+               this->_state->list_indent() >= indent) {
+            this->_close(tokens, position);
+        }
+        return position;
+    }
+
+    while (this->_state->list_depth() > 0 &&
+           this->_state->list_indent() > indent) {
+        this->_close(tokens, position);
+    }
+    if (this->_state->list_depth() > 0 &&
+        this->_state->list_indent() == indent &&
+        this->_state->list_kind() != type) {
+        this->_close(tokens, position);
+    }
+
+    // The indentation, the marker, and the space after it are removed.
+    content++;
+    this->_spare.splice(this->_spare.end(), tokens, position, content);
+
+    if (this->_state->list_depth() == 0 ||
+        this->_state->list_indent() < indent) {
+        this->_state->open_list(type, indent);
+        this->_insert(tokens, content,
+                      type == LIST_ITEMIZE
+                          ? token_type::COMP_BEGIN_ITEMIZE
+                          : token_type::COMP_BEGIN_ENUMERATE);
+    }
+    return this->_insert(tokens, content, token_type::COMP_ITEM);
+}
+
+void list::finish(token_list &tokens) {
+    if (this->_state->list_depth() == 0) return;
+
+    if (!tokens.empty() && tokens.back().value != '\n') {
+        this->_insert(tokens, tokens.end(), '\n');
+    }
+    while (this->_state->list_depth() > 0) this->_close(tokens, tokens.end());
+}
+
+void list::recycle(token_list &spare) {
+    if (this->_spare.size() <= this->_owned) return;
+    spare.splice(spare.end(), this->_spare,
+                 std::next(this->_spare.begin(), this->_owned),
+                 this->_spare.end());
+}
+
+}  // namespace sparkdown
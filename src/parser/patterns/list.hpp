@@ -0,0 +1,124 @@
+/**
+ * @file parser/patterns/list.hpp
+ * @package //parser/patterns:list
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `list` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `list` class,
+ *     which is the pattern-matching rule for nested lists.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef LIST_HPP
+#define LIST_HPP
+
+#include <cstddef>
+
+#include "pattern.hpp"
+
+namespace sparkdown {
+
+/**
+ * @brief Matches list items, and opens and closes the lists around them.
+ * @details An item is a line whose first non-blank text is a marker,
+ *     "* ", "- ", or a number followed by ". ":
+ *
+ *         * An unordered item.
+ *           A continuation of the same item.
+ *           1. An ordered item, nested inside of it.
+ *
+ *     The open lists, and the indentation of their markers,
+ *     are kept as a stack in the parser's state,
+ *     so each line is handled by looking only at its own indentation:
+ *
+ *     - An item indented more than the innermost list opens a new list.
+ *     - An item indented as much as the innermost list continues it,
+ *       unless the kind of marker differs.
+ *     - Any other line closes the lists indented as much as it or more,
+ *       and continues the innermost remaining item, if any.
+ *     - Blank lines are ignored.
+ *
+ *     Each space or tab counts as one column of indentation.
+ *
+ *     The indentation and marker of an item are replaced
+ *     with a `COMP_ITEM` token, preceded by the `COMP_BEGIN_*`
+ *     and `COMP_END_*` tokens of the lists it opens and closes.
+ *     The lists still open at the end of the input are closed there.
+ *
+ */
+class list : public pattern {
+   private:
+    /**
+     * @brief The number of token nodes this pattern has allocated itself.
+     * @details That many removed tokens are kept between documents,
+     *     so that lists can be closed where no tokens are removed
+     *     without allocating again.
+     *
+     */
+    std::size_t _owned = 0;
+
+    /**
+     * @brief Inserts the given token before the given position.
+     *
+     * @param tokens The list of tokens.
+     * @param position The position to insert before.
+     * @param t The token to insert.
+     * @return The position of the inserted token.
+     */
+    token_list::iterator _insert(token_list &tokens,
+                                 token_list::iterator position, token t);
+
+    /**
+     * @brief Closes the innermost open list,
+     *     inserting its end token before the given position.
+     *
+     * @param tokens The list of tokens.
+     * @param position The position to insert before.
+     */
+    void _close(token_list &tokens, token_list::iterator position);
+
+   public:
+    using pattern::pattern;
+
+    /**
+     * @brief Reports whether this pattern is usable in the current state.
+     * @details Lists are not recognized in math or verbatim text.
+     *
+     * @return True outside of math and verbatim text.
+     */
+    [[nodiscard]] bool usable() const override;
+
+    void reset() override;
+
+    /**
+     * @brief Opens, continues, or closes lists at the start of a line.
+     *
+     * @param tokens The list of tokens.
+     * @param position The current position in the list.
+     * @return The new position in the list.
+     */
+    token_list::iterator match(token_list &tokens,
+                               token_list::iterator position) override;
+
+    /**
+     * @brief Closes the lists still open at the end of the input.
+     *
+     * @param tokens The list of tokens.
+     */
+    void finish(token_list &tokens) override;
+
+    /**
+     * @brief Hands back the removed tokens beyond the `_owned` it keeps.
+     *
+     * @param spare The list to move the nodes onto the end of.
+     */
+    void recycle(token_list &spare) override;
+};
+
+}  // namespace sparkdown
+
+#endif
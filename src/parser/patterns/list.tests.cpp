@@ -0,0 +1,164 @@
+/**
+ * @file parser/patterns/list.tests.cpp
+ * @package //parser/patterns:list.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `list` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `list` class,
+ *     which is the pattern-matching rule for nested lists.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunknown-pragmas"
+#pragma ide diagnostic ignored "UnusedLocalVariable"
+
+#include "list.hpp"
+
+#include <gtest/gtest.h>
+
+#include "parser/parser.hpp"
+
+/**
+ * @brief Parses the given string with the `list` pattern,
+ *     and writes the result back out as text.
+ * @details The list tokens are written as HTML-like tags,
+ *     so that the expected results are easy to read.
+ *
+ * @param parser The parser to use.
+ * @param str The string to parse.
+ * @return The parsed text.
+ */
+static std::string parse(sparkdown::parser<sparkdown::list> &parser,
+                         const std::string &str) {
+    sparkdown::token_list tokens(str.begin(), str.end());
+    parser.reset();
+    parser.parse(tokens);
+
+    std::string result;
+    for (const sparkdown::token &t : tokens) {
+        switch (t.type) {
+            case sparkdown::token_type::COMP_BEGIN_ITEMIZE:
+                result += "<ul>";
+                break;
+            case sparkdown::token_type::COMP_END_ITEMIZE:
+                result += "</ul>";
+                break;
+            case sparkdown::token_type::COMP_BEGIN_ENUMERATE:
+                result += "<ol>";
+                break;
+            case sparkdown::token_type::COMP_END_ENUMERATE:
+                result += "</ol>";
+                break;
+            case sparkdown::token_type::COMP_ITEM:
+                result += "<li>";
+                break;
+            default:
+                result += t.value;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Ensures that flat lists of each kind are matched.
+ *
+ */
+TEST(list, flat) {
+    sparkdown::parser<sparkdown::list> parser;
+
+    EXPECT_EQ(parse(parser, "* a\n* b\n"), "<ul><li>a\n<li>b\n</ul>");
+    EXPECT_EQ(parse(parser, "- a\n- b"), "<ul><li>a\n<li>b\n</ul>");
+    EXPECT_EQ(parse(parser, "1. a\n2. b\n10. c\n"),
+              "<ol><li>a\n<li>b\n<li>c\n</ol>");
+}
+
+/**
+ * @brief Ensures that indented items open nested lists,
+ *     and that outdented items close them.
+ *
+ */
+TEST(list, nested) {
+    sparkdown::parser<sparkdown::list> parser;
+
+    EXPECT_EQ(parse(parser, "* a\n  1. b\n    - c\n* d\n"),
+              "<ul><li>a\n<ol><li>b\n<ul><li>c\n</ul></ol><li>d\n</ul>");
+    EXPECT_EQ(parse(parser, "* a\n  * b\n  * c\n"),
+              "<ul><li>a\n<ul><li>b\n<li>c\n</ul></ul>");
+}
+
+/**
+ * @brief Ensures that changing the kind of marker starts a new list.
+ *
+ */
+TEST(list, kind_change) {
+    sparkdown::parser<sparkdown::list> parser;
+
+    EXPECT_EQ(parse(parser, "* a\n1. b\n"), "<ul><li>a\n</ul><ol><li>b\n</ol>");
+    EXPECT_EQ(parse(parser, "* a\n- b\n"), "<ul><li>a\n<li>b\n</ul>");
+}
+
+/**
+ * @brief Ensures that indented lines and line breaks continue an item,
+ *     that blank lines are ignored, and that other lines close the lists.
+ *
+ */
+TEST(list, continuation) {
+    sparkdown::parser<sparkdown::list> parser;
+
+    EXPECT_EQ(parse(parser, "* a\n  more\n  \\\\ after\n\n* b\nc\n"),
+              "<ul><li>a\n  more\n  \\\\ after\n\n<li>b\n</ul>c\n");
+    EXPECT_EQ(parse(parser, "* a\n  * b\n  more\nc"),
+              "<ul><li>a\n<ul><li>b\n</ul>  more\n</ul>c");
+}
+
+/**
+ * @brief Ensures that text that only looks like a marker is left alone.
+ *
+ */
+TEST(list, non_items) {
+    sparkdown::parser<sparkdown::list> parser;
+
+    for (const char *text :
+         {"a * b", "*bold*", "-> b", "---", "1.5 a", "12 a", "1.", "*"}) {
+        EXPECT_EQ(parse(parser, text), text) << text;
+    }
+}
+
+/**
+ * @brief Ensures that the work done is linear in the size of the input,
+ *     even for long and deeply nested lists.
+ *
+ */
+TEST(list, linear) {
+    sparkdown::parser<sparkdown::list> parser;
+
+    // A thousand items, nested ten deep and back again, over and over.
+    std::string text;
+    for (std::size_t i = 0; i < 1000; i++) {
+        std::size_t depth = i % 20 < 10 ? i % 20 : 19 - i % 20;
+        text.append(2 * depth, ' ');
+        text += i % 3 == 0 ? "1. item\n" : "* item\n";
+    }
+
+    std::string parsed = parse(parser, text);
+    EXPECT_EQ(parser.get_state().list_depth(), 0);
+    EXPECT_LE(parser.get_state().visits(), 2 * text.size());
+
+    std::size_t opened = 0;
+    std::size_t closed = 0;
+    for (std::size_t i = 0; (i = parsed.find('<', i)) != std::string::npos;
+         i++) {
+        if (parsed.compare(i, 4, "<ul>") == 0) opened++;
+        if (parsed.compare(i, 4, "<ol>") == 0) opened++;
+        if (parsed.compare(i, 2, "</") == 0) closed++;
+    }
+    EXPECT_GT(opened, 100);
+    EXPECT_EQ(opened, closed);
+}
+
+#pragma clang diagnostic pop
@@ -20,7 +20,7 @@
 #ifndef PATTERN_HPP
 #define PATTERN_HPP
 
-#include <list>
+#include <memory_resource>
 #include <string>
 
 #include "state/state.hpp"
@@ -28,8 +28,6 @@
 
 namespace sparkdown {
 
-typedef std::list<token> token_list;
-
 /**
  * @brief Base class for any pattern rules for the parser.
  *
@@ -38,16 +36,32 @@ class pattern {
    protected:
     /**
      * @brief Pointer to the parser's state object.
+     * @details Set by the parser that owns this pattern,
+     *     so the pattern is only ever used alongside that parser.
      *
      */
     state *_state;
 
+    /**
+     * @brief Holds the nodes of the tokens this pattern has removed
+     *     from the sequence.
+     * @details Patterns that insert tokens reuse them,
+     *     so a reused parser need not allocate.
+     *     It uses the parser's memory resource,
+     *     so nodes can be spliced to and from the token sequence.
+     *
+     */
+    token_list _spare;
+
    public:
     /**
-     * @brief Zero-argument constructor.
+     * @brief Constructor.
      *
+     * @param resource The memory resource of the parsed token sequences.
      */
-    pattern() : _state(nullptr) {}
+    explicit pattern(
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : _state(nullptr), _spare(resource) {}
 
     /**
      * @brief Updates the pointer to the parser's state object
@@ -82,6 +96,26 @@ class pattern {
      */
     virtual token_list::iterator match(token_list &tokens,
                                        token_list::iterator position) = 0;
+
+    /**
+     * @brief Called once the parser has matched every position.
+     * @details Lets a pattern close whatever it still has open
+     *     at the end of the input. Does nothing by default.
+     *
+     * @param tokens The list of tokens.
+     */
+    virtual void finish([[maybe_unused]] token_list &tokens) {}
+
+    /**
+     * @brief Hands back the nodes of tokens this pattern has removed,
+     *     so that the lexer can reuse them.
+     * @details Hands back every spare node by default.
+     *
+     * @param spare The list to move the nodes onto the end of.
+     */
+    virtual void recycle(token_list &spare) {
+        spare.splice(spare.end(), this->_spare);
+    }
 };
 
 }  // namespace sparkdown
@@ -0,0 +1,238 @@
+/**
+ * @file parser/patterns/table.cpp
+ * @package //parser/patterns:table
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `table` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `table` class,
+ *     which is the pattern-matching rule for pipe tables.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "table.hpp"
+
+#include <iterator>
+
+namespace sparkdown {
+
+namespace {
+
+/**
+ * @brief Returns the end of the text of a line,
+ *     before the "\r" of a "\r\n" line ending.
+ *
+ * @param tokens The tokens.
+ * @param end The "\n" that ends the line, or the end of the tokens.
+ * @return The end of the line's text.
+ */
+token_list::iterator text_end(token_list &tokens, token_list::iterator end) {
+    if (end == tokens.begin()) return end;
+    auto before = std::prev(end);
+    return before->value == '\r' ? before : end;
+}
+
+}  // namespace
+
+bool table::usable() const {
+    return !this->_state->is_math() && !this->_state->is_verbatim();
+}
+
+void table::reset() {
+    this->_columns = 0;
+    while (this->_spare.size() > this->_owned) this->_spare.pop_back();
+}
+
+token_list::iterator table::_insert(token_list &tokens,
+                                    token_list::iterator position, token t) {
+    if (this->_spare.empty()) {
+        this->_owned++;
+        return tokens.insert(position, t);
+    }
+
+    tokens.splice(position, this->_spare, this->_spare.begin());
+    auto inserted = std::prev(position);
+    *inserted = t;
+    return inserted;
+}
+
+token_list::iterator table::_row(token_list &tokens,
+                                 token_list::iterator position,
+                                 std::size_t &cells, bool mark) {
+    cells = 1;
+    auto last = tokens.end();  // The last "|" seen.
+    bool trailing = false;     // Whether only blanks follow it.
+    std::size_t visited = 1;
+    auto it = std::next(position);
+    for (; it != tokens.end() && it->value != '\n'; it++) {
+        visited++;
+        if (it->type == token_type::CHAR_ESCAPE) {
+            // An escaped character, such as "\|", is text.
+            // An escaped bar becomes a single token, since the backends
+            // write a literal bar differently.
+            auto next = std::next(it);
+            if (next != tokens.end() && next->value != '\n') {
+                if (mark && next->type == token_type::CHAR_PIPE) {
+                    *it = token_type::COMP_PIPE;
+                    this->_spare.splice(this->_spare.end(), tokens, next);
+                } else {
+                    it++;
+                }
+                visited++;
+            }
+            trailing = false;
+        } else if (it->type == token_type::CHAR_PIPE) {
+            if (mark && cells < this->_columns) *it = token_type::COMP_CELL;
+            cells++;
+            last = it;
+            trailing = true;
+        } else if (it->type != token_type::CHAR_SPACE && it->value != '\r') {
+            trailing = false;
+        }
+    }
+    this->_state->visit(visited);
+    if (trailing) cells--;
+
+    if (mark) {
+        *position = token_type::COMP_BEGIN_ROW;
+        if (trailing) {
+            *last = token_type::COMP_END_ROW;
+        } else {
+            this->_insert(tokens, text_end(tokens, it),
+                          token_type::COMP_END_ROW);
+        }
+    }
+    return it;
+}
+
+token_list::iterator table::_separator(token_list &tokens,
+                                       token_list::iterator position,
+                                       std::size_t &columns, bool rewrite) {
+    // Each column is rewritten no later than the token just read,
+    // since it spans at least a "|" and a "-".
+    auto out = position;
+    if (rewrite) *out++ = token_type::COMP_BEGIN_TABLE;
+
+    columns = 0;
+    std::size_t visited = 1;
+    auto it = std::next(position);
+    auto skip = [&](token_type type) {
+        std::size_t count = 0;
+        while (it != tokens.end() && it->type == type) {
+            it++;
+            count++;
+        }
+        visited += count;
+        return count;
+    };
+    // Reports whether the line has ended; a "\r\n" is stepped over
+    // to its "\n", so that the "\r" goes with the rest of the row.
+    auto line_end = [&] {
+        if (it != tokens.end() && it->value == '\r' &&
+            std::next(it) != tokens.end() && std::next(it)->value == '\n') {
+            it++;
+            visited++;
+        }
+        return it == tokens.end() || it->value == '\n';
+    };
+    for (;;) {
+        skip(token_type::CHAR_SPACE);
+        if (line_end()) break;
+
+        std::size_t left = skip(token_type::CHAR_COLON);
+        std::size_t dashes = skip(token_type::CHAR_DASH);
+        std::size_t right = skip(token_type::CHAR_COLON);
+        skip(token_type::CHAR_SPACE);
+        if (left > 1 || dashes == 0 || right > 1) {
+            columns = 0;
+            break;
+        }
+
+        columns++;
+        if (rewrite) {
+            *out = token_type::COMP_COLUMN;
+            out->value = right ? (left ? 'c' : 'r') : 'l';
+            out++;
+        }
+        if (line_end()) break;
+        if (it->type != token_type::CHAR_PIPE) {
+            columns = 0;
+            break;
+        }
+        it++;
+        visited++;
+    }
+    this->_state->visit(visited);
+    return it;
+}
+
+token_list::iterator table::match(token_list &tokens,
+                                  token_list::iterator position) {
+    // Only the start of a line can open, continue, or close a table.
+    if (position != tokens.begin() && std::prev(position)->value != '\n') {
+        return position;
+    }
+
+    std::size_t cells;
+    if (this->_columns > 0) {
+        if (position->type == token_type::CHAR_PIPE) {
+            this->_row(tokens, position, cells, true);
+        } else {
+            this->_insert(tokens, text_end(tokens, std::prev(position)),
+                          token_type::COMP_END_TABLE);
+            this->_columns = 0;
+        }
+        return position;
+    }
+
+    // A header row must be followed by a separator row.
+    if (position->type != token_type::CHAR_PIPE) return position;
+    auto end = this->_row(tokens, position, cells, false);
+    if (end == tokens.end()) return position;
+    auto separator = std::next(end);
+    if (separator == tokens.end() ||
+        separator->type != token_type::CHAR_PIPE) {
+        return position;
+    }
+    std::size_t columns;
+    end = this->_separator(tokens, separator, columns, false);
+    if (columns == 0 || columns != cells) return position;
+
+    // The start of the separator row becomes the table's opening tokens,
+    // moved before the header row; the rest of its line is removed.
+    this->_separator(tokens, separator, columns, true);
+    auto rest = std::next(
+        separator, static_cast<token_list::difference_type>(columns + 1));
+    tokens.splice(position, tokens, separator, rest);
+    if (end != tokens.end()) end++;
+    this->_spare.splice(this->_spare.end(), tokens, rest, end);
+
+    this->_columns = columns;
+    this->_row(tokens, position, cells, true);
+
+    // The other patterns see the line as starting with the table.
+    return separator;
+}
+
+void table::finish(token_list &tokens) {
+    if (this->_columns == 0) return;
+
+    auto end = tokens.end();
+    if (tokens.back().value == '\n') end--;
+    this->_insert(tokens, text_end(tokens, end), token_type::COMP_END_TABLE);
+    this->_columns = 0;
+}
+
+void table::recycle(token_list &spare) {
+    if (this->_spare.size() <= this->_owned) return;
+    spare.splice(spare.end(), this->_spare,
+                 std::next(this->_spare.begin(), this->_owned),
+                 this->_spare.end());
+}
+
+}  // namespace sparkdown
@@ -0,0 +1,154 @@
+/**
+ * @file parser/patterns/table.hpp
+ * @package //parser/patterns:table
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `table` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `table` class,
+ *     which is the pattern-matching rule for pipe tables.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef TABLE_HPP
+#define TABLE_HPP
+
+#include <cstddef>
+
+#include "pattern.hpp"
+
+namespace sparkdown {
+
+/**
+ * @brief Matches pipe tables, a row at a time.
+ * @details A table is a header row, a separator row, and any number
+ *     of body rows, each a line that starts with "|":
+ *
+ *         | Sample | Mass (g) | Notes     |
+ *         |:-------|---------:|:---------:|
+ *         | A      |     12.5 | clean     |
+ *         | B      |      9.1 | \| marked |
+ *
+ *     The separator row gives the number of columns,
+ *     and the alignment of each: "---" or ":--" for left,
+ *     "--:" for right, and ":-:" for center.
+ *     The header row must have as many cells.
+ *     The final "|" of a row is optional, and "\|" is a literal bar.
+ *     The table ends at the first line that does not start with "|".
+ *
+ *     Each row is matched when the parser reaches the start of its line,
+ *     by looking only at that line; only the number of columns is kept.
+ *     Its bars are turned into `COMP_BEGIN_ROW`, `COMP_CELL`,
+ *     and `COMP_END_ROW` tokens in place. Bars beyond the last column
+ *     are left as text, in the last cell.
+ *     Each "\|" is turned into a single `COMP_PIPE` token.
+ *     The separator row is turned into a `COMP_BEGIN_TABLE` token,
+ *     followed by a `COMP_COLUMN` token for each column,
+ *     and moved before the header row.
+ *     A `COMP_END_TABLE` token is inserted before the newline
+ *     that ends the last row.
+ *
+ *     Tables are recognized before the other patterns see a line,
+ *     so this pattern should come first in the parser.
+ *
+ */
+class table : public pattern {
+   private:
+    /**
+     * @brief The number of token nodes this pattern has allocated itself.
+     * @details That many removed tokens are kept between documents,
+     *     so that rows can be ended where no tokens are removed
+     *     without allocating again.
+     *
+     */
+    std::size_t _owned = 0;
+
+    /**
+     * @brief The number of columns of the open table, or 0 outside of one.
+     *
+     */
+    std::size_t _columns = 0;
+
+    /**
+     * @brief Inserts the given token before the given position.
+     *
+     * @param tokens The list of tokens.
+     * @param position The position to insert before.
+     * @param t The token to insert.
+     * @return The position of the inserted token.
+     */
+    token_list::iterator _insert(token_list &tokens,
+                                 token_list::iterator position, token t);
+
+    /**
+     * @brief Counts the cells of a row, and optionally marks them.
+     *
+     * @param tokens The list of tokens.
+     * @param position The "|" that starts the row.
+     * @param cells Receives the number of cells.
+     * @param mark Whether to turn the bars into row and cell tokens,
+     *     for a table of `_columns` columns.
+     * @return The end of the row's line: its newline, or the end of input.
+     */
+    token_list::iterator _row(token_list &tokens, token_list::iterator position,
+                              std::size_t &cells, bool mark);
+
+    /**
+     * @brief Reads a separator row, and optionally rewrites it.
+     *
+     * @param tokens The list of tokens.
+     * @param position The "|" that starts the row.
+     * @param columns Receives the number of columns,
+     *     or 0 if the line is not a separator row.
+     * @param rewrite Whether to rewrite the first tokens of the row
+     *     as a `COMP_BEGIN_TABLE` token and its `COMP_COLUMN` tokens.
+     * @return The end of the row's line, if it is a separator row.
+     */
+    token_list::iterator _separator(token_list &tokens,
+                                    token_list::iterator position,
+                                    std::size_t &columns, bool rewrite);
+
+   public:
+    using pattern::pattern;
+
+    /**
+     * @brief Reports whether this pattern is usable in the current state.
+     * @details Tables are not recognized in math or verbatim text.
+     *
+     * @return True outside of math and verbatim text.
+     */
+    [[nodiscard]] bool usable() const override;
+
+    void reset() override;
+
+    /**
+     * @brief Opens, continues, or closes a table at the start of a line.
+     *
+     * @param tokens The list of tokens.
+     * @param position The current position in the list.
+     * @return The new position in the list.
+     */
+    token_list::iterator match(token_list &tokens,
+                               token_list::iterator position) override;
+
+    /**
+     * @brief Closes the table still open at the end of the input.
+     *
+     * @param tokens The list of tokens.
+     */
+    void finish(token_list &tokens) override;
+
+    /**
+     * @brief Hands back the removed tokens beyond the `_owned` it keeps.
+     *
+     * @param spare The list to move the nodes onto the end of.
+     */
+    void recycle(token_list &spare) override;
+};
+
+}  // namespace sparkdown
+
+#endif
@@ -0,0 +1,200 @@
+/**
+ * @file parser/patterns/table.tests.cpp
+ * @package //parser/patterns:table.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `table` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `table` class,
+ *     which is the pattern-matching rule for pipe tables.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunknown-pragmas"
+#pragma ide diagnostic ignored "UnusedLocalVariable"
+
+#include "table.hpp"
+
+#include <gtest/gtest.h>
+
+#include "parser/parser.hpp"
+#include "parser/patterns/list.hpp"
+
+/**
+ * @brief Parses the given string with the `table` pattern,
+ *     and writes the result back out as text.
+ * @details The table tokens are written as HTML-like tags,
+ *     and the column alignments as their letters,
+ *     so that the expected results are easy to read.
+ *
+ * @param parser The parser to use.
+ * @param str The string to parse.
+ * @return The parsed text.
+ */
+template <class parser_type>
+static std::string parse(parser_type &parser, const std::string &str) {
+    sparkdown::token_list tokens(str.begin(), str.end());
+    parser.reset();
+    parser.parse(tokens);
+
+    std::string result;
+    for (const sparkdown::token &t : tokens) {
+        switch (t.type) {
+            case sparkdown::token_type::COMP_BEGIN_TABLE:
+                result += "<table>";
+                break;
+            case sparkdown::token_type::COMP_COLUMN:
+                result += t.value;
+                break;
+            case sparkdown::token_type::COMP_BEGIN_ROW:
+                result += "<tr>";
+                break;
+            case sparkdown::token_type::COMP_CELL:
+                result += "<td>";
+                break;
+            case sparkdown::token_type::COMP_END_ROW:
+                result += "</tr>";
+                break;
+            case sparkdown::token_type::COMP_PIPE:
+                result += "<bar>";
+                break;
+            case sparkdown::token_type::COMP_END_TABLE:
+                result += "</table>";
+                break;
+            case sparkdown::token_type::COMP_BEGIN_ITEMIZE:
+                result += "<ul>";
+                break;
+            case sparkdown::token_type::COMP_END_ITEMIZE:
+                result += "</ul>";
+                break;
+            case sparkdown::token_type::COMP_ITEM:
+                result += "<li>";
+                break;
+            default:
+                result += t.value;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Ensures that a table is matched, and ends at the first line
+ *     that is not a row, or at the end of the input.
+ *
+ */
+TEST(table, rows) {
+    sparkdown::parser<sparkdown::table> parser;
+
+    EXPECT_EQ(parse(parser,
+                    "| a | b |\n|---|---|\n| 1 | 2 |\n| 3 | 4 |\nafter"),
+              "<table>ll<tr> a <td> b </tr>\n<tr> 1 <td> 2 </tr>\n"
+              "<tr> 3 <td> 4 </tr></table>\nafter");
+    EXPECT_EQ(parse(parser, "|a|b|\n|-|-|\n|1|2|\n"),
+              "<table>ll<tr>a<td>b</tr>\n<tr>1<td>2</tr></table>\n");
+    EXPECT_EQ(parse(parser, "|a|b|\n|-|-|"),
+              "<table>ll<tr>a<td>b</tr></table>\n");
+    EXPECT_EQ(parse(parser, "before\n|a|\n|-|\n\n|b|\n"),
+              "before\n<table>l<tr>a</tr></table>\n\n|b|\n");
+}
+
+/**
+ * @brief Ensures that tables are matched with "\r\n" line endings,
+ *     and that each line keeps its "\r\n" but for the separator row.
+ *
+ */
+TEST(table, crlf) {
+    sparkdown::parser<sparkdown::table> parser;
+
+    EXPECT_EQ(parse(parser, "|a|b|\r\n|---|:-:|\r\n| 1 | 2\r\nafter"),
+              "<table>lc<tr>a<td>b</tr>\r\n<tr> 1 <td> 2</tr></table>\r\n"
+              "after");
+    EXPECT_EQ(parse(parser, "|a|\r\n|-|\r\n|1|\r\n"),
+              "<table>l<tr>a</tr>\r\n<tr>1</tr></table>\r\n");
+}
+
+/**
+ * @brief Ensures that the separator row sets each column's alignment.
+ *
+ */
+TEST(table, alignment) {
+    sparkdown::parser<sparkdown::table> parser;
+
+    EXPECT_EQ(parse(parser, "|a|b|c|d|\n| --- |:--|--:| :-: |\n"),
+              "<table>llrc<tr>a<td>b<td>c<td>d</tr></table>\n");
+}
+
+/**
+ * @brief Ensures that a missing final bar ends the row at its newline,
+ *     that escaped bars become single tokens while other escapes are left
+ *     alone, and that extra bars stay in the last cell.
+ *
+ */
+TEST(table, cells) {
+    sparkdown::parser<sparkdown::table> parser;
+
+    EXPECT_EQ(parse(parser, "| a | b\n|---|---\n| 1 | 2\n"),
+              "<table>ll<tr> a <td> b</tr>\n<tr> 1 <td> 2</tr></table>\n");
+    EXPECT_EQ(parse(parser, "|a|b|\n|-|-|\n|\\|x|y\\||\n"),
+              "<table>ll<tr>a<td>b</tr>\n<tr><bar>x<td>y<bar></tr></table>\n");
+    EXPECT_EQ(parse(parser, "|a\\*|b|\n|-|-|\n"),
+              "<table>ll<tr>a\\*<td>b</tr></table>\n");
+    EXPECT_EQ(parse(parser, "|a|b|\n|-|-|\n|1|2|3|\n|4|\n"),
+              "<table>ll<tr>a<td>b</tr>\n<tr>1<td>2|3</tr>\n"
+              "<tr>4</tr></table>\n");
+}
+
+/**
+ * @brief Ensures that lines that only look like tables are left alone.
+ *
+ */
+TEST(table, non_tables) {
+    sparkdown::parser<sparkdown::table> parser;
+
+    for (const char *text :
+         {"|a|", "|a|\nb", "|a|b|\n|-|\n", "|a|\n|x|\n", "|a|\n|::-|\n",
+          "|a|\n|-:-|\n", "|a|\n |-|\n", "a |b|\n|-|\n", "|a|\n|-|-\n"}) {
+        EXPECT_EQ(parse(parser, text), text) << text;
+    }
+}
+
+/**
+ * @brief Ensures that a table closes the lists above it,
+ *     and that a list after it opens after the table is closed.
+ *
+ */
+TEST(table, lists) {
+    sparkdown::parser<sparkdown::table, sparkdown::list> parser;
+
+    EXPECT_EQ(parse(parser, "* a\n|b|\n|-|\n* c\n"),
+              "<ul><li>a\n</ul><table>l<tr>b</tr></table>\n<ul><li>c\n</ul>");
+}
+
+/**
+ * @brief Ensures that the work done is linear in the size of the input,
+ *     even for a long table.
+ *
+ */
+TEST(table, linear) {
+    sparkdown::parser<sparkdown::table> parser;
+
+    std::string text = "| n | square\n|--:|:--\n";
+    for (std::size_t i = 0; i < 10000; i++) {
+        text += "| " + std::to_string(i) + " | " + std::to_string(i * i) + "\n";
+    }
+
+    std::string parsed = parse(parser, text);
+    EXPECT_LE(parser.get_state().visits(), 3 * text.size());
+
+    std::size_t rows = 0;
+    for (std::size_t i = 0; (i = parsed.find("</tr>", i)) != std::string::npos;
+         i++) {
+        rows++;
+    }
+    EXPECT_EQ(rows, 10001);
+}
+
+#pragma clang diagnostic pop
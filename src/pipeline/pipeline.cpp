@@ -0,0 +1,155 @@
+/**
+ * @file pipeline/pipeline.cpp
+ * @package //pipeline:pipeline
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `pipeline` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `pipeline` class,
+ *     which reads, transpiles, and writes a document all at once,
+ *     each on its own thread.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "pipeline.hpp"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "spsc_queue.hpp"
+#include "trace/trace.hpp"
+
+namespace sparkdown {
+
+namespace {
+
+/**
+ * @brief Reads as much of the given input as is ready, up to a limit.
+ * @details Waits for at least one byte, but then takes only the bytes
+ *     that are ready, so that a pipe fed a line at a time
+ *     is passed on a line at a time, rather than once a whole block is in.
+ *
+ * @param input The input. Its end-of-file flag is set at the end.
+ * @param data Receives the bytes.
+ * @param limit The most bytes to read.
+ * @return The number of bytes read; zero at the end of the input.
+ */
+std::size_t read_some(std::istream &input, char *data, std::size_t limit) {
+    std::streambuf *buffer = input.rdbuf();
+    if (!input || !buffer ||
+        buffer->sgetc() == std::char_traits<char>::eof()) {
+        input.setstate(std::ios::eofbit);
+        return 0;
+    }
+    std::streamsize ready = std::max<std::streamsize>(buffer->in_avail(), 1);
+    std::streamsize count = buffer->sgetn(
+        data, std::min(ready, static_cast<std::streamsize>(limit)));
+    return static_cast<std::size_t>(count);
+}
+
+}  // namespace
+
+pipeline::pipeline(module_cache &modules, std::size_t block,
+                   std::size_t depth)
+    : _modules(&modules), _block(block), _depth(depth), _stats(nullptr) {}
+
+void pipeline::set_stats(compile_stats *stats) { this->_stats = stats; }
+
+compile_status pipeline::run(std::istream &input,
+                             const std::filesystem::path &directory,
+                             std::ostream &output) {
+    spsc_queue<std::string> chunks(this->_depth);
+    spsc_queue<std::string> results(this->_depth);
+
+    // Each stage thread records into its own statistics,
+    // which are added to `_stats` once the threads are joined.
+    phase_stats reading;
+    phase_stats writing;
+
+    std::thread reader([&] {
+        std::string pending;
+        // The scan for a cut resumes here; see `compiler::boundary()`.
+        std::size_t resume = 0;
+        // The number of bytes pending at the last scan.
+        std::size_t scanned = 0;
+        while (true) {
+            std::size_t size = pending.size();
+            pending.resize(size + this->_block);
+            std::size_t count;
+            {
+                SPARKDOWN_TRACE_SPAN("pipeline", "read");
+                phase_timer timer(&reading);
+                count = read_some(input, pending.data() + size, this->_block);
+            }
+            pending.resize(size + count);
+            if (count == 0) break;
+
+            // A scan goes over the new bytes, and again over those
+            // after `resume`. It waits until there are at least as many
+            // new bytes as old, however short the reads,
+            // so that each byte is scanned a bounded number of times.
+            if (pending.size() - scanned < scanned - resume) continue;
+
+            std::size_t cut = compiler::boundary(pending, resume);
+            scanned = pending.size();
+            if (cut == 0) continue;
+            if (!chunks.push(pending.substr(0, cut))) return;
+            pending.erase(0, cut);
+            resume = resume > cut ? resume - cut : 0;
+            scanned -= cut;
+        }
+        if (!pending.empty()) chunks.push(std::move(pending));
+        chunks.close();
+    });
+
+    std::thread writer([&] {
+        std::string latex;
+        while (results.pop(latex)) {
+            SPARKDOWN_TRACE_SPAN("pipeline", "write");
+            phase_timer timer(&writing);
+            output.write(latex.data(),
+                         static_cast<std::streamsize>(latex.size()));
+            // Each chunk is passed on at once, rather than held in a buffer,
+            // so that a reader at the other end of a pipe sees it.
+            output.flush();
+            if (!output) {
+                // Take no more, so that the transpiler stops too.
+                results.close();
+                return;
+            }
+        }
+    });
+
+    compile_status status = COMPILE_OK;
+    std::string chunk;
+    std::string latex;
+    while (chunks.pop(chunk)) {
+        {
+            SPARKDOWN_TRACE_SPAN("pipeline", "compile");
+            status = this->_modules->compile(chunk, directory, latex);
+        }
+        if (status != COMPILE_OK || !results.push(std::move(latex))) break;
+        latex.clear();
+    }
+
+    // Stops the reader early, if it is not done already.
+    chunks.close();
+    results.close();
+    reader.join();
+    writer.join();
+
+    if (this->_stats) {
+        this->_stats->read += reading;
+        this->_stats->write += writing;
+    }
+    return status;
+}
+
+}  // namespace sparkdown
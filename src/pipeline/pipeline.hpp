@@ -0,0 +1,137 @@
+/**
+ * @file pipeline/pipeline.hpp
+ * @package //pipeline:pipeline
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `pipeline` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `pipeline` class,
+ *     which reads, transpiles, and writes a document all at once,
+ *     each on its own thread.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <istream>
+#include <ostream>
+
+#include "compiler/compiler.hpp"
+#include "module_cache/module_cache.hpp"
+#include "stats/stats.hpp"
+
+namespace sparkdown {
+
+/**
+ * @brief Reads, transpiles, and writes a document as three stages
+ *     that run at the same time.
+ * @details The input is read in blocks on a reader thread,
+ *     and cut into chunks at `compiler::boundary()`,
+ *     so that each chunk can be transpiled on its own.
+ *     The chunks are transpiled on the calling thread,
+ *     and the LaTeX code of each is written on a writer thread.
+ *     The stages are joined by `spsc_queue`s of a few chunks each,
+ *     so a slow stage holds the others back rather than letting
+ *     the chunks pile up in memory.
+ *
+ *     A slow disk or output pipe thus overlaps with the CPU work,
+ *     and the time taken approaches that of the slowest stage
+ *     rather than the sum of all three.
+ *     The output is the same as transpiling the whole document at once.
+ *
+ *     Lexing, parsing, and emitting share the middle stage:
+ *     they rewrite one token list in place,
+ *     which is cheaper than handing it from thread to thread.
+ *
+ *     Each read takes only the bytes that are ready, and the LaTeX code
+ *     of each chunk is flushed once it is written, so a pipe fed
+ *     a block at a time gives its LaTeX code a block at a time.
+ *     (A block is passed on once the next one starts, or the input ends.)
+ *     The memory held is bounded by the queues, plus the longest stretch
+ *     of the input with no cut, such as a single long list.
+ *     Each scan resumes where the last one left off,
+ *     going back over at most the last line or an unclosed region,
+ *     and waits until as many new bytes have been read
+ *     as it would go back over, however short the reads are.
+ *     So a long stretch is scanned a bounded number of times per byte.
+ *
+ */
+class pipeline {
+   private:
+    /**
+     * @brief Transpiles each chunk, and the files it includes.
+     *
+     */
+    module_cache *_modules;
+
+    /**
+     * @brief The number of bytes to read at a time.
+     *
+     */
+    std::size_t _block;
+
+    /**
+     * @brief The most chunks each queue may hold.
+     *
+     */
+    std::size_t _depth;
+
+    /**
+     * @brief Receives the statistics of each run. May be null.
+     *
+     */
+    compile_stats *_stats;
+
+   public:
+    /**
+     * @brief Constructor.
+     *
+     * @param modules Transpiles each chunk. It must outlive the pipeline.
+     * @param block The number of bytes to read at a time.
+     * @param depth The most chunks each queue may hold.
+     */
+    explicit pipeline(module_cache &modules, std::size_t block = 1 << 16,
+                      std::size_t depth = 8);
+
+    pipeline(const pipeline &) = delete;
+    pipeline &operator=(const pipeline &) = delete;
+
+    /**
+     * @brief Sets the statistics that each run adds to.
+     * @details Records the reading of the input and the writing
+     *     of the output, once each run is done.
+     *     The transpiling is recorded by the module cache's
+     *     own statistics, which are usually the same.
+     *
+     * @param stats The statistics, or null to stop recording.
+     */
+    void set_stats(compile_stats *stats);
+
+    /**
+     * @brief Transpiles the given input into LaTeX code.
+     * @details Returns once the whole input has been read,
+     *     and all of its LaTeX code has been written.
+     *
+     *     If a chunk fails, reading stops, and the LaTeX code
+     *     of the chunks before it is still written.
+     *     Read and write errors are left in the state of the streams.
+     *
+     * @param input The stream to read the Sparkdown text from.
+     * @param directory The directory to resolve includes against.
+     * @param output The stream to write the LaTeX code to.
+     * @return `COMPILE_OK` on success; otherwise, the reason for failure.
+     */
+    compile_status run(std::istream &input,
+                       const std::filesystem::path &directory,
+                       std::ostream &output);
+};
+
+}  // namespace sparkdown
+
+#endif
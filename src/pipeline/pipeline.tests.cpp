@@ -0,0 +1,306 @@
+/**
+ * @file pipeline/pipeline.tests.cpp
+ * @package //pipeline:pipeline.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `pipeline` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `pipeline` class,
+ *     which reads, transpiles, and writes a document all at once,
+ *     each on its own thread.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunknown-pragmas"
+#pragma ide diagnostic ignored "UnusedLocalVariable"
+
+#include "pipeline.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <sstream>
+
+#include "corpus/corpus.hpp"
+
+/**
+ * @brief Transpiles the given text with a pipeline.
+ *
+ * @param text The Sparkdown text.
+ * @param block The number of bytes to read at a time.
+ * @param latex Receives the LaTeX code.
+ * @param directory The directory to resolve includes against.
+ * @return The status of the run.
+ */
+static sparkdown::compile_status run(
+    const std::string &text, std::size_t block, std::string &latex,
+    const std::filesystem::path &directory = ".") {
+    sparkdown::module_cache modules;
+    sparkdown::pipeline pipeline(modules, block, 2);
+    std::istringstream input(text);
+    std::ostringstream output;
+    sparkdown::compile_status status = pipeline.run(input, directory, output);
+    latex = output.str();
+    return status;
+}
+
+/**
+ * @brief Transpiles the given text all at once.
+ *
+ * @param text The Sparkdown text.
+ * @param directory The directory to resolve includes against.
+ * @return The LaTeX code.
+ */
+static std::string whole(const std::string &text,
+                         const std::filesystem::path &directory = ".") {
+    sparkdown::module_cache modules;
+    std::string latex;
+    EXPECT_EQ(modules.compile(text, directory, latex), sparkdown::COMPILE_OK);
+    return latex;
+}
+
+/**
+ * @brief Output test.
+ * @details Ensures that realistic documents, cut into many chunks,
+ *     are transpiled just as they are all at once.
+ *
+ */
+TEST(pipeline, matches_whole) {
+    for (std::uint64_t seed = 1; seed <= 3; seed++) {
+        const std::string document = sparkdown::corpus(seed).generate(64 << 10);
+        for (std::size_t block : {std::size_t(1) << 8, std::size_t(1) << 16}) {
+            std::string latex;
+            ASSERT_EQ(run(document, block, latex), sparkdown::COMPILE_OK);
+            EXPECT_EQ(latex, whole(document))
+                << "seed " << seed << ", block " << block;
+        }
+    }
+}
+
+/**
+ * @brief Cutless input test.
+ * @details Ensures that a document that can never be cut,
+ *     such as a single long list, is transpiled whole.
+ *
+ */
+TEST(pipeline, no_boundaries) {
+    std::string document;
+    for (int i = 0; i < 1000; i++) document += "* An item\n  more text\n";
+
+    std::string latex;
+    ASSERT_EQ(run(document, 16, latex), sparkdown::COMPILE_OK);
+    EXPECT_EQ(latex, whole(document));
+}
+
+/**
+ * @brief Failure test.
+ * @details Ensures that a failing chunk fails the run,
+ *     and that the chunks before it are still written.
+ *
+ */
+TEST(pipeline, failure) {
+    std::string latex;
+    EXPECT_EQ(run("a\nb\n$c\nd", 2, latex),
+              sparkdown::COMPILE_UNTERMINATED_MATH);
+    EXPECT_EQ(latex, "a\nb\n");
+
+    EXPECT_EQ(run("", 2, latex), sparkdown::COMPILE_OK);
+    EXPECT_EQ(latex, "");
+}
+
+/**
+ * @brief Include test.
+ * @details Ensures that includes are resolved against the given directory.
+ *
+ */
+TEST(pipeline, includes) {
+    std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "sparkdown-pipeline-include";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "part._", std::ios::binary) << "# Part\n";
+
+    const std::string document = "a\n$include: part._\nb\n";
+    std::string latex;
+    ASSERT_EQ(run(document, 4, latex, dir), sparkdown::COMPILE_OK);
+    EXPECT_EQ(latex, whole(document, dir));
+    EXPECT_NE(latex.find("\\section{Part}"), std::string::npos);
+}
+
+/**
+ * @brief `pipeline#set_stats()` test.
+ * @details Ensures that the reads and writes are recorded,
+ *     alongside the module cache's own statistics.
+ *
+ */
+TEST(pipeline, set_stats) {
+    const std::string document = sparkdown::corpus(1).generate(16 << 10);
+
+    sparkdown::compile_stats stats;
+    sparkdown::module_cache modules;
+    modules.set_stats(&stats);
+    sparkdown::pipeline pipeline(modules, 1 << 10);
+    pipeline.set_stats(&stats);
+
+    std::istringstream input(document);
+    std::ostringstream output;
+    ASSERT_EQ(pipeline.run(input, ".", output), sparkdown::COMPILE_OK);
+
+    EXPECT_EQ(stats.bytes_in, document.size());
+    EXPECT_EQ(stats.bytes_out, output.str().size());
+    EXPECT_GT(stats.read.wall_seconds, 0);
+    EXPECT_GT(stats.write.wall_seconds, 0);
+}
+
+/**
+ * @brief A stream buffer that gives the first part of its text,
+ *     then waits until it is told to go on before giving the rest,
+ *     as a pipe from a slow writer would.
+ *
+ */
+class paused_input : public std::streambuf {
+   private:
+    std::string _first;
+    std::string _rest;
+    std::shared_future<void> _resume;
+    bool _paused = false;
+
+   protected:
+    int_type underflow() override {
+        if (this->gptr() != this->egptr()) return *this->gptr();
+        if (this->_paused || this->_rest.empty()) return traits_type::eof();
+        if (this->eback() == nullptr) {
+            this->setg(this->_first.data(), this->_first.data(),
+                       this->_first.data() + this->_first.size());
+            return *this->gptr();
+        }
+        this->_paused = true;
+        this->resumed = this->_resume.wait_for(std::chrono::seconds(10)) ==
+                        std::future_status::ready;
+        this->setg(this->_rest.data(), this->_rest.data(),
+                   this->_rest.data() + this->_rest.size());
+        return *this->gptr();
+    }
+
+   public:
+    /**
+     * @brief Whether it was told to go on, rather than timing out.
+     *
+     */
+    bool resumed = false;
+
+    paused_input(std::string first, std::string rest,
+                 std::shared_future<void> resume)
+        : _first(std::move(first)),
+          _rest(std::move(rest)),
+          _resume(std::move(resume)) {}
+};
+
+/**
+ * @brief A stream buffer that gives its text a few bytes at a time,
+ *     as a pipe from a slow writer would, so every read is short.
+ *
+ */
+class trickled_input : public std::streambuf {
+   private:
+    std::string _text;
+    std::size_t _step;
+    std::size_t _given = 0;
+
+   protected:
+    int_type underflow() override {
+        if (this->gptr() != this->egptr()) return *this->gptr();
+        if (this->_given == this->_text.size()) return traits_type::eof();
+        std::size_t size =
+            std::min(this->_step, this->_text.size() - this->_given);
+        char *start = this->_text.data() + this->_given;
+        this->setg(start, start, start + size);
+        this->_given += size;
+        return *this->gptr();
+    }
+
+   public:
+    trickled_input(std::string text, std::size_t step)
+        : _text(std::move(text)), _step(step) {}
+};
+
+/**
+ * @brief Short read test.
+ * @details Ensures that input given a few bytes at a time,
+ *     both realistic and with no cut for a long stretch,
+ *     is transpiled just as it is all at once.
+ *
+ */
+TEST(pipeline, short_reads) {
+    std::string list = "a\n";
+    for (int i = 0; i < 2000; i++) list += "* An item\n  more text\n";
+    list += "b\n";
+
+    for (const std::string &document :
+         {sparkdown::corpus(4).generate(64 << 10), list}) {
+        trickled_input source(document, 7);
+        std::istream input(&source);
+        std::ostringstream output;
+
+        sparkdown::module_cache modules;
+        sparkdown::pipeline pipeline(modules, 1 << 12, 2);
+        ASSERT_EQ(pipeline.run(input, ".", output), sparkdown::COMPILE_OK);
+        EXPECT_EQ(output.str(), whole(document));
+    }
+}
+
+/**
+ * @brief A string buffer that says when it is first flushed with text.
+ *
+ */
+class flushed_output : public std::stringbuf {
+   private:
+    std::promise<void> *_flushed;
+
+   protected:
+    int sync() override {
+        if (this->_flushed && !this->str().empty()) {
+            this->_flushed->set_value();
+            this->_flushed = nullptr;
+        }
+        return 0;
+    }
+
+   public:
+    explicit flushed_output(std::promise<void> &flushed)
+        : _flushed(&flushed) {}
+};
+
+/**
+ * @brief Streaming test.
+ * @details Ensures that the LaTeX code of each block read so far
+ *     is written and flushed while the rest of the input is still to come,
+ *     as when Sparkdown is a filter between two pipes.
+ *
+ */
+TEST(pipeline, streams) {
+    const std::string first = "# One\nfirst\n\n# Two\n";
+    const std::string rest = "second\n";
+
+    std::promise<void> flushed;
+    paused_input source(first, rest, flushed.get_future().share());
+    flushed_output sink(flushed);
+    std::istream input(&source);
+    std::ostream output(&sink);
+
+    sparkdown::module_cache modules;
+    sparkdown::pipeline pipeline(modules);
+    ASSERT_EQ(pipeline.run(input, ".", output), sparkdown::COMPILE_OK);
+
+    EXPECT_TRUE(source.resumed);
+    EXPECT_EQ(sink.str(), whole(first + rest));
+}
+
+#pragma clang diagnostic pop
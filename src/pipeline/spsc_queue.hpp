@@ -0,0 +1,212 @@
+/**
+ * @file pipeline/spsc_queue.hpp
+ * @package //pipeline:spsc_queue
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `spsc_queue` class definition and implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines and implements the `spsc_queue` class,
+ *     a bounded lock-free queue between one producer thread
+ *     and one consumer thread.
+ *
+ *     Note that this file contains both the definition and the implementation,
+ *     because the C++ standard requires that templated method implementations
+ *     be done in the header file.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sparkdown {
+
+/**
+ * @brief A bounded lock-free queue between one producer thread
+ *     and one consumer thread.
+ * @details The values are kept in a ring of slots.
+ *     The producer only writes the tail, and the consumer only the head,
+ *     so neither ever waits on a lock.
+ *
+ *     The blocking `push()` and `pop()` wait while the queue is full
+ *     or empty, which gives the producer backpressure:
+ *     it can run at most `capacity()` values ahead of the consumer.
+ *     A waiting thread yields at first, then sleeps briefly between checks,
+ *     so that a stage waiting on a slow disk does not take a core.
+ *
+ *     Either side may `close()` the queue: the producer when it is done,
+ *     or the consumer when it will take no more values.
+ *
+ */
+template <class T>
+class spsc_queue {
+   private:
+    /**
+     * @brief The slots of the ring.
+     * @details Its size is a power of two.
+     *
+     */
+    std::vector<T> _slots;
+
+    /**
+     * @brief The size of the ring, less one, for masking positions.
+     *
+     */
+    std::size_t _mask;
+
+    /**
+     * @brief The number of values popped so far. Written by the consumer.
+     *
+     */
+    alignas(64) std::atomic<std::size_t> _head;
+
+    /**
+     * @brief The number of values pushed so far. Written by the producer.
+     *
+     */
+    alignas(64) std::atomic<std::size_t> _tail;
+
+    /**
+     * @brief Whether the queue has been closed.
+     *
+     */
+    alignas(64) std::atomic<bool> _closed;
+
+    /**
+     * @brief Waits a little before the caller checks the queue again.
+     *
+     * @param attempts The number of checks so far.
+     */
+    static void _wait(unsigned attempts) {
+        if (attempts < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+   public:
+    /**
+     * @brief Constructor.
+     *
+     * @param capacity The most values the queue may hold at once.
+     *     Rounded up to a power of two.
+     */
+    explicit spsc_queue(std::size_t capacity)
+        : _head(0), _tail(0), _closed(false) {
+        std::size_t size = 1;
+        while (size < capacity) size *= 2;
+        this->_slots.resize(size);
+        this->_mask = size - 1;
+    }
+
+    spsc_queue(const spsc_queue &) = delete;
+    spsc_queue &operator=(const spsc_queue &) = delete;
+
+    /**
+     * @brief Returns the most values the queue may hold at once.
+     *
+     * @return The capacity.
+     */
+    [[nodiscard]] std::size_t capacity() const { return this->_slots.size(); }
+
+    /**
+     * @brief Moves the given value onto the queue, unless it is full.
+     * @details Called by the producer only.
+     *
+     * @param value The value. Left as it was if the queue is full.
+     * @return True if the value was pushed.
+     */
+    bool try_push(T &value) {
+        std::size_t tail = this->_tail.load(std::memory_order_relaxed);
+        if (tail - this->_head.load(std::memory_order_acquire) ==
+            this->_slots.size()) {
+            return false;
+        }
+        this->_slots[tail & this->_mask] = std::move(value);
+        this->_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Moves the given value onto the queue,
+     *     waiting while the queue is full.
+     * @details Called by the producer only.
+     *
+     * @param value The value.
+     * @return True if the value was pushed;
+     *     false if the queue was closed first.
+     */
+    bool push(T value) {
+        for (unsigned attempts = 0; !this->closed(); attempts++) {
+            if (this->try_push(value)) return true;
+            _wait(attempts);
+        }
+        return false;
+    }
+
+    /**
+     * @brief Moves the value at the front of the queue into the given one,
+     *     unless the queue is empty.
+     * @details Called by the consumer only.
+     *
+     * @param value Receives the value.
+     * @return True if a value was popped.
+     */
+    bool try_pop(T &value) {
+        std::size_t head = this->_head.load(std::memory_order_relaxed);
+        if (head == this->_tail.load(std::memory_order_acquire)) return false;
+        value = std::move(this->_slots[head & this->_mask]);
+        this->_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Moves the value at the front of the queue into the given one,
+     *     waiting while the queue is empty.
+     * @details Called by the consumer only.
+     *     The values pushed before the queue was closed are all popped.
+     *
+     * @param value Receives the value.
+     * @return True if a value was popped;
+     *     false if the queue is closed and empty.
+     */
+    bool pop(T &value) {
+        for (unsigned attempts = 0; !this->try_pop(value); attempts++) {
+            // The values pushed before closing are visible once it is seen.
+            if (this->closed()) return this->try_pop(value);
+            _wait(attempts);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Closes the queue.
+     * @details Later calls to `push()` fail,
+     *     and pops fail once the queue is empty.
+     *
+     */
+    void close() { this->_closed.store(true, std::memory_order_release); }
+
+    /**
+     * @brief Reports whether the queue has been closed.
+     *
+     * @return True if the queue has been closed.
+     */
+    [[nodiscard]] bool closed() const {
+        return this->_closed.load(std::memory_order_acquire);
+    }
+};
+
+}  // namespace sparkdown
+
+#endif
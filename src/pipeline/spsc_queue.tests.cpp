@@ -0,0 +1,96 @@
+/**
+ * @file pipeline/spsc_queue.tests.cpp
+ * @package //pipeline:spsc_queue.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `spsc_queue` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `spsc_queue` class,
+ *     a bounded lock-free queue between one producer thread
+ *     and one consumer thread.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunknown-pragmas"
+#pragma ide diagnostic ignored "UnusedLocalVariable"
+
+#include "spsc_queue.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+/**
+ * @brief Capacity test.
+ * @details Ensures that the capacity is rounded up to a power of two,
+ *     and that a full queue refuses more values.
+ *
+ */
+TEST(spsc_queue, capacity) {
+    sparkdown::spsc_queue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4);
+
+    for (int i = 0; i < 4; i++) {
+        int value = i;
+        EXPECT_TRUE(queue.try_push(value));
+    }
+    int extra = 4;
+    EXPECT_FALSE(queue.try_push(extra));
+    EXPECT_EQ(extra, 4);
+
+    int value = -1;
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(queue.try_push(extra));
+}
+
+/**
+ * @brief Close test.
+ * @details Ensures that the values pushed before closing are still popped,
+ *     and that pushes fail once the queue is closed.
+ *
+ */
+TEST(spsc_queue, close) {
+    sparkdown::spsc_queue<std::string> queue(2);
+    EXPECT_TRUE(queue.push("a"));
+    queue.close();
+    EXPECT_TRUE(queue.closed());
+
+    std::string value;
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, "a");
+    EXPECT_FALSE(queue.pop(value));
+    EXPECT_FALSE(queue.push("b"));
+}
+
+/**
+ * @brief Producer and consumer test.
+ * @details Passes many values through a small queue between two threads,
+ *     and ensures that they all arrive, in order.
+ *
+ */
+TEST(spsc_queue, threads) {
+    const int count = 100000;
+    sparkdown::spsc_queue<int> queue(8);
+
+    std::thread producer([&] {
+        for (int i = 0; i < count; i++) queue.push(i);
+        queue.close();
+    });
+
+    int expected = 0;
+    int value;
+    bool ordered = true;
+    while (queue.pop(value)) ordered = ordered && value == expected++;
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(expected, count);
+}
+
+#pragma clang diagnostic pop
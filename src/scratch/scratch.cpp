@@ -0,0 +1,45 @@
+/**
+ * @file scratch/scratch.cpp
+ * @package //scratch
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief Scratch files for tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file sets up and inspects the files of the tests
+ *     that touch the filesystem.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "scratch.hpp"
+
+#include <fstream>
+#include <iterator>
+
+namespace sparkdown::scratch {
+
+std::filesystem::path directory(const std::string &name) {
+    std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / ("sparkdown-" + name);
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+void write_file(const std::filesystem::path &path,
+                const std::string &contents) {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream(path, std::ios::binary) << contents;
+}
+
+std::string read_file(const std::filesystem::path &path) {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>()};
+}
+
+}  // namespace sparkdown::scratch
@@ -0,0 +1,55 @@
+/**
+ * @file scratch/scratch.hpp
+ * @package //scratch
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief Scratch files for tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file declares the functions that the tests of the libraries
+ *     that touch the filesystem share, to set up and inspect their files.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef SCRATCH_HPP
+#define SCRATCH_HPP
+
+#include <filesystem>
+#include <string>
+
+namespace sparkdown::scratch {
+
+/**
+ * @brief Creates an empty scratch directory for a test.
+ * @details The directory is named after the test, within the system's
+ *     temporary directory; anything left in it by an earlier run
+ *     is removed.
+ *
+ * @param name The name of the test, unique among all the tests.
+ * @return The path to the directory.
+ */
+std::filesystem::path directory(const std::string &name);
+
+/**
+ * @brief Writes the given contents to the given file,
+ *     creating its parent directories.
+ *
+ * @param path The file to write.
+ * @param contents The contents to write.
+ */
+void write_file(const std::filesystem::path &path,
+                const std::string &contents);
+
+/**
+ * @brief Reads the whole of the given file.
+ *
+ * @param path The file to read.
+ * @return The contents of the file.
+ */
+std::string read_file(const std::filesystem::path &path);
+
+}  // namespace sparkdown::scratch
+
+#endif
@@ -16,6 +16,10 @@
  *
  *             Optionally, the filename can be omitted and Sparkdown
  *             will read the file contents from stdin.
+ *             It then runs as a streaming filter, as with `--pipeline`:
+ *             the LaTeX code of each block is written as soon as
+ *             the block is read, and the whole document is never held
+ *             in memory, so `sparkdown < huge._ | other-tool` works.
  *
  *             Output is written to stdout by default.
  *
@@ -36,14 +40,124 @@
  *             Whenever `file._` is modified, Sparkdown will re-parse
  *             the file and write the output to the specified location.
  *
+ *         The argument `--cache` instructs Sparkdown to keep the parsed
+ *         contents of included files in the given directory,
+ *         so that files that have not changed are not parsed again.
+ *
+ *             `sparkdown file._ --cache .sparkdown-cache/`
+ *
+ *         The argument `--tree` instructs Sparkdown to transpile
+ *         every `._` file in the given directory tree.
+ *
+ *             `sparkdown --tree notes/ --out build/`
+ *
+ *             Each `notes/path/file._` is written to `build/path/file.tex`.
+ *             Only files that have changed since the last run are
+ *             transpiled, and the outputs of deleted files are removed.
+ *             `--tree` cannot be used with `--cache`, `--split`,
+ *             `--pipeline`, `--region`, `--stats`, or `--stats-json`.
+ *
+ *         The argument `--split` instructs Sparkdown to write the output
+ *         as a master file, plus one file per section,
+ *         rewriting only the sections that changed.
+ *
+ *             `sparkdown notes._ --out build/notes.tex --split`
+ *
+ *             The sections are written to `build/notes/`,
+ *             and included from `build/notes.tex` with `\include`.
+ *
+ *         The argument `--pipeline` instructs Sparkdown to read,
+ *         transpile, and write the file all at once, each on its own thread,
+ *         so that a slow disk or output pipe overlaps with the transpiling.
+ *
+ *             `cat notes._ | sparkdown --pipeline > notes.tex`
+ *
+ *             The output is the same, but the output file is written
+ *             as it is produced, rather than replaced once it is done.
+ *
+ *         The argument `--region` instructs Sparkdown to transpile
+ *         only the section that encloses the given line,
+ *         or the sections that enclose the given range of lines,
+ *         as a LaTeX fragment for a live preview.
+ *
+ *             `sparkdown notes._ --region 120`
+ *
+ *             `sparkdown notes._ --region 120-180 -o preview.tex`
+ *
+ *             A section runs from one headline to the next.
+ *             Its output is the same as the matching part
+ *             of the output of the whole file.
+ *
+ *         The argument `--stats` instructs Sparkdown to print
+ *         performance statistics to stderr once it is done:
+ *         the time spent in each phase, the bytes and tokens processed,
+ *         the number of allocations, and the peak memory usage.
+ *
+ *             `sparkdown file._ -o file.tex --stats`
+ *
+ *             `--stats-json` prints the same statistics as a JSON object.
+ *
+ *         The argument `--trace` instructs Sparkdown to record
+ *         where the time goes, and write it to the given file
+ *         as Chrome trace events, for the Perfetto UI or `chrome://tracing`.
+ *         It needs a build made with `bazel build --config=trace`.
+ *
+ *             `sparkdown --tree notes/ -o build/ --trace trace.json`
+ *
  * @license MIT <https://opensource.org/licenses/MIT>
  * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
  */
 
+#include <charconv>
+#include <cstddef>
 #include <iostream>
 
 #include "arg.h/arg.h"
 #include "sparkdown.hpp"
+#include "split/split.hpp"
+#include "trace/trace.hpp"
+#include "vault/vault.hpp"
+
+/**
+ * @brief Writes the recorded trace, if one was asked for.
+ *
+ * @param path The file to write to. May be empty.
+ * @return True on success.
+ */
+static bool write_trace(const std::string &path) {
+    if (path.empty()) return true;
+
+    sparkdown::trace::stop();
+    if (!sparkdown::trace::write(path)) {
+        std::cerr << "Error: could not write trace file \"" << path << "\"."
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Reads the argument of `--region`: a line, or a range of lines.
+ *
+ * @param text The argument, e.g. "120" or "120-180".
+ * @param first_line Set to the first line.
+ * @param last_line Set to the last line.
+ * @return True if the argument is valid.
+ */
+static bool parse_lines(const std::string &text, std::size_t &first_line,
+                        std::size_t &last_line) {
+    const char *begin = text.data();
+    const char *end = text.data() + text.size();
+    auto [next, error] = std::from_chars(begin, end, first_line);
+    if (error != std::errc() || first_line == 0) return false;
+    last_line = first_line;
+    if (next == end) return true;
+    if (*next != '-') return false;
+
+    auto [last, last_error] = std::from_chars(next + 1, end, last_line);
+    return last_error == std::errc() && last == end &&
+           last_line >= first_line;
+}
 
 /**
  * @brief Main program entry point.
@@ -53,6 +167,9 @@
  * @return 0 on success; 1 on failure.
  */
 int main(int argc, char **argv) {
+    // Lets stdin be read in blocks, and only as much as is ready.
+    std::ios::sync_with_stdio(false);
+
     argh arguments(argc, argv);
 
     if (arguments["-h"] || arguments["--help"]) {
@@ -74,6 +191,49 @@ int main(int argc, char **argv) {
                "and write the"
             << std::endl
             << "                             output to the proper location."
+            << std::endl
+            << std::endl
+            << "    --cache <directory>  --  Cache the parsed included files"
+            << std::endl
+            << "                             in the given directory."
+            << std::endl
+            << std::endl
+            << "    --tree <directory>   --  Transpile every file in the given"
+            << std::endl
+            << "                             directory tree into the output"
+            << std::endl
+            << "                             directory given by `--out`."
+            << std::endl
+            << std::endl
+            << "    --split              --  Write one file per section, "
+               "included by the"
+            << std::endl
+            << "                             output file. Only changed "
+               "sections are"
+            << std::endl
+            << "                             rewritten." << std::endl
+            << std::endl
+            << "    --pipeline           --  Read, transpile, and write at "
+               "once, each on"
+            << std::endl
+            << "                             its own thread." << std::endl
+            << std::endl
+            << "    --region <lines>     --  Transpile only the section "
+               "around the given"
+            << std::endl
+            << "                             line, or lines, e.g. `120` or "
+               "`120-180`."
+            << std::endl
+            << std::endl
+            << "    --stats              --  Print performance statistics to "
+               "stderr."
+            << std::endl
+            << "    --stats-json         --  Print performance statistics to "
+               "stderr, as JSON."
+            << std::endl
+            << std::endl
+            << "    --trace <file>       --  Write Chrome trace events to the "
+               "given file."
             << std::endl;
     }
 
@@ -89,7 +249,123 @@ int main(int argc, char **argv) {
     if (arguments["-o"]) output = arguments("-o");
     if (arguments["--out"]) output = arguments("--out");
 
+    std::string trace;
+    if (arguments["--trace"]) {
+        trace = arguments("--trace");
+        if (!sparkdown::trace::compiled_in()) {
+            std::cerr << "Error: this build of Sparkdown cannot trace; "
+                         "rebuild it with `--config=trace`. Exiting."
+                      << std::endl;
+            return 1;
+        }
+        sparkdown::trace::start();
+    }
+
+    if (arguments["--tree"]) {
+        if (output.empty()) {
+            std::cerr << "Error: `--tree` requires an output directory, "
+                         "given with `--out`. Exiting."
+                      << std::endl;
+            return 1;
+        }
+
+        // These options apply to a single input file, not to a tree.
+        for (const char *flag : {"--cache", "--split", "--pipeline",
+                                 "--region", "--stats", "--stats-json"}) {
+            if (!arguments[flag]) continue;
+            std::cerr << "Error: `--tree` cannot be used with `" << flag
+                      << "`. Exiting." << std::endl;
+            return 1;
+        }
+
+        sparkdown::vault vault(arguments("--tree"), output);
+        sparkdown::vault_report report = vault.build();
+
+        for (const auto &path : report.changed) {
+            std::cout << "Wrote " << path.string() << std::endl;
+        }
+        for (const auto &path : report.removed) {
+            std::cout << "Removed " << path.string() << std::endl;
+        }
+        for (const auto &[path, reason] : report.failed) {
+            std::cerr << "Error: " << path.string() << ": " << reason << "."
+                      << std::endl;
+        }
+
+        if (!write_trace(trace)) return 1;
+        return report.failed.empty() ? 0 : 1;
+    }
+
+    std::string cache;
+    if (arguments["--cache"]) cache = arguments("--cache");
+
     std::string input = arguments[1];
+    if (input == "-") input.clear();
+    if (output == "-") output.clear();
+
+    if (arguments["--split"] && output.empty()) {
+        std::cerr << "Error: `--split` requires an output file, "
+                     "given with `--out`. Exiting."
+                  << std::endl;
+        return 1;
+    }
 
-    sparkdown::sparkdown driver(input, output);
+    if (arguments["--split"] && arguments["--pipeline"]) {
+        std::cerr << "Error: `--split` cannot be used with `--pipeline`. "
+                     "Exiting."
+                  << std::endl;
+        return 1;
+    }
+
+    std::size_t first_line = 0;
+    std::size_t last_line = 0;
+    if (arguments["--region"]) {
+        std::string lines = arguments("--region");
+        if (!parse_lines(lines, first_line, last_line)) {
+            std::cerr << "Error: `--region` requires a line number, "
+                         "or a range such as `120-180`. Exiting."
+                      << std::endl;
+            return 1;
+        }
+        if (arguments["--split"] || arguments["--pipeline"]) {
+            std::cerr << "Error: `--region` cannot be used with `--split` "
+                         "or `--pipeline`. Exiting."
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    sparkdown::sparkdown driver(input, output, cache);
+    if (first_line > 0) {
+        driver.parse_region(first_line, last_line);
+        if (driver.save_latex_code() == sparkdown::WRITE_FAILED) return 1;
+    } else if (arguments["--pipeline"] ||
+               (input.empty() && !arguments["--split"])) {
+        driver.run_pipelined();
+    } else if (arguments["--split"]) {
+        driver.parse();
+        sparkdown::split_report report =
+            sparkdown::split(output).write(driver.get_latex_code());
+
+        for (const auto &path : report.changed) {
+            std::cout << "Wrote " << path.string() << std::endl;
+        }
+        for (const auto &path : report.removed) {
+            std::cout << "Removed " << path.string() << std::endl;
+        }
+        for (const auto &path : report.failed) {
+            std::cerr << "Error: could not write " << path.string() << "."
+                      << std::endl;
+        }
+        if (!report.failed.empty()) return 1;
+    } else {
+        driver.parse();
+        if (driver.save_latex_code() == sparkdown::WRITE_FAILED) return 1;
+    }
+    if (!write_trace(trace)) return 1;
+
+    if (arguments["--stats"]) std::cerr << driver.get_stats().to_text();
+    if (arguments["--stats-json"]) {
+        std::cerr << driver.get_stats().to_json() << std::endl;
+    }
 }
@@ -17,14 +17,23 @@
 
 #include "sparkdown.hpp"
 
+#include <fstream>
 #include <iostream>
+#include <iterator>
+
+#include "output/output.hpp"
+#include "pipeline/pipeline.hpp"
+#include "trace/trace.hpp"
 
 namespace sparkdown {
 
 sparkdown::sparkdown(const std::string &input_file,
-                     const std::string &output_file) {
-    this->_input_file = input_file;
-    this->_output_file = output_file;
+                     const std::string &output_file,
+                     const std::string &cache_directory)
+    : _input_file(input_file),
+      _output_file(output_file),
+      _modules(cache_directory, &this->_arena) {
+    this->_modules.set_stats(&this->_stats);
 
     if (!this->_input_file.empty()) {
         // Ensure that the input file, if given, exists:
@@ -53,30 +62,158 @@ sparkdown::sparkdown(const std::string &input_file,
 }
 
 void sparkdown::parse() {
-    // TODO: Implement.
+    compile_status status;
+    if (this->_input_file.empty()) {
+        std::string input;
+        {
+            SPARKDOWN_TRACE_SPAN("io", "read", "stdin");
+            phase_timer timer(&this->_stats.read);
+            input.assign(std::istreambuf_iterator<char>(std::cin),
+                         std::istreambuf_iterator<char>{});
+        }
+        status = this->_modules.compile(
+            input, std::filesystem::current_path(), this->_latex_code);
+    } else {
+        status = this->_modules.compile(
+            std::filesystem::path(this->_input_file), this->_latex_code);
+    }
+
+    if (status != COMPILE_OK) {
+        std::cerr << "Error: " << compiler::describe(status);
+        if (!this->_modules.error_path().empty()) {
+            std::cerr << " (" << this->_modules.error_path().string() << ")";
+        }
+        std::cerr << ". Exiting." << std::endl;
+        exit(1);
+    }
+}
+
+void sparkdown::parse_region(std::size_t first_line, std::size_t last_line) {
+    std::string input;
+    std::filesystem::path directory = std::filesystem::current_path();
+    {
+        SPARKDOWN_TRACE_SPAN("io", "read");
+        phase_timer timer(&this->_stats.read);
+        if (this->_input_file.empty()) {
+            input.assign(std::istreambuf_iterator<char>(std::cin),
+                         std::istreambuf_iterator<char>{});
+        } else {
+            std::ifstream file(this->_input_file, std::ios::binary);
+            if (!file) {
+                std::cerr << "Error: could not read the input file. Exiting."
+                          << std::endl;
+                exit(1);
+            }
+            input.assign(std::istreambuf_iterator<char>(file),
+                         std::istreambuf_iterator<char>{});
+            directory =
+                std::filesystem::absolute(this->_input_file).parent_path();
+        }
+    }
+
+    compile_status status = this->_modules.compile(
+        compiler::section(input, first_line, last_line), directory,
+        this->_latex_code);
+    if (status != COMPILE_OK) {
+        std::cerr << "Error: " << compiler::describe(status);
+        if (!this->_modules.error_path().empty()) {
+            std::cerr << " (" << this->_modules.error_path().string() << ")";
+        }
+        std::cerr << ". Exiting." << std::endl;
+        exit(1);
+    }
+}
+
+void sparkdown::run_pipelined() {
+    ::sparkdown::pipeline stages(this->_modules);
+    stages.set_stats(&this->_stats);
+
+    std::istream *input = &std::cin;
+    std::ifstream input_file;
+    std::filesystem::path directory = std::filesystem::current_path();
+    if (!this->_input_file.empty()) {
+        input_file.open(this->_input_file, std::ios::binary);
+        if (!input_file) {
+            std::cerr << "Error: could not read the input file. Exiting."
+                      << std::endl;
+            exit(1);
+        }
+        input = &input_file;
+        directory =
+            std::filesystem::absolute(this->_input_file).parent_path();
+    }
+
+    std::ostream *output = &std::cout;
+    std::ofstream output_file;
+    if (!this->_output_file.empty()) {
+        output_file.open(this->_output_file,
+                         std::ios::binary | std::ios::trunc);
+        if (!output_file) {
+            std::cerr << "Error: could not open the output file. Exiting."
+                      << std::endl;
+            exit(1);
+        }
+        output = &output_file;
+    }
+
+    compile_status status = stages.run(*input, directory, *output);
+    if (status != COMPILE_OK) {
+        std::cerr << "Error: " << compiler::describe(status);
+        if (!this->_modules.error_path().empty()) {
+            std::cerr << " (" << this->_modules.error_path().string() << ")";
+        }
+        std::cerr << ". Exiting." << std::endl;
+        exit(1);
+    }
+    if (input->bad()) {
+        std::cerr << "Error: could not read the input. Exiting." << std::endl;
+        exit(1);
+    }
+    if (!*output) {
+        std::cerr << "Error: could not write the output. Exiting."
+                  << std::endl;
+        exit(1);
+    }
 }
 
-std::string sparkdown::get_latex_code() const {
-    // TODO: Implement.
+std::string sparkdown::get_latex_code() const { return this->_latex_code; }
 
-    // Just to avoid compiler warnings:
-    return {};
+write_result sparkdown::save_latex_code() const {
+    if (this->_output_file.empty()) {
+        if (this->save_latex_code(std::cout)) return WRITE_CHANGED;
+        std::cerr << "Error: could not write the output." << std::endl;
+        return WRITE_FAILED;
+    }
+
+    return this->save_latex_code(this->_output_file);
 }
 
-void sparkdown::save_latex_code() const {
-    // TODO: Implement.
+write_result sparkdown::save_latex_code(const std::string &output) const {
+    return this->save_latex_code(std::filesystem::path(output));
 }
 
-void sparkdown::save_latex_code(const std::string &output) const {
-    // TODO: Implement.
+write_result sparkdown::save_latex_code(
+    const std::filesystem::path &output) const {
+    phase_timer timer(&this->_stats.write);
+    write_result result = ::sparkdown::output::write(output, this->_latex_code);
+    if (result == WRITE_FAILED) {
+        std::cerr << "Error: could not write output file " << output << "."
+                  << std::endl;
+    }
+
+    return result;
 }
 
-void sparkdown::save_latex_code(const std::filesystem::path &output) const {
-    // TODO: Implement.
+bool sparkdown::save_latex_code(std::ostream &output) const {
+    SPARKDOWN_TRACE_SPAN("io", "flush");
+    phase_timer timer(&this->_stats.write);
+    output << this->_latex_code << std::flush;
+    return static_cast<bool>(output);
 }
 
-void sparkdown::save_latex_code(std::ostream &output) const {
-    // TODO: Implement.
+const compile_stats &sparkdown::get_stats() const {
+    this->_stats.record_peak_rss();
+    return this->_stats;
 }
 
 std::string sparkdown::version() { return {SPARKDOWN_VERSION}; }
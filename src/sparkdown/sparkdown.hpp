@@ -16,16 +16,18 @@
 #ifndef SPARKDOWN_HPP
 #define SPARKDOWN_HPP
 
-/**
- * @brief Sparkdown current version information.
- *
- */
-#define SPARKDOWN_VERSION "v2.0.0"
-
+#include <cstddef>
 #include <filesystem>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
+#include "compiler/compiler.hpp"
+#include "module_cache/module_cache.hpp"
+#include "output/output.hpp"
+#include "stats/stats.hpp"
+#include "version.hpp"
+
 namespace sparkdown {
 
 /**
@@ -59,6 +61,36 @@ class sparkdown {
      */
     std::string _output_file;
 
+    /**
+     * @brief The arena that the token buffers of the document are drawn from.
+     * @details A driver transpiles a single document,
+     *     so its tokens are never freed one by one;
+     *     the arena releases them all at once.
+     *
+     */
+    std::pmr::monotonic_buffer_resource _arena;
+
+    /**
+     * @brief Transpiles the input and the files it includes.
+     * @details Kept between calls to `parse()`,
+     *     so that unchanged included files are not parsed again.
+     *
+     */
+    module_cache _modules;
+
+    /**
+     * @brief The LaTeX code produced by the last call to `parse()`.
+     *
+     */
+    std::string _latex_code;
+
+    /**
+     * @brief The performance statistics of every parse and save so far.
+     * @details Mutable so that the const save methods can record themselves.
+     *
+     */
+    mutable compile_stats _stats;
+
    public:
     //  ++====================++
     //  ||  Instance methods  ||
@@ -72,17 +104,48 @@ class sparkdown {
      * @param output_file The file path to the LaTeX output file. If left empty,
      *     the output will be written to stdout.
      *     Leave empty for manual output.
+     * @param cache_directory The directory in which to cache the parsed
+     *     included files between runs. Leave empty to cache in memory only.
      */
     explicit sparkdown(const std::string& input_file,
-                       const std::string& output_file = "");
+                       const std::string& output_file = "",
+                       const std::string& cache_directory = "");
 
     /**
      * @brief Parses the input file.
      * @details Saves the data in the class structure for later use.
+     *     If no input file was given, the input is read from stdin.
      *
      */
     void parse();
 
+    /**
+     * @brief Parses only the sections of the input file
+     *     that enclose the given lines, for a live preview.
+     * @details See `compiler::section()`. The LaTeX code is stored
+     *     as by `parse()`, and is the same as the matching part
+     *     of the code of the whole file, so the time taken
+     *     depends on the size of the sections, not of the file.
+     *
+     * @param first_line The first line to preview, counting from 1.
+     * @param last_line The last line to preview.
+     */
+    void parse_region(std::size_t first_line, std::size_t last_line);
+
+    /**
+     * @brief Parses the input file and writes the LaTeX code
+     *     to the output file, reading, transpiling, and writing at once.
+     * @details See `pipeline`. The output is the same as that of
+     *     `parse()` followed by `save_latex_code()`,
+     *     but a slow disk or output pipe overlaps with the transpiling.
+     *
+     *     The output file is written as the code is produced,
+     *     rather than replaced atomically, and the code is not stored,
+     *     so `get_latex_code()` returns nothing afterward.
+     *
+     */
+    void run_pipelined();
+
     /**
      * @brief Returns the LaTeX code for the parsed file as a string.
      * @details Must be called after `parse()`.
@@ -93,31 +156,52 @@ class sparkdown {
 
     /**
      * @brief Writes the stored LaTeX code to the output file.
-     * @details The output file must have been saved from the constructor.
+     * @details The output file is the one given to the constructor.
+     *     If no output file was given, the code is written to stdout.
      *
+     * @return Whether the output was changed, was unchanged, or failed.
      */
-    void save_latex_code() const;
+    [[nodiscard]] write_result save_latex_code() const;
 
     /**
      * @brief Writes the stored LaTeX code to the output file.
+     * @details See `save_latex_code(const std::filesystem::path&)`.
      *
      * @param output The output file to write to.
+     * @return Whether the output was changed, was unchanged, or failed.
      */
-    void save_latex_code(const std::string& output) const;
+    [[nodiscard]] write_result save_latex_code(
+        const std::string& output) const;
 
     /**
      * @brief Writes the stored LaTeX code to the output file.
+     * @details If the file already holds the same code, it is left untouched,
+     *     so that tools watching it do not rebuild needlessly.
+     *     Otherwise, it is replaced atomically.
+     *     A failure is reported on stderr.
      *
      * @param output The output file to write to.
+     * @return Whether the output was changed, was unchanged, or failed.
      */
-    void save_latex_code(const std::filesystem::path& output) const;
+    [[nodiscard]] write_result save_latex_code(
+        const std::filesystem::path& output) const;
 
     /**
      * @brief Writes the stored LaTeX code to an output stream.
      *
      * @param output The output stream to write to.
+     * @return True if the stream accepted all of the code.
+     */
+    bool save_latex_code(std::ostream& output) const;
+
+    /**
+     * @brief Returns the performance statistics
+     *     of every parse and save so far.
+     * @details The peak memory usage is measured when this is called.
+     *
+     * @return The statistics.
      */
-    void save_latex_code(std::ostream& output) const;
+    [[nodiscard]] const compile_stats& get_stats() const;
 
     //  ++==================++
     //  ||  Static methods  ||
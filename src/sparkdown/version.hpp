@@ -0,0 +1,26 @@
+/**
+ * @file sparkdown/version.hpp
+ * @package //sparkdown:version
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief Sparkdown version information.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the current version of Sparkdown.
+ *     It is kept apart from `sparkdown.hpp` so that the library's
+ *     own components can stamp their cache files with it.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef VERSION_HPP
+#define VERSION_HPP
+
+/**
+ * @brief Sparkdown current version information.
+ *
+ */
+#define SPARKDOWN_VERSION "v2.0.0"
+
+#endif
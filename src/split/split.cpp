@@ -0,0 +1,247 @@
+/**
+ * @file split/split.cpp
+ * @package //split:split
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `split` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `split` class,
+ *     which writes LaTeX code as a master file and one file per section.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "split.hpp"
+
+#include <cctype>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#include "hash/hash.hpp"
+#include "output/output.hpp"
+#include "sparkdown/version.hpp"
+#include "trace/trace.hpp"
+
+namespace sparkdown {
+
+namespace {
+
+/**
+ * @brief The command that starts a section.
+ *
+ */
+constexpr std::string_view headline = "\\section{";
+
+/**
+ * @brief The longest section file name, before any numeric suffix.
+ *
+ */
+constexpr std::size_t max_name = 48;
+
+/**
+ * @brief Returns the position of the next line starting with a headline,
+ *     skipping over verbatim environments.
+ *
+ * @param latex The LaTeX code to search.
+ * @param from The position to search from.
+ * @param verbatim The position of the next verbatim environment,
+ *     kept between calls so that the code is only searched for it once.
+ *     Start with 0.
+ * @return The position, or `npos` if there is none.
+ */
+std::size_t find_headline(std::string_view latex, std::size_t from,
+                          std::size_t &verbatim) {
+    static constexpr std::string_view begin = "\\begin{verbatim}";
+    static constexpr std::string_view end = "\\end{verbatim}";
+
+    while (from < latex.size()) {
+        std::size_t found = latex.find(headline, from);
+        if (found == std::string_view::npos) return found;
+
+        if (verbatim <= from) verbatim = latex.find(begin, from);
+        if (verbatim < found) {
+            std::size_t close = latex.find(end, verbatim + begin.size());
+            if (close == std::string_view::npos) return close;
+            from = close + end.size();
+            continue;
+        }
+
+        if (found == 0 || latex[found - 1] == '\n') return found;
+        from = found + 1;
+    }
+    return std::string_view::npos;
+}
+
+/**
+ * @brief Returns the file name for a section, based on its headline.
+ * @details Letters and digits are kept, in lowercase;
+ *     every other run of characters becomes a single "-".
+ *
+ * @param latex The LaTeX code of the section, starting with its headline.
+ * @return The file name, without its extension.
+ */
+std::string name_of(std::string_view latex) {
+    std::string_view title = latex.substr(headline.size());
+    title = title.substr(0, title.find('\n'));
+    title = title.substr(0, title.rfind('}'));
+
+    std::string name;
+    for (char c : title) {
+        if (name.size() >= max_name) break;
+        if (std::isalnum(static_cast<unsigned char>(c))) {
+            name += static_cast<char>(
+                std::tolower(static_cast<unsigned char>(c)));
+        } else if (!name.empty() && name.back() != '-') {
+            name += '-';
+        }
+    }
+    while (!name.empty() && name.back() == '-') name.pop_back();
+    return name.empty() ? "section" : name;
+}
+
+}  // namespace
+
+split::split(std::filesystem::path master)
+    : _master(std::move(master)),
+      _directory(this->_master.parent_path() / this->_master.stem()) {}
+
+const std::filesystem::path &split::directory() const {
+    return this->_directory;
+}
+
+std::vector<split::section> split::sections(std::string_view latex) {
+    std::vector<section> result;
+    std::set<std::string> names;
+
+    std::size_t verbatim = 0;
+    std::size_t start = find_headline(latex, 0, verbatim);
+    result.push_back({"", latex.substr(0, start)});
+    while (start != std::string_view::npos) {
+        std::size_t next =
+            find_headline(latex, start + headline.size(), verbatim);
+        std::string_view code = latex.substr(start, next - start);
+
+        std::string name = name_of(code);
+        std::string unique = name;
+        for (int i = 2; !names.insert(unique).second; i++) {
+            unique = name + "-" + std::to_string(i);
+        }
+        result.push_back({std::move(unique), code});
+
+        start = next;
+    }
+
+    return result;
+}
+
+split_report split::write(std::string_view latex) const {
+    SPARKDOWN_TRACE_SPAN("split", "write", this->_master.native());
+
+    split_report report;
+    std::vector<section> parts = sections(latex);
+    std::map<std::string, std::uint64_t> previous = this->_read_manifest();
+    std::map<std::string, std::uint64_t> manifest;
+
+    std::error_code error;
+    std::filesystem::create_directories(this->_directory, error);
+
+    std::string master(parts.front().latex);
+    for (std::size_t i = 1; i < parts.size(); i++) {
+        const section &part = parts[i];
+        std::filesystem::path path = this->_directory / (part.name + ".tex");
+        master += "\\include{";
+        master += (this->_master.stem() / part.name).generic_string();
+        master += "}\n";
+
+        std::uint64_t content_hash = hash::of(part.latex);
+        manifest[part.name] = content_hash;
+        auto found = previous.find(part.name);
+        if (found != previous.end() && found->second == content_hash &&
+            std::filesystem::exists(path, error)) {
+            report.unchanged++;
+            continue;
+        }
+
+        switch (output::write(path, part.latex)) {
+            case WRITE_CHANGED:
+                report.changed.push_back(path);
+                break;
+            case WRITE_UNCHANGED:
+                report.unchanged++;
+                break;
+            case WRITE_FAILED:
+                report.failed.push_back(path);
+                manifest.erase(part.name);
+                break;
+        }
+    }
+
+    for (const auto &[name, content_hash] : previous) {
+        if (manifest.count(name)) continue;
+        std::filesystem::path path = this->_directory / (name + ".tex");
+        if (std::filesystem::remove(path, error)) {
+            report.removed.push_back(path);
+        }
+    }
+
+    switch (output::write(this->_master, master)) {
+        case WRITE_CHANGED:
+            report.changed.push_back(this->_master);
+            break;
+        case WRITE_UNCHANGED:
+            break;
+        case WRITE_FAILED:
+            report.failed.push_back(this->_master);
+            break;
+    }
+
+    if (!this->_write_manifest(manifest)) {
+        report.failed.push_back(this->_directory / manifest_name);
+    }
+
+    return report;
+}
+
+std::map<std::string, std::uint64_t> split::_read_manifest() const {
+    std::map<std::string, std::uint64_t> manifest;
+
+    std::ifstream file(this->_directory / manifest_name);
+    std::string line;
+    if (!std::getline(file, line) ||
+        line != std::string("sparkdown-sections ") + SPARKDOWN_VERSION) {
+        return manifest;
+    }
+
+    // Each line holds the name and content hash of one section,
+    // separated by a tab.
+    while (std::getline(file, line)) {
+        std::size_t tab = line.find('\t');
+        std::uint64_t content_hash = 0;
+        if (tab != std::string::npos &&
+            hash::from_hex(std::string_view(line).substr(tab + 1),
+                           content_hash)) {
+            manifest[line.substr(0, tab)] = content_hash;
+        }
+    }
+
+    return manifest;
+}
+
+bool split::_write_manifest(
+    const std::map<std::string, std::uint64_t> &manifest) const {
+    std::ostringstream contents;
+    contents << "sparkdown-sections " << SPARKDOWN_VERSION << '\n';
+    for (const auto &[name, content_hash] : manifest) {
+        contents << name << '\t' << hash::to_hex(content_hash) << '\n';
+    }
+
+    return output::write(this->_directory / manifest_name, contents.str()) !=
+           WRITE_FAILED;
+}
+
+}  // namespace sparkdown
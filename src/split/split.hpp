@@ -0,0 +1,173 @@
+/**
+ * @file split/split.hpp
+ * @package //split:split
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `split` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `split` class,
+ *     which writes LaTeX code as a master file and one file per section.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef SPLIT_HPP
+#define SPLIT_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sparkdown {
+
+/**
+ * @brief The results of writing split output.
+ *
+ */
+struct split_report {
+    /**
+     * @brief The files that were created or rewritten.
+     *
+     */
+    std::vector<std::filesystem::path> changed;
+
+    /**
+     * @brief The section files that were deleted,
+     *     because their sections no longer exist.
+     *
+     */
+    std::vector<std::filesystem::path> removed;
+
+    /**
+     * @brief The files that could not be written.
+     *
+     */
+    std::vector<std::filesystem::path> failed;
+
+    /**
+     * @brief The number of section files that were already up to date.
+     *
+     */
+    std::size_t unchanged = 0;
+};
+
+/**
+ * @brief Writes LaTeX code as a master file, plus one file per section,
+ *     so that LaTeX only has to reprocess the sections that changed.
+ * @details The code is split before each line starting with "\section{",
+ *     outside of verbatim environments.
+ *     The master file holds the code before the first section,
+ *     followed by an `\include` of each section file, in order.
+ *
+ *     For a master file `build/notes.tex`, the section files are written
+ *     to `build/notes/`, named after their headlines,
+ *     e.g. `build/notes/introduction.tex`,
+ *     so that adding or removing one section does not rename the others.
+ *
+ *     The content hash of every section is recorded in a manifest
+ *     in the section directory. Only sections whose hash has changed
+ *     are written, and the files of sections that have disappeared
+ *     are deleted.
+ *
+ */
+class split {
+   private:
+    /**
+     * @brief The master file.
+     *
+     */
+    std::filesystem::path _master;
+
+    /**
+     * @brief The directory of the section files.
+     *
+     */
+    std::filesystem::path _directory;
+
+    /**
+     * @brief Reads the manifest from the section directory.
+     * @details A missing manifest, or one written by a different version
+     *     of Sparkdown, is treated as empty.
+     *
+     * @return The content hash of each section, keyed by name.
+     */
+    [[nodiscard]] std::map<std::string, std::uint64_t> _read_manifest() const;
+
+    /**
+     * @brief Writes the manifest to the section directory.
+     *
+     * @param manifest The content hash of each section, keyed by name.
+     * @return True on success.
+     */
+    bool _write_manifest(
+        const std::map<std::string, std::uint64_t> &manifest) const;
+
+   public:
+    /**
+     * @brief A single section of the code.
+     *
+     */
+    struct section {
+        /**
+         * @brief The file name of the section, without its extension.
+         *     Empty for the code before the first section.
+         *
+         */
+        std::string name;
+
+        /**
+         * @brief The LaTeX code of the section.
+         *
+         */
+        std::string_view latex;
+    };
+
+    /**
+     * @brief The name of the manifest file in the section directory.
+     *
+     */
+    static constexpr const char *manifest_name = ".sparkdown-sections";
+
+    /**
+     * @brief Constructor.
+     *
+     * @param master The master file to write.
+     */
+    explicit split(std::filesystem::path master);
+
+    /**
+     * @brief Splits the given LaTeX code into sections.
+     * @details The first section is the code before the first headline,
+     *     and has an empty name. It is always present, but may be empty.
+     *     The other sections are named after their headlines,
+     *     made unique with a numeric suffix where needed.
+     *
+     * @param latex The LaTeX code to split.
+     * @return The sections, in order, as views into the code.
+     */
+    static std::vector<section> sections(std::string_view latex);
+
+    /**
+     * @brief Writes the given LaTeX code as a master file and section files.
+     *
+     * @param latex The LaTeX code to write.
+     * @return The results of the write.
+     */
+    split_report write(std::string_view latex) const;
+
+    /**
+     * @brief Returns the directory of the section files.
+     *
+     * @return The directory.
+     */
+    [[nodiscard]] const std::filesystem::path &directory() const;
+};
+
+}  // namespace sparkdown
+
+#endif
@@ -0,0 +1,122 @@
+/**
+ * @file split/split.tests.cpp
+ * @package //split:split.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `split` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `split` class,
+ *     which writes LaTeX code as a master file and one file per section.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunknown-pragmas"
+#pragma ide diagnostic ignored "UnusedLocalVariable"
+
+#include "split.hpp"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "scratch/scratch.hpp"
+
+/**
+ * @brief `split#sections()` test.
+ * @details Ensures that the code is split before each headline,
+ *     but not inside of verbatim environments,
+ *     and that the sections are given unique names.
+ *
+ */
+TEST(split, sections) {
+    const std::string latex =
+        "intro\n"
+        "\\section{Getting Started!}\nA\n"
+        "\\begin{verbatim}\n\\section{No}\n\\end{verbatim}\n"
+        "\\subsection{Sub} x \\section{inline}\n"
+        "\\section{Getting started}\nB\n"
+        "\\section{$x$}\n";
+
+    std::vector<sparkdown::split::section> parts =
+        sparkdown::split::sections(latex);
+    ASSERT_EQ(parts.size(), 4);
+    EXPECT_EQ(parts[0].name, "");
+    EXPECT_EQ(parts[0].latex, "intro\n");
+    EXPECT_EQ(parts[1].name, "getting-started");
+    EXPECT_EQ(parts[1].latex,
+              "\\section{Getting Started!}\nA\n"
+              "\\begin{verbatim}\n\\section{No}\n\\end{verbatim}\n"
+              "\\subsection{Sub} x \\section{inline}\n");
+    EXPECT_EQ(parts[2].name, "getting-started-2");
+    EXPECT_EQ(parts[3].name, "x");
+
+    parts = sparkdown::split::sections("no sections");
+    ASSERT_EQ(parts.size(), 1);
+    EXPECT_EQ(parts[0].latex, "no sections");
+}
+
+/**
+ * @brief `split#write()` test.
+ * @details Ensures that the master file includes each section file.
+ *
+ */
+TEST(split, write) {
+    std::filesystem::path dir = sparkdown::scratch::directory("split-write");
+    sparkdown::split writer(dir / "notes.tex");
+
+    sparkdown::split_report report =
+        writer.write("head\n\\section{One}\n1\n\\section{Two}\n2\n");
+    EXPECT_EQ(report.changed.size(), 3);
+    EXPECT_TRUE(report.failed.empty());
+
+    EXPECT_EQ(sparkdown::scratch::read_file(dir / "notes.tex"),
+              "head\n\\include{notes/one}\n\\include{notes/two}\n");
+    EXPECT_EQ(sparkdown::scratch::read_file(dir / "notes" / "one.tex"),
+              "\\section{One}\n1\n");
+    EXPECT_EQ(sparkdown::scratch::read_file(dir / "notes" / "two.tex"),
+              "\\section{Two}\n2\n");
+    EXPECT_EQ(writer.directory(), dir / "notes");
+}
+
+/**
+ * @brief `split#write()` incremental test.
+ * @details Ensures that only changed sections are rewritten,
+ *     and that the files of removed sections are deleted.
+ *
+ */
+TEST(split, rewrites_changed_sections) {
+    std::filesystem::path dir =
+        sparkdown::scratch::directory("split-incremental");
+    sparkdown::split writer(dir / "notes.tex");
+
+    writer.write("\\section{One}\n1\n\\section{Two}\n2\n\\section{Three}\n3\n");
+
+    // An unchanged section is not written, even if its file was edited.
+    std::ofstream(dir / "notes" / "one.tex") << "edited";
+
+    sparkdown::split_report report =
+        writer.write("\\section{One}\n1\n\\section{Two}\n2!\n");
+    ASSERT_EQ(report.changed.size(), 2);
+    EXPECT_EQ(report.changed[0], dir / "notes" / "two.tex");
+    EXPECT_EQ(report.changed[1], dir / "notes.tex");
+    ASSERT_EQ(report.removed.size(), 1);
+    EXPECT_EQ(report.removed[0], dir / "notes" / "three.tex");
+    EXPECT_EQ(report.unchanged, 1);
+
+    EXPECT_EQ(sparkdown::scratch::read_file(dir / "notes" / "one.tex"),
+              "edited");
+    EXPECT_FALSE(std::filesystem::exists(dir / "notes" / "three.tex"));
+
+    // A deleted section file is written again.
+    std::filesystem::remove(dir / "notes" / "one.tex");
+    report = writer.write("\\section{One}\n1\n\\section{Two}\n2!\n");
+    ASSERT_EQ(report.changed.size(), 1);
+    EXPECT_EQ(sparkdown::scratch::read_file(dir / "notes" / "one.tex"),
+              "\\section{One}\n1\n");
+}
+
+#pragma clang diagnostic pop
@@ -19,7 +19,20 @@
 
 namespace sparkdown {
 
-state::state() : _is_head(true), _is_math(false), _is_verbatim(false) {}
+state::state(std::pmr::memory_resource *resource)
+    : _is_head(true),
+      _is_math(false),
+      _is_verbatim(false),
+      _visits(0),
+      _lists(resource) {}
+
+void state::reset() {
+    this->_is_head = true;
+    this->_is_math = false;
+    this->_is_verbatim = false;
+    this->_visits = 0;
+    this->_lists.clear();
+}
 
 void state::end_head() { this->_is_head = false; }
 
@@ -33,4 +46,22 @@ void state::toggle_is_verbatim() { this->_is_verbatim = !this->_is_verbatim; }
 
 bool state::is_verbatim() const { return this->_is_verbatim; }
 
+void state::visit(std::size_t count) { this->_visits += count; }
+
+std::size_t state::visits() const { return this->_visits; }
+
+void state::open_list(list_type type, std::size_t indent) {
+    this->_lists.push_back({type, indent});
+}
+
+void state::close_list() {
+    if (!this->_lists.empty()) this->_lists.pop_back();
+}
+
+std::size_t state::list_depth() const { return this->_lists.size(); }
+
+list_type state::list_kind() const { return this->_lists.back().type; }
+
+std::size_t state::list_indent() const { return this->_lists.back().indent; }
+
 }  // namespace sparkdown
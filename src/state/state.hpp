@@ -16,8 +16,21 @@
 #ifndef STATE_HPP
 #define STATE_HPP
 
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
 namespace sparkdown {
 
+/**
+ * @brief An enumeration of the kinds of list.
+ *
+ */
+enum list_type {
+    LIST_ITEMIZE,   // An unordered list, marked with "*" or "-".
+    LIST_ENUMERATE  // An ordered list, marked with "1.", "2.", etc.
+};
+
 /**
  * @brief Represents the state of the language parser.
  *
@@ -42,12 +55,43 @@ class state {
      */
     bool _is_verbatim;
 
+    /**
+     * @brief The number of tokens visited by the parser and its patterns.
+     *
+     */
+    std::size_t _visits;
+
+    /**
+     * @brief A single open list.
+     *
+     */
+    struct list_level {
+        list_type type;      // The kind of list.
+        std::size_t indent;  // The indentation of its item markers.
+    };
+
+    /**
+     * @brief The lists that are currently open, innermost last.
+     *
+     */
+    std::pmr::vector<list_level> _lists;
+
    public:
     /**
      * @brief Constructor.
      *
+     * @param resource The memory resource of the open lists.
+     */
+    explicit state(
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    /**
+     * @brief Returns the state to its initial value.
+     * @details Unlike assigning a new state, keeps the capacity
+     *     of the list stack, so that a reused parser does not allocate.
+     *
      */
-    state();
+    void reset();
 
     /**
      * @brief Indicates to the state that the language parser is no longer
@@ -88,6 +132,63 @@ class state {
      * @return True if we are currently parsing verbatim text.
      */
     bool is_verbatim() const;
+
+    /**
+     * @brief Records that the parser or one of its patterns
+     *     has visited the given number of tokens.
+     * @details Used to measure the work done by the parser,
+     *     so that patterns which rescan the tokens can be caught.
+     *     Every pattern that looks at tokens past its match position
+     *     should report them here.
+     *
+     * @param count The number of tokens visited.
+     */
+    void visit(std::size_t count = 1);
+
+    /**
+     * @brief Reports the number of tokens visited so far.
+     *
+     * @return The number of tokens visited.
+     */
+    std::size_t visits() const;
+
+    /**
+     * @brief Opens a new list inside of the innermost open list.
+     *
+     * @param type The kind of list.
+     * @param indent The indentation of its item markers.
+     */
+    void open_list(list_type type, std::size_t indent);
+
+    /**
+     * @brief Closes the innermost open list.
+     * @details Does nothing if no list is open.
+     *
+     */
+    void close_list();
+
+    /**
+     * @brief Reports the number of lists that are currently open.
+     *
+     * @return The nesting depth of the current list, or 0 outside of lists.
+     */
+    std::size_t list_depth() const;
+
+    /**
+     * @brief Reports the kind of the innermost open list.
+     * @details Only meaningful when `list_depth()` is nonzero.
+     *
+     * @return The kind of the innermost open list.
+     */
+    list_type list_kind() const;
+
+    /**
+     * @brief Reports the indentation of the innermost open list.
+     * @details Only meaningful when `list_depth()` is nonzero.
+     *
+     * @return The indentation of the item markers of the innermost list.
+     */
+    std::size_t list_indent() const;
 };
 
 }  // namespace sparkdown
@@ -70,4 +70,59 @@ TEST(state, is_verbatim) {
     EXPECT_FALSE(s.is_verbatim());
 }
 
+/**
+ * @brief `state#visits()` test.
+ *
+ */
+TEST(state, visits) {
+    sparkdown::state s;
+    EXPECT_EQ(s.visits(), 0);
+
+    s.visit();
+    s.visit(3);
+    EXPECT_EQ(s.visits(), 4);
+}
+
+/**
+ * @brief `state#open_list()` and `state#close_list()` test.
+ *
+ */
+TEST(state, lists) {
+    sparkdown::state s;
+    EXPECT_EQ(s.list_depth(), 0);
+
+    s.open_list(sparkdown::LIST_ITEMIZE, 0);
+    s.open_list(sparkdown::LIST_ENUMERATE, 2);
+    EXPECT_EQ(s.list_depth(), 2);
+    EXPECT_EQ(s.list_kind(), sparkdown::LIST_ENUMERATE);
+    EXPECT_EQ(s.list_indent(), 2);
+
+    s.close_list();
+    EXPECT_EQ(s.list_depth(), 1);
+    EXPECT_EQ(s.list_kind(), sparkdown::LIST_ITEMIZE);
+    EXPECT_EQ(s.list_indent(), 0);
+
+    s.close_list();
+    s.close_list();
+    EXPECT_EQ(s.list_depth(), 0);
+}
+
+/**
+ * @brief `state#reset()` test.
+ *
+ */
+TEST(state, reset) {
+    sparkdown::state s;
+    s.end_head();
+    s.toggle_is_math();
+    s.visit();
+    s.open_list(sparkdown::LIST_ITEMIZE, 0);
+
+    s.reset();
+    EXPECT_TRUE(s.is_head());
+    EXPECT_FALSE(s.is_math());
+    EXPECT_EQ(s.visits(), 0);
+    EXPECT_EQ(s.list_depth(), 0);
+}
+
 #pragma clang diagnostic pop
@@ -0,0 +1,91 @@
+/**
+ * @file stats/count_allocations.cpp
+ * @package //stats:count_allocations
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief Counting replacements of the global `operator new`.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file replaces the global allocation functions
+ *     with versions that report each allocation to `compile_stats`.
+ *     Linking it into a binary enables the allocation counts
+ *     in that binary's statistics.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include <cstdlib>
+#include <new>
+
+#include "stats.hpp"
+
+void *operator new(std::size_t size) {
+    sparkdown::compile_stats::count_allocation();
+    if (size == 0) size = 1;
+    if (void *p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) { return ::operator new(size); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    sparkdown::compile_stats::count_allocation();
+    return std::malloc(size ? size : 1);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept {
+    return ::operator new(size, tag);
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete[](void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+// The aligned forms are used by `std::pmr::new_delete_resource()`,
+// and so by every token list drawn from the default resource.
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    sparkdown::compile_stats::count_allocation();
+    auto align = static_cast<std::size_t>(alignment);
+    if (align < sizeof(void *)) align = sizeof(void *);
+    // `aligned_alloc()` needs a size that is a multiple of the alignment.
+    size = (size + align - 1) / align * align;
+    if (size == 0) size = align;
+    if (void *p = std::aligned_alloc(align, size)) return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t &) noexcept {
+    try {
+        return ::operator new(size, alignment);
+    } catch (const std::bad_alloc &) {
+        return nullptr;
+    }
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t &tag) noexcept {
+    return ::operator new(size, alignment, tag);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
@@ -0,0 +1,236 @@
+/**
+ * @file stats/stats.cpp
+ * @package //stats:stats
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `compile_stats` and `phase_timer` implementations.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `compile_stats` struct,
+ *     the `phase_timer` class, and the `counting_resource` class.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "stats.hpp"
+
+#include <sys/resource.h>
+
+#include <atomic>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace sparkdown {
+
+namespace {
+
+/**
+ * @brief The number of allocations made by the current thread.
+ *
+ */
+thread_local std::uint64_t allocations_by_thread = 0;
+
+/**
+ * @brief Whether any allocation has been counted,
+ *     i.e. whether `//stats:count_allocations` is linked in.
+ *
+ */
+std::atomic<bool> allocations_counted = false;
+
+/**
+ * @brief Returns the CPU time used by the current thread, in seconds.
+ *
+ * @return The CPU time.
+ */
+double thread_cpu_seconds() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) +
+           static_cast<double>(ts.tv_nsec) / 1e9;
+}
+
+/**
+ * @brief The names and members of the phases, in report order.
+ *
+ */
+const std::pair<const char *, phase_stats compile_stats::*> phases[] = {
+    {"read", &compile_stats::read},   {"lex", &compile_stats::lex},
+    {"parse", &compile_stats::parse}, {"emit", &compile_stats::emit},
+    {"write", &compile_stats::write},
+};
+
+}  // namespace
+
+phase_stats &phase_stats::operator+=(const phase_stats &other) {
+    this->wall_seconds += other.wall_seconds;
+    this->cpu_seconds += other.cpu_seconds;
+    this->allocations += other.allocations;
+    return *this;
+}
+
+double compile_stats::tokens_per_second() const {
+    double seconds = this->lex.wall_seconds + this->parse.wall_seconds;
+    if (seconds <= 0) return 0;
+    return static_cast<double>(this->tokens_lexed) / seconds;
+}
+
+double compile_stats::work_per_byte() const {
+    if (this->bytes_in == 0) return 0;
+    return static_cast<double>(this->bytes_scanned + this->tokens_lexed +
+                               this->tokens_visited + this->tokens_parsed +
+                               this->bytes_out) /
+           static_cast<double>(this->bytes_in);
+}
+
+void compile_stats::record_peak_rss() {
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return;
+    // Linux reports `ru_maxrss` in kibibytes.
+    this->peak_rss_bytes = static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+}
+
+std::string compile_stats::to_text() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+
+    out << "phase      wall (ms)   cpu (ms)";
+    if (counting_allocations()) out << "   allocations";
+    out << "\n";
+    phase_stats total;
+    for (const auto &[name, member] : phases) {
+        const phase_stats &p = this->*member;
+        out << std::left << std::setw(8) << name << std::right
+            << std::setw(12) << p.wall_seconds * 1e3 << std::setw(11)
+            << p.cpu_seconds * 1e3;
+        if (counting_allocations()) out << std::setw(14) << p.allocations;
+        out << "\n";
+        total.wall_seconds += p.wall_seconds;
+        total.cpu_seconds += p.cpu_seconds;
+        total.allocations += p.allocations;
+    }
+    out << std::left << std::setw(8) << "total" << std::right << std::setw(12)
+        << total.wall_seconds * 1e3 << std::setw(11)
+        << total.cpu_seconds * 1e3;
+    if (counting_allocations()) out << std::setw(14) << total.allocations;
+    out << "\n\n";
+
+    out << "bytes in:       " << this->bytes_in << "\n";
+    out << "bytes out:      " << this->bytes_out << "\n";
+    out << "bytes scanned:  " << this->bytes_scanned << "\n";
+    out << "tokens lexed:   " << this->tokens_lexed << "\n";
+    out << "tokens parsed:  " << this->tokens_parsed << "\n";
+    out << "tokens visited: " << this->tokens_visited << "\n";
+    out << "work per byte:  " << std::setprecision(2) << this->work_per_byte()
+        << "\n";
+    out << "tokens/sec:     " << std::setprecision(0)
+        << this->tokens_per_second() << "\n";
+    out << "peak RSS:       " << std::setprecision(1)
+        << static_cast<double>(this->peak_rss_bytes) / (1024 * 1024)
+        << " MiB\n";
+
+    return out.str();
+}
+
+std::string compile_stats::to_json() const {
+    std::ostringstream out;
+    out << std::setprecision(9);
+
+    out << "{\"phases\":{";
+    bool first = true;
+    for (const auto &[name, member] : phases) {
+        const phase_stats &p = this->*member;
+        if (!first) out << ",";
+        first = false;
+        out << "\"" << name << "\":{\"wall_seconds\":" << p.wall_seconds
+            << ",\"cpu_seconds\":" << p.cpu_seconds << ",\"allocations\":";
+        if (counting_allocations()) {
+            out << p.allocations;
+        } else {
+            out << "null";
+        }
+        out << "}";
+    }
+    out << "},\"bytes_in\":" << this->bytes_in
+        << ",\"bytes_out\":" << this->bytes_out
+        << ",\"bytes_scanned\":" << this->bytes_scanned
+        << ",\"tokens_lexed\":" << this->tokens_lexed
+        << ",\"tokens_parsed\":" << this->tokens_parsed
+        << ",\"tokens_visited\":" << this->tokens_visited
+        << ",\"work_per_byte\":" << this->work_per_byte()
+        << ",\"tokens_per_second\":" << this->tokens_per_second()
+        << ",\"peak_rss_bytes\":" << this->peak_rss_bytes << "}";
+
+    return out.str();
+}
+
+void compile_stats::count_allocation() noexcept {
+    allocations_by_thread++;
+    // Only store once, to keep the cache line shared between threads.
+    if (!allocations_counted.load(std::memory_order_relaxed)) {
+        allocations_counted.store(true, std::memory_order_relaxed);
+    }
+}
+
+std::uint64_t compile_stats::thread_allocations() noexcept {
+    return allocations_by_thread;
+}
+
+bool compile_stats::counting_allocations() noexcept {
+    return allocations_counted.load(std::memory_order_relaxed);
+}
+
+phase_timer::phase_timer(phase_stats *phase)
+    : _phase(phase), _cpu(0), _allocations(0) {
+    if (!this->_phase) return;
+    this->_wall = std::chrono::steady_clock::now();
+    this->_cpu = thread_cpu_seconds();
+    this->_allocations = compile_stats::thread_allocations();
+}
+
+phase_timer::~phase_timer() {
+    if (!this->_phase) return;
+    std::chrono::duration<double> wall =
+        std::chrono::steady_clock::now() - this->_wall;
+    this->_phase->wall_seconds += wall.count();
+    this->_phase->cpu_seconds += thread_cpu_seconds() - this->_cpu;
+    this->_phase->allocations +=
+        compile_stats::thread_allocations() - this->_allocations;
+}
+
+counting_resource::counting_resource(std::pmr::memory_resource *upstream)
+    : _upstream(upstream), _allocations(0), _bytes(0), _in_use(0), _peak(0) {}
+
+std::uint64_t counting_resource::allocations() const {
+    return this->_allocations;
+}
+
+std::uint64_t counting_resource::bytes() const { return this->_bytes; }
+
+std::uint64_t counting_resource::peak() const { return this->_peak; }
+
+void *counting_resource::do_allocate(std::size_t bytes,
+                                     std::size_t alignment) {
+    void *p = this->_upstream->allocate(bytes, alignment);
+    this->_allocations++;
+    this->_bytes += bytes;
+    this->_in_use += bytes;
+    if (this->_in_use > this->_peak) this->_peak = this->_in_use;
+    return p;
+}
+
+void counting_resource::do_deallocate(void *p, std::size_t bytes,
+                                      std::size_t alignment) {
+    this->_upstream->deallocate(p, bytes, alignment);
+    this->_in_use -= bytes;
+}
+
+bool counting_resource::do_is_equal(
+    const std::pmr::memory_resource &other) const noexcept {
+    return this == &other;
+}
+
+}  // namespace sparkdown
@@ -0,0 +1,330 @@
+/**
+ * @file stats/stats.hpp
+ * @package //stats:stats
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `compile_stats` and `phase_timer` definitions.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `compile_stats` struct,
+ *     which holds performance statistics about a transpile,
+ *     the `phase_timer` class, which measures a single phase of it,
+ *     and the `counting_resource` class, which counts the allocations
+ *     made through a polymorphic memory resource.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef STATS_HPP
+#define STATS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+
+namespace sparkdown {
+
+/**
+ * @brief The statistics of a single phase of a transpile.
+ *
+ */
+struct phase_stats {
+    /**
+     * @brief The wall-clock time spent in the phase.
+     *
+     */
+    double wall_seconds = 0;
+
+    /**
+     * @brief The CPU time spent in the phase, by the measuring thread.
+     *
+     */
+    double cpu_seconds = 0;
+
+    /**
+     * @brief The number of heap allocations made in the phase,
+     *     by the measuring thread.
+     * @details Only counted when `//stats:count_allocations` is linked in.
+     *
+     */
+    std::uint64_t allocations = 0;
+
+    /**
+     * @brief Adds the given statistics to these.
+     * @details Used to gather the statistics recorded by other threads.
+     *
+     * @param other The statistics to add.
+     * @return These statistics.
+     */
+    phase_stats &operator+=(const phase_stats &other);
+};
+
+/**
+ * @brief Performance statistics about a transpile.
+ * @details Filled in by the `compiler`, the `module_cache`,
+ *     and the `sparkdown` driver when they are given one.
+ *     Values accumulate, so one `compile_stats` may cover many documents.
+ *
+ */
+struct compile_stats {
+    phase_stats read;   // Reading the input files.
+    phase_stats lex;    // Lexing the input into tokens.
+    phase_stats parse;  // Parsing the tokens.
+    phase_stats emit;   // Generating the LaTeX code.
+    phase_stats write;  // Writing the output.
+
+    /**
+     * @brief The number of bytes of Sparkdown text compiled,
+     *     including text that failed to compile.
+     *
+     */
+    std::uint64_t bytes_in = 0;
+
+    /**
+     * @brief The number of bytes of LaTeX code produced.
+     *
+     */
+    std::uint64_t bytes_out = 0;
+
+    /**
+     * @brief The number of bytes of input examined by the compiler
+     *     while finding the verbatim blocks and math regions.
+     * @details A byte examined twice is counted twice.
+     *
+     */
+    std::uint64_t bytes_scanned = 0;
+
+    /**
+     * @brief The number of tokens produced by the lexer.
+     *
+     */
+    std::uint64_t tokens_lexed = 0;
+
+    /**
+     * @brief The number of tokens left after parsing.
+     *
+     */
+    std::uint64_t tokens_parsed = 0;
+
+    /**
+     * @brief The number of tokens visited by the parser and its patterns.
+     * @details See `state::visit()`.
+     *
+     */
+    std::uint64_t tokens_visited = 0;
+
+    /**
+     * @brief The peak resident set size of the process, in bytes.
+     * @details Filled in by `record_peak_rss()`.
+     *
+     */
+    std::uint64_t peak_rss_bytes = 0;
+
+    /**
+     * @brief Returns the number of tokens lexed and parsed per second
+     *     of wall-clock time spent lexing and parsing.
+     *
+     * @return The token throughput.
+     */
+    [[nodiscard]] double tokens_per_second() const;
+
+    /**
+     * @brief Returns the work done per byte of input:
+     *     the bytes scanned for regions, the tokens lexed,
+     *     the tokens visited by the parser, and the tokens and bytes
+     *     handled by the emitter, together.
+     * @details A measure of the work done that does not depend
+     *     on the speed of the machine. It should stay roughly constant
+     *     as the input grows; if it grows too, something is super-linear.
+     *
+     * @return The work done per byte of input.
+     */
+    [[nodiscard]] double work_per_byte() const;
+
+    /**
+     * @brief Records the current peak resident set size of the process.
+     *
+     */
+    void record_peak_rss();
+
+    /**
+     * @brief Formats the statistics as human-readable text.
+     *
+     * @return The formatted statistics.
+     */
+    [[nodiscard]] std::string to_text() const;
+
+    /**
+     * @brief Formats the statistics as a JSON object.
+     *
+     * @return The formatted statistics.
+     */
+    [[nodiscard]] std::string to_json() const;
+
+    /**
+     * @brief Records a heap allocation by the calling thread.
+     * @details Called by the `operator new` of `//stats:count_allocations`.
+     *
+     */
+    static void count_allocation() noexcept;
+
+    /**
+     * @brief Returns the number of heap allocations
+     *     made by the calling thread so far.
+     *
+     * @return The number of allocations.
+     */
+    static std::uint64_t thread_allocations() noexcept;
+
+    /**
+     * @brief Reports whether allocations are being counted,
+     *     i.e. whether `//stats:count_allocations` is linked in.
+     *
+     * @return True if allocations are being counted.
+     */
+    static bool counting_allocations() noexcept;
+};
+
+/**
+ * @brief Measures a single phase of a transpile,
+ *     from construction to destruction.
+ * @details Does nothing when given a null pointer,
+ *     so it can be left in place when statistics are not wanted.
+ *
+ */
+class phase_timer {
+   private:
+    /**
+     * @brief The statistics to add to. May be null.
+     *
+     */
+    phase_stats *_phase;
+
+    /**
+     * @brief The wall-clock time at construction.
+     *
+     */
+    std::chrono::steady_clock::time_point _wall;
+
+    /**
+     * @brief The thread CPU time at construction, in seconds.
+     *
+     */
+    double _cpu;
+
+    /**
+     * @brief The thread's allocation count at construction.
+     *
+     */
+    std::uint64_t _allocations;
+
+   public:
+    /**
+     * @brief Starts measuring.
+     *
+     * @param phase The statistics to add to when done. May be null.
+     */
+    explicit phase_timer(phase_stats *phase);
+
+    /**
+     * @brief Stops measuring, and adds the measurements to the statistics.
+     *
+     */
+    ~phase_timer();
+
+    phase_timer(const phase_timer &) = delete;
+    phase_timer &operator=(const phase_timer &) = delete;
+};
+
+/**
+ * @brief A memory resource that counts the allocations passed through it
+ *     to another resource.
+ * @details The global `operator new` hook only sees allocations
+ *     that reach the heap. Allocations served by a pool or an arena
+ *     never do, so containers using those are measured by placing
+ *     a `counting_resource` in front of them.
+ *
+ *     A `counting_resource` is not thread-safe;
+ *     use one instance per thread.
+ *
+ */
+class counting_resource : public std::pmr::memory_resource {
+   private:
+    /**
+     * @brief The resource that serves the allocations.
+     *
+     */
+    std::pmr::memory_resource *_upstream;
+
+    /**
+     * @brief The number of allocations so far.
+     *
+     */
+    std::uint64_t _allocations;
+
+    /**
+     * @brief The number of bytes allocated so far.
+     *
+     */
+    std::uint64_t _bytes;
+
+    /**
+     * @brief The number of bytes currently allocated.
+     *
+     */
+    std::uint64_t _in_use;
+
+    /**
+     * @brief The largest number of bytes allocated at once.
+     *
+     */
+    std::uint64_t _peak;
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void do_deallocate(void *p, std::size_t bytes,
+                       std::size_t alignment) override;
+
+    [[nodiscard]] bool do_is_equal(
+        const std::pmr::memory_resource &other) const noexcept override;
+
+   public:
+    /**
+     * @brief Constructor.
+     *
+     * @param upstream The resource that serves the allocations.
+     */
+    explicit counting_resource(
+        std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+
+    counting_resource(const counting_resource &) = delete;
+    counting_resource &operator=(const counting_resource &) = delete;
+
+    /**
+     * @brief Returns the number of allocations so far.
+     *
+     * @return The number of allocations.
+     */
+    [[nodiscard]] std::uint64_t allocations() const;
+
+    /**
+     * @brief Returns the number of bytes allocated so far.
+     *
+     * @return The number of bytes.
+     */
+    [[nodiscard]] std::uint64_t bytes() const;
+
+    /**
+     * @brief Returns the largest number of bytes allocated at once.
+     *
+     * @return The number of bytes.
+     */
+    [[nodiscard]] std::uint64_t peak() const;
+};
+
+}  // namespace sparkdown
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * @file stats/stats.tests.cpp
+ * @package //stats:stats.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `compile_stats` and `phase_timer` unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `compile_stats` struct,
+ *     the `phase_timer` class, and the `counting_resource` class.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunknown-pragmas"
+#pragma ide diagnostic ignored "UnusedLocalVariable"
+
+#include "stats.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @brief `phase_timer` test.
+ * @details Ensures that a timer adds its measurements to the phase,
+ *     including the allocations made while it runs.
+ *
+ */
+TEST(stats, phase_timer) {
+    sparkdown::phase_stats phase;
+    {
+        sparkdown::phase_timer timer(&phase);
+        for (int i = 0; i < 3; i++) {
+            auto p = std::make_unique<volatile int>(i);
+        }
+    }
+
+    EXPECT_TRUE(sparkdown::compile_stats::counting_allocations());
+    EXPECT_EQ(phase.allocations, 3);
+    EXPECT_GE(phase.wall_seconds, 0);
+    EXPECT_GE(phase.cpu_seconds, 0);
+
+    // A timer without a phase does nothing.
+    sparkdown::phase_timer unused(nullptr);
+}
+
+/**
+ * @brief `phase_stats#operator+=()` test.
+ * @details Ensures that every measurement is added.
+ *
+ */
+TEST(stats, phase_sum) {
+    sparkdown::phase_stats total{1, 2, 3};
+    total += sparkdown::phase_stats{0.5, 0.25, 4};
+
+    EXPECT_EQ(total.wall_seconds, 1.5);
+    EXPECT_EQ(total.cpu_seconds, 2.25);
+    EXPECT_EQ(total.allocations, 7);
+}
+
+/**
+ * @brief `compile_stats#tokens_per_second()` test.
+ * @details Ensures that throughput is measured over lexing and parsing,
+ *     and that no time spent means no throughput.
+ *
+ */
+TEST(stats, tokens_per_second) {
+    sparkdown::compile_stats stats;
+    EXPECT_EQ(stats.tokens_per_second(), 0);
+
+    stats.tokens_lexed = 1000;
+    stats.lex.wall_seconds = 0.25;
+    stats.parse.wall_seconds = 0.25;
+    EXPECT_DOUBLE_EQ(stats.tokens_per_second(), 2000);
+}
+
+/**
+ * @brief `compile_stats#work_per_byte()` test.
+ *
+ */
+TEST(stats, work_per_byte) {
+    sparkdown::compile_stats stats;
+    EXPECT_EQ(stats.work_per_byte(), 0);
+
+    stats.bytes_in = 100;
+    stats.tokens_lexed = 100;
+    stats.tokens_visited = 150;
+    stats.tokens_parsed = 50;
+    EXPECT_DOUBLE_EQ(stats.work_per_byte(), 3);
+
+    stats.bytes_scanned = 120;
+    stats.bytes_out = 80;
+    EXPECT_DOUBLE_EQ(stats.work_per_byte(), 5);
+}
+
+/**
+ * @brief `compile_stats#record_peak_rss()` test.
+ * @details Ensures that the peak memory usage is measured.
+ *
+ */
+TEST(stats, record_peak_rss) {
+    sparkdown::compile_stats stats;
+    stats.record_peak_rss();
+    EXPECT_GT(stats.peak_rss_bytes, 0);
+}
+
+/**
+ * @brief `compile_stats#to_text()` and `compile_stats#to_json()` test.
+ * @details Ensures that every statistic is reported.
+ *
+ */
+TEST(stats, formatting) {
+    sparkdown::compile_stats stats;
+    stats.bytes_in = 123;
+    stats.bytes_out = 456;
+    stats.tokens_lexed = 789;
+    stats.emit.allocations = 42;
+
+    std::string text = stats.to_text();
+    for (const char *phase : {"read", "lex", "parse", "emit", "write"}) {
+        EXPECT_NE(text.find(phase), std::string::npos) << phase;
+    }
+    EXPECT_NE(text.find("bytes in:       123"), std::string::npos);
+    EXPECT_NE(text.find("bytes out:      456"), std::string::npos);
+    EXPECT_NE(text.find("tokens lexed:   789"), std::string::npos);
+    EXPECT_NE(text.find("peak RSS"), std::string::npos);
+
+    std::string json = stats.to_json();
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.back(), '}');
+    EXPECT_NE(json.find("\"bytes_in\":123"), std::string::npos);
+    EXPECT_NE(json.find("\"bytes_out\":456"), std::string::npos);
+    EXPECT_NE(json.find("\"tokens_lexed\":789"), std::string::npos);
+    EXPECT_NE(json.find("\"allocations\":42"), std::string::npos);
+    EXPECT_NE(json.find("\"peak_rss_bytes\":"), std::string::npos);
+}
+
+/**
+ * @brief `counting_resource` test.
+ * @details Ensures that allocations made through the resource are counted,
+ *     along with the largest number of bytes in use at once.
+ *
+ */
+TEST(stats, counting_resource) {
+    sparkdown::counting_resource resource;
+    {
+        std::pmr::vector<int> v(&resource);
+        v.reserve(16);
+        v.reserve(32);
+        EXPECT_EQ(resource.allocations(), 2);
+        EXPECT_EQ(resource.bytes(), 48 * sizeof(int));
+    }
+    EXPECT_EQ(resource.peak(), 48 * sizeof(int));
+
+    // Allocations served from a pool on top of it are not seen.
+    std::pmr::unsynchronized_pool_resource pool(&resource);
+    std::uint64_t before = resource.allocations();
+    {
+        std::pmr::vector<int> v(&pool);
+        for (int i = 0; i < 4; i++) {
+            v.clear();
+            v.shrink_to_fit();
+            v.reserve(8);
+        }
+    }
+    EXPECT_LE(resource.allocations() - before, 2);
+}
+
+#pragma clang diagnostic pop
@@ -16,6 +16,10 @@
 #ifndef TOKEN_HPP
 #define TOKEN_HPP
 
+#include <array>
+#include <list>
+#include <memory_resource>
+
 namespace sparkdown {
 
 /**
@@ -64,9 +68,70 @@ enum token_type {
 
     // Body tokens:
     // ------------
-    COMP_R_ARROW  // "->"
+    COMP_INCLUDE,   // "$include: "
+    COMP_VERBATIM,  // A whole "```" block.
+    COMP_MATH,      // A whole "$...$", "$$...$$", or "\\[...\\]" region.
+    COMP_R_ARROW,   // "->"
+
+    // Headline tokens:
+    // ----------------
+    COMP_SECTION,        // "# "
+    COMP_SUBSECTION,     // "## "
+    COMP_SUBSUBSECTION,  // "### "
+    COMP_END_HEADING,    // The end of a headline's line.
+
+    // List tokens:
+    // ------------
+    COMP_BEGIN_ITEMIZE,    // The start of an unordered list.
+    COMP_END_ITEMIZE,      // The end of an unordered list.
+    COMP_BEGIN_ENUMERATE,  // The start of an ordered list.
+    COMP_END_ENUMERATE,    // The end of an ordered list.
+    COMP_ITEM,             // A list item marker, such as "* " or "1. ".
+
+    // Table tokens:
+    // -------------
+    COMP_BEGIN_TABLE,  // The start of a table, before its header row.
+    COMP_COLUMN,       // The alignment of a column: 'l', 'c', or 'r'.
+    COMP_BEGIN_ROW,    // The "|" that starts a row.
+    COMP_CELL,         // A "|" between two cells.
+    COMP_END_ROW,      // The "|" that ends a row, or the end of its text.
+    COMP_PIPE,         // An escaped "\|" within a cell.
+    COMP_END_TABLE     // The end of a table.
 };
 
+/**
+ * @brief The token type of each character.
+ * @details Generated at compile time from the single-character token types,
+ *     so that the lexer decides each token with one table lookup
+ *     rather than a branch per character class.
+ *     It is never written to, so it is shared by every thread
+ *     without synchronization.
+ *
+ */
+inline constexpr std::array<token_type, 256> char_classes = [] {
+    std::array<token_type, 256> table{};
+    for (token_type &type : table) type = CHAR_OTHER;
+
+    table[' '] = CHAR_SPACE;
+    table['\t'] = CHAR_SPACE;
+    table['$'] = CHAR_DOLLAR;
+    table[':'] = CHAR_COLON;
+    table['.'] = CHAR_PERIOD;
+    table['['] = CHAR_LBRAC;
+    table[']'] = CHAR_RBRAC;
+    table['#'] = CHAR_HASH;
+    table['*'] = CHAR_STAR;
+    table['-'] = CHAR_DASH;
+    table['='] = CHAR_EQUALS;
+    table['<'] = CHAR_LT;
+    table['>'] = CHAR_GT;
+    table['|'] = CHAR_PIPE;
+    table['`'] = CHAR_TICK;
+    table['\\'] = CHAR_ESCAPE;
+    for (char c = '0'; c <= '9'; c++) table[c] = CHAR_NUMBER;
+    return table;
+}();
+
 /**
  * @brief Represents a single character in a string of Sparkdown text.
  * @details The lexer will create a list of tokens from a string.
@@ -79,9 +144,13 @@ struct token {
      * @brief Constructs a new token from a single character.
      * @details The implicit construction is intentional.
      *
+     *     Defined here, so that the lexer's loop can inline it.
+     *
      * @param character The character used to construct the token.
      */
-    token(char character);  // NOLINT(google-explicit-constructor)
+    token(char character)  // NOLINT(google-explicit-constructor)
+        : type(char_classes[static_cast<unsigned char>(character)]),
+          value(character) {}
 
     /**
      * @brief Constructs a new token from a single token type.
@@ -98,7 +167,17 @@ struct token {
      *
      * @param other The other token to copy.
      */
-    token(const token &other);
+    token(const token &other) = default;
+
+    /**
+     * @brief Copy assignment operator.
+     * @details Lets the nodes of a token list be recycled
+     *     without being deallocated.
+     *
+     * @param other The other token to copy.
+     * @return This token.
+     */
+    token &operator=(const token &other) = default;
 
     /**
      * @brief Equality comparison operator.
@@ -118,6 +197,8 @@ struct token {
 
     /**
      * @brief Given a character, returns the corresponding token type.
+     * @details Looks the character up in a constant table,
+     *     so it is safe to call from any number of threads.
      *
      * @param character The character to test.
      * @return The corresponding token type.
@@ -128,15 +209,24 @@ struct token {
      * @brief The type of the token.
      *
      */
-    const token_type type;
+    token_type type;
 
     /**
      * @brief The value of the token.
      *
      */
-    const char value;
+    char value;
 };
 
+/**
+ * @brief A sequence of tokens.
+ * @details The nodes are drawn from a `std::pmr::memory_resource`,
+ *     so a document's tokens can live in an arena or a pool.
+ *     Nodes may only be spliced between lists that use the same resource.
+ *
+ */
+typedef std::pmr::list<token> token_list;
+
 }  // namespace sparkdown
 
 #endif
\ No newline at end of file
@@ -272,4 +272,22 @@ TEST(token, operator_inequality) {
     EXPECT_TRUE(sparkdown::token('a') != sparkdown::token('A'));
 }
 
+/**
+ * @brief `token#operator=()` test.
+ * @details Ensures that assigning to a token overwrites both its type
+ *     and its value.
+ *
+ */
+TEST(token, operator_assignment) {
+    sparkdown::token token = 'a';
+
+    token = '1';
+    EXPECT_EQ(sparkdown::token_type::CHAR_NUMBER, token.type);
+    EXPECT_EQ('1', token.value);
+
+    token = sparkdown::token_type::COMP_R_ARROW;
+    EXPECT_EQ(sparkdown::token_type::COMP_R_ARROW, token.type);
+    EXPECT_EQ('\0', token.value);
+}
+
 #pragma clang diagnostic pop
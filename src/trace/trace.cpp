@@ -0,0 +1,229 @@
+/**
+ * @file trace/trace.cpp
+ * @package //trace:trace
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `trace` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `trace` class,
+ *     which records timed spans of work as Chrome trace events.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "trace.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sparkdown {
+
+namespace {
+
+/**
+ * @brief A single recorded span.
+ *
+ */
+struct event {
+    const char *category;
+    const char *name;
+    std::string detail;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point end;
+};
+
+/**
+ * @brief The spans recorded by a single thread.
+ * @details Only the owning thread appends to `events`,
+ *     and only under `mutex`, which is otherwise uncontended.
+ *
+ */
+struct buffer {
+    std::uint32_t thread_id;
+    std::mutex mutex;
+    std::vector<event> events;
+};
+
+/**
+ * @brief Whether spans are being recorded.
+ *
+ */
+std::atomic<bool> recording = false;
+
+/**
+ * @brief The time tracing was started. Event times are relative to it.
+ *
+ */
+std::chrono::steady_clock::time_point epoch;
+
+/**
+ * @brief Guards `buffers`.
+ *
+ */
+std::mutex buffers_mutex;
+
+/**
+ * @brief The buffer of every thread that has recorded a span.
+ * @details Buffers outlive their threads,
+ *     so that worker threads may finish before the trace is written.
+ *
+ */
+std::vector<std::unique_ptr<buffer>> buffers;
+
+/**
+ * @brief Returns the calling thread's buffer, creating it if needed.
+ *
+ * @return The buffer.
+ */
+buffer &thread_buffer() {
+    thread_local buffer *mine = nullptr;
+    if (!mine) {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        buffers.push_back(std::make_unique<buffer>());
+        mine = buffers.back().get();
+        mine->thread_id = static_cast<std::uint32_t>(buffers.size());
+    }
+    return *mine;
+}
+
+/**
+ * @brief Writes the given text as a JSON string.
+ *
+ * @param output The stream to write to.
+ * @param text The text to write.
+ */
+void write_string(std::ostream &output, std::string_view text) {
+    output << '"';
+    for (char c : text) {
+        switch (c) {
+            case '"':
+                output << "\\\"";
+                break;
+            case '\\':
+                output << "\\\\";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    output << escaped;
+                } else {
+                    output << c;
+                }
+        }
+    }
+    output << '"';
+}
+
+/**
+ * @brief Returns the given time, relative to the epoch, in microseconds.
+ *
+ * @param time The time.
+ * @return The microseconds since the epoch.
+ */
+double microseconds(std::chrono::steady_clock::time_point time) {
+    return std::chrono::duration<double, std::micro>(time - epoch).count();
+}
+
+}  // namespace
+
+trace::span::span(const char *category, const char *name,
+                  std::string_view detail)
+    : _category(category), _name(name), _detail(detail) {
+    if (recording.load(std::memory_order_relaxed)) {
+        this->_start = std::chrono::steady_clock::now();
+    }
+}
+
+trace::span::~span() {
+    if (!recording.load(std::memory_order_relaxed) ||
+        this->_start == std::chrono::steady_clock::time_point()) {
+        return;
+    }
+
+    std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+    buffer &mine = thread_buffer();
+    std::lock_guard<std::mutex> lock(mine.mutex);
+    mine.events.push_back({this->_category, this->_name,
+                           std::string(this->_detail), this->_start, end});
+}
+
+void trace::start() {
+    // The starting thread is given the first thread ID.
+    thread_buffer();
+
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    for (auto &b : buffers) {
+        std::lock_guard<std::mutex> guard(b->mutex);
+        b->events.clear();
+    }
+    epoch = std::chrono::steady_clock::now();
+    recording = true;
+}
+
+void trace::stop() { recording = false; }
+
+bool trace::started() { return recording.load(std::memory_order_relaxed); }
+
+std::size_t trace::size() {
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    std::size_t count = 0;
+    for (auto &b : buffers) {
+        std::lock_guard<std::mutex> guard(b->mutex);
+        count += b->events.size();
+    }
+    return count;
+}
+
+bool trace::write(const std::filesystem::path &path) {
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    for (auto &b : buffers) {
+        std::lock_guard<std::mutex> guard(b->mutex);
+
+        if (!first) output << ",";
+        first = false;
+        output << "\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,"
+               << "\"tid\":" << b->thread_id << ",\"args\":{\"name\":\""
+               << (b->thread_id == 1 ? "main" : "worker ")
+               << (b->thread_id == 1 ? "" : std::to_string(b->thread_id - 1))
+               << "\"}}";
+
+        for (const event &e : b->events) {
+            output << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << b->thread_id
+                   << ",\"cat\":";
+            write_string(output, e.category);
+            output << ",\"name\":";
+            write_string(output, e.name);
+            double start = microseconds(e.start);
+            output << ",\"ts\":" << start
+                   << ",\"dur\":" << microseconds(e.end) - start;
+            if (!e.detail.empty()) {
+                output << ",\"args\":{\"detail\":";
+                write_string(output, e.detail);
+                output << "}";
+            }
+            output << "}";
+        }
+    }
+
+    output << "\n]}\n";
+    output.close();
+    return static_cast<bool>(output);
+}
+
+}  // namespace sparkdown
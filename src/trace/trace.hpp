@@ -0,0 +1,167 @@
+/**
+ * @file trace/trace.hpp
+ * @package //trace:trace
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `trace` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `trace` class,
+ *     which records timed spans of work as Chrome trace events,
+ *     and the `SPARKDOWN_TRACE_SPAN` macro, which marks such a span.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <chrono>
+#include <filesystem>
+#include <string_view>
+
+/**
+ * @brief Marks the rest of the enclosing scope as a span of work.
+ * @details Compiles to nothing unless `SPARKDOWN_TRACING` is defined,
+ *     so spans can be left in hot code. With it defined,
+ *     a span costs one relaxed atomic load while tracing is not started.
+ *
+ *     Takes a category and a name, both string literals,
+ *     and optionally a detail, such as a file path, which is copied.
+ *
+ */
+#ifdef SPARKDOWN_TRACING
+#define SPARKDOWN_TRACE_SPAN(...) \
+    SPARKDOWN_TRACE_SPAN_AT(__LINE__, __VA_ARGS__)
+#define SPARKDOWN_TRACE_SPAN_AT(line, ...) \
+    SPARKDOWN_TRACE_SPAN_NAMED(line, __VA_ARGS__)
+#define SPARKDOWN_TRACE_SPAN_NAMED(line, ...) \
+    ::sparkdown::trace::span _sparkdown_trace_span_##line(__VA_ARGS__)
+#else
+#define SPARKDOWN_TRACE_SPAN(...) static_cast<void>(0)
+#endif
+
+namespace sparkdown {
+
+/**
+ * @brief Records timed spans of work from every thread,
+ *     and writes them out in the Chrome trace event format.
+ * @details The output can be loaded into the Perfetto UI
+ *     or `chrome://tracing`. Each thread that records a span
+ *     is given a small thread ID, in the order they first record.
+ *
+ *     Recording is thread-safe. Starting, stopping, and writing
+ *     should be done while no other thread is recording.
+ *
+ */
+class trace {
+   public:
+    /**
+     * @brief A span of work, from construction to destruction.
+     * @details Use `SPARKDOWN_TRACE_SPAN` rather than this class directly,
+     *     so that the span compiles to nothing when tracing is disabled.
+     *
+     */
+    class span {
+       private:
+        /**
+         * @brief The category of the span.
+         *
+         */
+        const char *_category;
+
+        /**
+         * @brief The name of the span.
+         *
+         */
+        const char *_name;
+
+        /**
+         * @brief The detail of the span. May be empty.
+         * @details Only valid until the span ends; copied when recorded.
+         *
+         */
+        std::string_view _detail;
+
+        /**
+         * @brief The time the span began,
+         *     or the epoch if tracing was not started.
+         *
+         */
+        std::chrono::steady_clock::time_point _start;
+
+       public:
+        /**
+         * @brief Begins the span.
+         *
+         * @param category The category of the span. Must be a literal.
+         * @param name The name of the span. Must be a literal.
+         * @param detail The detail of the span, such as a file path.
+         *     Must outlive the span.
+         */
+        span(const char *category, const char *name,
+             std::string_view detail = {});
+
+        /**
+         * @brief Ends the span, and records it if tracing is started.
+         *
+         */
+        ~span();
+
+        span(const span &) = delete;
+        span &operator=(const span &) = delete;
+    };
+
+    /**
+     * @brief Starts recording spans, discarding any recorded before.
+     *
+     */
+    static void start();
+
+    /**
+     * @brief Stops recording spans.
+     *
+     */
+    static void stop();
+
+    /**
+     * @brief Reports whether spans are being recorded.
+     *
+     * @return True if spans are being recorded.
+     */
+    static bool started();
+
+    /**
+     * @brief Returns the number of spans recorded so far.
+     *
+     * @return The number of spans.
+     */
+    static std::size_t size();
+
+    /**
+     * @brief Writes the recorded spans to the given file as a JSON trace.
+     *
+     * @param path The file to write.
+     * @return True on success.
+     */
+    static bool write(const std::filesystem::path &path);
+
+    /**
+     * @brief Reports whether this build records spans,
+     *     i.e. whether it was built with `SPARKDOWN_TRACING` defined.
+     *
+     * @return True if this build records spans.
+     */
+    static constexpr bool compiled_in() {
+#ifdef SPARKDOWN_TRACING
+        return true;
+#else
+        return false;
+#endif
+    }
+};
+
+}  // namespace sparkdown
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ * @file trace/trace.tests.cpp
+ * @package //trace:trace.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `trace` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `trace` class,
+ *     which records timed spans of work as Chrome trace events.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunknown-pragmas"
+#pragma ide diagnostic ignored "UnusedLocalVariable"
+
+#define SPARKDOWN_TRACING
+#include "trace.hpp"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Returns the contents of the given file.
+ *
+ * @param path The file to read.
+ * @return The contents of the file.
+ */
+static std::string read(const std::filesystem::path &path) {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>()};
+}
+
+/**
+ * @brief `SPARKDOWN_TRACE_SPAN` test.
+ * @details Ensures that spans are only recorded while tracing is started.
+ *
+ */
+TEST(trace, records_only_when_started) {
+    ASSERT_TRUE(sparkdown::trace::compiled_in());
+
+    { SPARKDOWN_TRACE_SPAN("test", "before"); }
+    sparkdown::trace::start();
+    EXPECT_EQ(sparkdown::trace::size(), 0);
+
+    {
+        SPARKDOWN_TRACE_SPAN("test", "outer");
+        SPARKDOWN_TRACE_SPAN("test", "inner", "detail");
+    }
+    EXPECT_EQ(sparkdown::trace::size(), 2);
+
+    sparkdown::trace::stop();
+    { SPARKDOWN_TRACE_SPAN("test", "after"); }
+    EXPECT_EQ(sparkdown::trace::size(), 2);
+    EXPECT_FALSE(sparkdown::trace::started());
+}
+
+/**
+ * @brief `trace#write()` test.
+ * @details Ensures that the spans of every thread are written
+ *     as Chrome trace events, with their details escaped.
+ *
+ */
+TEST(trace, write) {
+    sparkdown::trace::start();
+    { SPARKDOWN_TRACE_SPAN("test", "main span", "a \"quoted\"\\path"); }
+    std::thread worker([] { SPARKDOWN_TRACE_SPAN("test", "worker span"); });
+    worker.join();
+    sparkdown::trace::stop();
+
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "sparkdown-trace.json";
+    ASSERT_TRUE(sparkdown::trace::write(path));
+    std::string json = read(path);
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0),
+              0);
+    EXPECT_NE(json.find("\"name\":\"main span\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"worker span\""), std::string::npos);
+    EXPECT_NE(json.find("\"detail\":\"a \\\"quoted\\\"\\\\path\""),
+              std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"tid\":1"), std::string::npos);
+    EXPECT_NE(json.find("\"tid\":2"), std::string::npos);
+}
+
+#pragma clang diagnostic pop
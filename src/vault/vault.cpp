@@ -0,0 +1,608 @@
+/**
+ * @file vault/vault.cpp
+ * @package //vault:vault
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `vault` class implementation.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file implements the `vault` class,
+ *     which transpiles a whole directory tree of Sparkdown files.
+ *
+ *     See the header file for documentation.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "vault.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <memory_resource>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <system_error>
+#include <thread>
+
+#include "batch_io/batch_io.hpp"
+#include "compiler/compiler.hpp"
+#include "hash/hash.hpp"
+#include "module_cache/module_cache.hpp"
+#include "output/output.hpp"
+#include "sparkdown/version.hpp"
+#include "trace/trace.hpp"
+
+namespace sparkdown {
+
+namespace {
+
+/**
+ * @brief A source file found while searching the source tree.
+ *
+ */
+struct source_file {
+    std::string relative;
+    std::uintmax_t size;
+    std::int64_t modified;
+};
+
+/**
+ * @brief Calls the given function when it goes out of scope,
+ *     whether or not an exception is being thrown.
+ *
+ */
+template <class F>
+class scope_exit {
+   private:
+    F _function;
+
+   public:
+    explicit scope_exit(F function) : _function(std::move(function)) {}
+
+    ~scope_exit() { this->_function(); }
+
+    scope_exit(const scope_exit &) = delete;
+    scope_exit &operator=(const scope_exit &) = delete;
+};
+
+/**
+ * @brief Runs the given function on the given number of threads,
+ *     and waits for all of them to finish.
+ * @details If the function throws on any thread, the first exception
+ *     is rethrown once every thread has finished.
+ *     If fewer threads can be started, the function runs on those.
+ *
+ * @param threads The number of threads.
+ * @param function The function to run.
+ */
+template <class F>
+void run_on_threads(unsigned threads, F function) {
+    std::mutex mutex;
+    std::exception_ptr failure;
+    auto run = [&] {
+        try {
+            function();
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(mutex);
+            if (!failure) failure = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    try {
+        for (unsigned i = 1; i < threads; i++) pool.emplace_back(run);
+    } catch (const std::system_error &) {
+        // Run on the threads that did start.
+    }
+    run();
+    for (std::thread &t : pool) t.join();
+    if (failure) std::rethrow_exception(failure);
+}
+
+/**
+ * @brief The most files read or written per batch.
+ *
+ */
+constexpr std::size_t io_batch = 64;
+
+/**
+ * @brief A queue between threads that holds at most a given number of values.
+ * @details A full queue holds back the threads that push to it,
+ *     and an empty queue the threads that pop from it.
+ *
+ */
+template <class T>
+class bounded_queue {
+   private:
+    std::mutex _mutex;
+    std::condition_variable _changed;
+    std::deque<T> _values;
+    std::size_t _capacity;
+    bool _closed = false;
+
+   public:
+    explicit bounded_queue(std::size_t capacity) : _capacity(capacity) {}
+
+    /**
+     * @brief Pushes the given value, waiting while the queue is full.
+     *
+     * @param value The value.
+     * @return False if the queue was closed, so the value was dropped.
+     */
+    bool push(T value) {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        this->_changed.wait(lock, [&] {
+            return this->_values.size() < this->_capacity || this->_closed;
+        });
+        if (this->_closed) return false;
+        this->_values.push_back(std::move(value));
+        this->_changed.notify_all();
+        return true;
+    }
+
+    /**
+     * @brief Pops up to the given number of values at once,
+     *     waiting while the queue is empty.
+     *
+     * @param values Receives the values.
+     * @param most The most values to pop.
+     * @return False if the queue is closed and empty.
+     */
+    bool pop_some(std::vector<T> &values, std::size_t most) {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        this->_changed.wait(
+            lock, [&] { return !this->_values.empty() || this->_closed; });
+        if (this->_values.empty()) return false;
+        while (!this->_values.empty() && values.size() < most) {
+            values.push_back(std::move(this->_values.front()));
+            this->_values.pop_front();
+        }
+        this->_changed.notify_all();
+        return true;
+    }
+
+    /**
+     * @brief Pops one value, waiting while the queue is empty.
+     *
+     * @param value Receives the value.
+     * @return False if the queue is closed and empty.
+     */
+    bool pop(T &value) {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        this->_changed.wait(
+            lock, [&] { return !this->_values.empty() || this->_closed; });
+        if (this->_values.empty()) return false;
+        value = std::move(this->_values.front());
+        this->_values.pop_front();
+        this->_changed.notify_all();
+        return true;
+    }
+
+    /**
+     * @brief Closes the queue, once every value has been pushed,
+     *     or to release the threads waiting on it after a failure.
+     *
+     */
+    void close() {
+        std::lock_guard<std::mutex> guard(this->_mutex);
+        this->_closed = true;
+        this->_changed.notify_all();
+    }
+};
+
+}  // namespace
+
+vault::vault(std::filesystem::path source, std::filesystem::path output,
+             unsigned threads, io_backend backend)
+    : _source(std::move(source)),
+      _output(std::move(output)),
+      _threads(threads ? threads
+                       : std::max(1u, std::thread::hardware_concurrency())),
+      _backend(backend) {}
+
+std::filesystem::path vault::output_path(
+    const std::filesystem::path &relative) const {
+    return (this->_output / relative).replace_extension(".tex");
+}
+
+vault_report vault::build() {
+    SPARKDOWN_TRACE_SPAN("vault", "build", this->_source.native());
+    vault_report report;
+
+    // Search the source tree in parallel.
+    // Each thread takes a directory from the stack, lists it,
+    // and pushes its subdirectories back onto the stack.
+    std::vector<std::filesystem::path> directories = {this->_source};
+    std::vector<source_file> sources;
+    std::size_t busy = 0;
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    run_on_threads(this->_threads, [&] {
+        SPARKDOWN_TRACE_SPAN("vault", "discover");
+        std::vector<std::filesystem::path> found_directories;
+        std::vector<source_file> found_sources;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            condition.wait(lock,
+                           [&] { return !directories.empty() || busy == 0; });
+            if (directories.empty()) break;
+
+            std::filesystem::path directory = std::move(directories.back());
+            directories.pop_back();
+            busy++;
+            lock.unlock();
+
+            std::error_code error;
+            for (const auto &item :
+                 std::filesystem::directory_iterator(directory, error)) {
+                if (item.is_symlink(error)) continue;
+                if (item.is_directory(error)) {
+                    found_directories.push_back(item.path());
+                } else if (item.is_regular_file(error) &&
+                           item.path().extension() == "._") {
+                    found_sources.push_back(
+                        {item.path()
+                             .lexically_relative(this->_source)
+                             .generic_string(),
+                         item.file_size(error),
+                         item.last_write_time(error)
+                             .time_since_epoch()
+                             .count()});
+                }
+            }
+
+            lock.lock();
+            busy--;
+            std::move(found_directories.begin(), found_directories.end(),
+                      std::back_inserter(directories));
+            std::move(found_sources.begin(), found_sources.end(),
+                      std::back_inserter(sources));
+            found_directories.clear();
+            found_sources.clear();
+            condition.notify_all();
+        }
+    });
+
+    // Delete the outputs of source files that no longer exist.
+    std::map<std::string, entry> manifest = this->_read_manifest();
+    std::map<std::string, entry> previous;
+    previous.swap(manifest);
+    for (const source_file &file : sources) {
+        auto found = previous.find(file.relative);
+        if (found != previous.end()) {
+            manifest.insert(previous.extract(found));
+        } else {
+            manifest[file.relative] = entry();
+        }
+    }
+    for (const auto &item : previous) {
+        std::filesystem::path path = this->output_path(item.first);
+        std::error_code error;
+        if (std::filesystem::remove(path, error)) {
+            report.removed.push_back(path);
+        }
+    }
+
+    // Transpile the largest files first.
+    std::sort(sources.begin(), sources.end(),
+              [](const source_file &a, const source_file &b) {
+                  return a.size > b.size;
+              });
+
+    // A file must also be transpiled if any file it includes has changed
+    // since the last build. Both lookups are read-only while the workers run.
+    const std::map<std::string, entry> before = manifest;
+    std::map<std::string, const source_file *> current;
+    for (const source_file &file : sources) current[file.relative] = &file;
+
+    auto dependencies_changed = [&](const entry &record) {
+        for (const std::string &dependency : record.dependencies) {
+            auto old_record = before.find(dependency);
+            auto new_record = current.find(dependency);
+            if (old_record == before.end() || new_record == current.end() ||
+                !old_record->second.known ||
+                old_record->second.size != new_record->second->size ||
+                old_record->second.modified != new_record->second->modified) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::error_code root_error;
+    std::filesystem::path root =
+        std::filesystem::weakly_canonical(this->_source, root_error);
+
+    std::atomic<std::size_t> unchanged = 0;
+
+    // A reader thread reads the files that may have changed, a batch at a time,
+    // and hands them to the workers; the workers hand their LaTeX code
+    // to a writer thread, which writes it a batch at a time.
+    // So the workers never wait on the disk, and the disk is reached
+    // with as few system calls as the backend allows.
+    struct loaded_file {
+        std::size_t index = 0;
+        bool reusable = false;  // The old output may stay if nothing changed.
+        read_request request;
+    };
+    struct finished_file {
+        std::size_t index = 0;
+        entry updated;
+        write_request request;
+    };
+    bounded_queue<loaded_file> loaded(2 * io_batch);
+    bounded_queue<finished_file> finished(2 * io_batch);
+
+    // Should any thread fail, both queues are closed,
+    // so that the others stop rather than wait forever,
+    // and the first failure is rethrown once every thread is joined.
+    std::exception_ptr reader_failure;
+    std::exception_ptr writer_failure;
+    auto stop = [&] {
+        loaded.close();
+        finished.close();
+    };
+    std::thread reader;
+    std::thread writer;
+    scope_exit join([&] {
+        stop();
+        if (reader.joinable()) reader.join();
+        if (writer.joinable()) writer.join();
+    });
+
+    auto read_sources = [&] {
+        batch_io io(this->_backend, io_batch);
+        std::vector<read_request> requests;
+        std::vector<loaded_file> batch;
+
+        // Returns false once the queue has been closed by a failure.
+        auto flush = [&] {
+            SPARKDOWN_TRACE_SPAN("vault", "read");
+            io.read(requests);
+            bool open = true;
+            for (std::size_t i = 0; i < batch.size() && open; i++) {
+                batch[i].request = std::move(requests[i]);
+                open = loaded.push(std::move(batch[i]));
+            }
+            requests.clear();
+            batch.clear();
+            return open;
+        };
+
+        for (std::size_t i = 0; i < sources.size(); i++) {
+            const source_file &file = sources[i];
+
+            // Every source file already has a manifest entry, and each file
+            // is handled by one thread at a time, so no lock is needed.
+            const entry &record = manifest.find(file.relative)->second;
+            bool output_exists =
+                std::filesystem::exists(this->output_path(file.relative));
+            bool reusable = record.known && output_exists &&
+                            !dependencies_changed(record);
+
+            if (reusable && record.size == file.size &&
+                record.modified == file.modified) {
+                unchanged++;
+                continue;
+            }
+
+            requests.emplace_back();
+            requests.back().path = this->_source / file.relative;
+            requests.back().size_hint = file.size;
+            batch.emplace_back();
+            batch.back().index = i;
+            batch.back().reusable = reusable;
+            if (requests.size() == io_batch && !flush()) return;
+        }
+        flush();
+        loaded.close();
+    };
+
+    auto write_outputs = [&] {
+        batch_io io(this->_backend, io_batch);
+        std::set<std::filesystem::path> directories;
+        std::vector<write_request> requests;
+        std::vector<finished_file> batch;
+
+        while (finished.pop_some(batch, io_batch)) {
+            SPARKDOWN_TRACE_SPAN("vault", "write");
+            for (finished_file &file : batch) {
+                std::filesystem::path parent = file.request.path.parent_path();
+                if (directories.insert(parent).second) {
+                    std::error_code error;
+                    std::filesystem::create_directories(parent, error);
+                }
+                requests.push_back(std::move(file.request));
+            }
+            io.write(requests);
+
+            std::lock_guard<std::mutex> guard(mutex);
+            for (std::size_t i = 0; i < batch.size(); i++) {
+                const std::string &relative = sources[batch[i].index].relative;
+                entry &record = manifest.find(relative)->second;
+                write_result result = requests[i].result;
+
+                if (result != WRITE_FAILED) {
+                    record = std::move(batch[i].updated);
+                }
+                if (result == WRITE_UNCHANGED) unchanged++;
+
+                if (result == WRITE_FAILED) {
+                    report.failed.emplace_back(requests[i].path,
+                                               "could not write the file");
+                } else if (result == WRITE_CHANGED) {
+                    report.changed.push_back(requests[i].path);
+                }
+            }
+            requests.clear();
+            batch.clear();
+        }
+    };
+
+    auto transpile = [&] {
+        // Each worker draws its token buffers from a pool of its own,
+        // so the workers never contend on the global heap.
+        std::pmr::unsynchronized_pool_resource pool;
+        module_cache modules({}, &pool);
+
+        loaded_file item;
+        while (loaded.pop(item)) {
+            const source_file &file = sources[item.index];
+            SPARKDOWN_TRACE_SPAN("vault", "file", file.relative);
+            entry &record = manifest.find(file.relative)->second;
+            std::filesystem::path source = item.request.path;
+
+            if (!item.request.ok) {
+                std::lock_guard<std::mutex> guard(mutex);
+                report.failed.emplace_back(source, "could not read the file");
+                continue;
+            }
+
+            const std::string &input = item.request.contents;
+            entry updated = {file.size, file.modified, hash::of(input), true,
+                             {}};
+            if (item.reusable && record.hash == updated.hash) {
+                updated.dependencies = std::move(record.dependencies);
+                record = std::move(updated);
+                unchanged++;
+                continue;
+            }
+
+            std::string latex;
+            compile_status status =
+                modules.compile(input, source.parent_path(), latex);
+            if (status != COMPILE_OK) {
+                std::string reason(compiler::describe(status));
+                if (!modules.error_path().empty()) {
+                    reason += " (" + modules.error_path().string() + ")";
+                }
+                std::lock_guard<std::mutex> guard(mutex);
+                report.failed.emplace_back(source, reason);
+                continue;
+            }
+
+            for (const std::filesystem::path &dependency :
+                 modules.dependencies()) {
+                std::filesystem::path relative =
+                    dependency.lexically_relative(root);
+                bool inside = !root_error && !relative.empty() &&
+                              *relative.begin() != "..";
+                updated.dependencies.push_back(inside
+                                                   ? relative.generic_string()
+                                                   : dependency.string());
+            }
+
+            finished_file done;
+            done.index = item.index;
+            done.updated = std::move(updated);
+            done.request.path = this->output_path(file.relative);
+            done.request.contents = std::move(latex);
+            if (!finished.push(std::move(done))) return;
+        }
+    };
+
+    reader = std::thread([&] {
+        try {
+            read_sources();
+        } catch (...) {
+            reader_failure = std::current_exception();
+            stop();
+        }
+    });
+    writer = std::thread([&] {
+        try {
+            write_outputs();
+        } catch (...) {
+            writer_failure = std::current_exception();
+            stop();
+        }
+    });
+    run_on_threads(this->_threads, [&] {
+        try {
+            transpile();
+        } catch (...) {
+            stop();
+            throw;
+        }
+    });
+
+    finished.close();
+    reader.join();
+    writer.join();
+    if (reader_failure) std::rethrow_exception(reader_failure);
+    if (writer_failure) std::rethrow_exception(writer_failure);
+
+    report.unchanged = unchanged;
+
+    SPARKDOWN_TRACE_SPAN("vault", "manifest");
+    if (!this->_write_manifest(manifest)) {
+        report.failed.emplace_back(this->_output / manifest_name,
+                                   "could not write the manifest");
+    }
+
+    return report;
+}
+
+std::map<std::string, vault::entry> vault::_read_manifest() const {
+    std::map<std::string, entry> manifest;
+
+    std::ifstream file(this->_output / manifest_name);
+    std::string line;
+    if (!std::getline(file, line) ||
+        line != std::string("sparkdown-manifest ") + SPARKDOWN_VERSION) {
+        return manifest;
+    }
+
+    // Each line holds the relative source path, size, modification time,
+    // content hash, and dependencies of one source file, separated by tabs.
+    std::vector<std::string> fields;
+    while (std::getline(file, line)) {
+        fields.clear();
+        std::istringstream split(line);
+        for (std::string field; std::getline(split, field, '\t');) {
+            fields.push_back(field);
+        }
+        if (fields.size() < 4) continue;
+
+        entry record;
+        std::istringstream numbers(fields[1] + ' ' + fields[2]);
+        if (numbers >> record.size >> record.modified &&
+            hash::from_hex(fields[3], record.hash)) {
+            record.known = true;
+            record.dependencies.assign(fields.begin() + 4, fields.end());
+            manifest[fields[0]] = std::move(record);
+        }
+    }
+
+    return manifest;
+}
+
+bool vault::_write_manifest(
+    const std::map<std::string, entry> &manifest) const {
+    std::ostringstream contents;
+    contents << "sparkdown-manifest " << SPARKDOWN_VERSION << '\n';
+    for (const auto &[relative, record] : manifest) {
+        if (!record.known) continue;
+        contents << relative << '\t' << record.size << '\t' << record.modified
+                 << '\t' << hash::to_hex(record.hash);
+        for (const std::string &dependency : record.dependencies) {
+            contents << '\t' << dependency;
+        }
+        contents << '\n';
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(this->_output, error);
+    return output::write(this->_output / manifest_name, contents.str()) !=
+           WRITE_FAILED;
+}
+
+}  // namespace sparkdown
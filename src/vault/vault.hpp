@@ -0,0 +1,185 @@
+/**
+ * @file vault/vault.hpp
+ * @package //vault:vault
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `vault` class definition.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file defines the `vault` class,
+ *     which transpiles a whole directory tree of Sparkdown files.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#ifndef VAULT_HPP
+#define VAULT_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "batch_io/batch_io.hpp"
+
+namespace sparkdown {
+
+/**
+ * @brief The results of building a vault.
+ *
+ */
+struct vault_report {
+    /**
+     * @brief The output files that were created or rewritten.
+     *
+     */
+    std::vector<std::filesystem::path> changed;
+
+    /**
+     * @brief The output files that were deleted,
+     *     because their source files no longer exist.
+     *
+     */
+    std::vector<std::filesystem::path> removed;
+
+    /**
+     * @brief The source files that failed, and the reason for each failure.
+     *
+     */
+    std::vector<std::pair<std::filesystem::path, std::string>> failed;
+
+    /**
+     * @brief The number of source files that were already up to date.
+     *
+     */
+    std::size_t unchanged = 0;
+};
+
+/**
+ * @brief Mirrors a directory tree of Sparkdown (`._`) files
+ *     into a directory tree of LaTeX (`.tex`) files.
+ * @details The source tree is searched in parallel,
+ *     and the files are then transpiled on a pool of worker threads,
+ *     largest first, so that one large file does not hold up the build
+ *     at the end. The files are read and written in batches
+ *     by a reader thread and a writer thread (see `batch_io`),
+ *     so the workers never wait on the disk.
+ *
+ *     The size, modification time, content hash, and included files
+ *     of every source file are recorded in a manifest in the output directory.
+ *     On later builds, only files that have changed, or that include a file
+ *     that has changed, are transpiled;
+ *     and the outputs of source files that have disappeared are deleted.
+ *     (A file that includes something other than a Sparkdown file
+ *     in the source tree is always transpiled.)
+ *
+ */
+class vault {
+   private:
+    /**
+     * @brief The manifest record of a single source file.
+     *
+     */
+    struct entry {
+        std::uintmax_t size = 0;
+        std::int64_t modified = 0;
+        std::uint64_t hash = 0;
+
+        /**
+         * @brief False for a placeholder that has not been filled in yet.
+         *
+         */
+        bool known = false;
+
+        /**
+         * @brief The files included by this file, directly or indirectly,
+         *     relative to the source tree where possible.
+         *
+         */
+        std::vector<std::string> dependencies;
+    };
+
+    /**
+     * @brief The root of the source tree.
+     *
+     */
+    std::filesystem::path _source;
+
+    /**
+     * @brief The root of the output tree.
+     *
+     */
+    std::filesystem::path _output;
+
+    /**
+     * @brief The number of worker threads to use.
+     *
+     */
+    unsigned _threads;
+
+    /**
+     * @brief How the source and output files are read and written.
+     *
+     */
+    io_backend _backend;
+
+    /**
+     * @brief Reads the manifest from the output directory.
+     * @details A missing manifest, or one written by a different version
+     *     of Sparkdown, is treated as empty.
+     *
+     * @return The manifest entries, keyed by relative source path.
+     */
+    [[nodiscard]] std::map<std::string, entry> _read_manifest() const;
+
+    /**
+     * @brief Writes the manifest to the output directory.
+     *
+     * @param manifest The manifest entries, keyed by relative source path.
+     * @return True on success.
+     */
+    bool _write_manifest(const std::map<std::string, entry> &manifest) const;
+
+   public:
+    /**
+     * @brief The name of the manifest file in the output directory.
+     *
+     */
+    static constexpr const char *manifest_name = ".sparkdown-manifest";
+
+    /**
+     * @brief Constructor.
+     *
+     * @param source The root of the source tree.
+     * @param output The root of the output tree.
+     * @param threads The number of worker threads to use.
+     *     Zero selects the number of hardware threads.
+     * @param backend How the source and output files are read and written.
+     */
+    vault(std::filesystem::path source, std::filesystem::path output,
+          unsigned threads = 0, io_backend backend = IO_AUTO);
+
+    /**
+     * @brief Brings the output tree up to date with the source tree.
+     *
+     * @return The results of the build.
+     */
+    vault_report build();
+
+    /**
+     * @brief Returns the output path for the given source file.
+     *
+     * @param relative The path of the source file,
+     *     relative to the source tree.
+     * @return The path of the output file.
+     */
+    [[nodiscard]] std::filesystem::path output_path(
+        const std::filesystem::path &relative) const;
+};
+
+}  // namespace sparkdown
+
+#endif
@@ -0,0 +1,184 @@
+/**
+ * @file vault/vault.tests.cpp
+ * @package //vault:vault.tests
+ * @author Cayden Lund <cayden.lund@utah.edu>
+ * @brief `vault` class unit tests.
+ * @details This project is part of Sparkdown,
+ *     a new markup language for quickly writing and formatting notes.
+ *
+ *     This file tests the `vault` class,
+ *     which transpiles a whole directory tree of Sparkdown files.
+ *
+ * @license MIT <https://opensource.org/licenses/MIT>
+ * @copyright 2021-2022 by Cayden Lund <https://github.com/caydenlund>
+ */
+
+#include "vault.hpp"
+
+#include <gtest/gtest.h>
+
+#include "scratch/scratch.hpp"
+
+/**
+ * @brief `vault#build()` test.
+ * @details Ensures that the source tree is mirrored into the output tree,
+ *     and that files other than Sparkdown files are ignored.
+ *
+ */
+TEST(vault, mirrors_tree) {
+    std::filesystem::path dir = sparkdown::scratch::directory("vault-mirror");
+    sparkdown::scratch::write_file(dir / "notes" / "a._", "alpha");
+    sparkdown::scratch::write_file(dir / "notes" / "x" / "y" / "b._", "beta");
+    sparkdown::scratch::write_file(dir / "notes" / "x" / "readme.txt",
+                                   "ignored");
+
+    sparkdown::vault v(dir / "notes", dir / "build", 4);
+    sparkdown::vault_report report = v.build();
+
+    EXPECT_EQ(report.changed.size(), 2);
+    EXPECT_TRUE(report.failed.empty());
+    EXPECT_EQ(sparkdown::scratch::read_file(dir / "build" / "a.tex"), "alpha");
+    EXPECT_EQ(
+        sparkdown::scratch::read_file(dir / "build" / "x" / "y" / "b.tex"),
+        "beta");
+    EXPECT_FALSE(std::filesystem::exists(dir / "build" / "x" / "readme.tex"));
+    EXPECT_TRUE(std::filesystem::exists(dir / "build" /
+                                        sparkdown::vault::manifest_name));
+
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief `vault#build()` incremental test.
+ * @details Ensures that only changed files are rebuilt,
+ *     and that the outputs of deleted files are removed.
+ *
+ */
+TEST(vault, rebuilds_incrementally) {
+    std::filesystem::path dir =
+        sparkdown::scratch::directory("vault-incremental");
+    sparkdown::scratch::write_file(dir / "notes" / "a._", "alpha");
+    sparkdown::scratch::write_file(dir / "notes" / "b._", "beta");
+    sparkdown::scratch::write_file(dir / "notes" / "c._", "gamma");
+
+    sparkdown::vault v(dir / "notes", dir / "build", 2);
+    EXPECT_EQ(v.build().changed.size(), 3);
+
+    sparkdown::vault_report report = v.build();
+    EXPECT_TRUE(report.changed.empty());
+    EXPECT_EQ(report.unchanged, 3);
+
+    sparkdown::scratch::write_file(dir / "notes" / "a._", "ALPHA, again");
+    std::filesystem::remove(dir / "notes" / "b._");
+    report = v.build();
+
+    ASSERT_EQ(report.changed.size(), 1);
+    EXPECT_EQ(report.changed[0], dir / "build" / "a.tex");
+    ASSERT_EQ(report.removed.size(), 1);
+    EXPECT_EQ(report.removed[0], dir / "build" / "b.tex");
+    EXPECT_EQ(report.unchanged, 1);
+    EXPECT_EQ(sparkdown::scratch::read_file(dir / "build" / "a.tex"),
+              "ALPHA, again");
+    EXPECT_FALSE(std::filesystem::exists(dir / "build" / "b.tex"));
+
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief `vault#build()` test.
+ * @details Ensures that a deleted output is regenerated,
+ *     even when its source file has not changed.
+ *
+ */
+TEST(vault, regenerates_missing_output) {
+    std::filesystem::path dir = sparkdown::scratch::directory("vault-missing");
+    sparkdown::scratch::write_file(dir / "notes" / "a._", "alpha");
+
+    sparkdown::vault v(dir / "notes", dir / "build", 1);
+    v.build();
+    std::filesystem::remove(dir / "build" / "a.tex");
+
+    EXPECT_EQ(v.build().changed.size(), 1);
+    EXPECT_EQ(sparkdown::scratch::read_file(dir / "build" / "a.tex"), "alpha");
+
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief `vault#build()` dependency test.
+ * @details Ensures that a file is rebuilt when a file it includes changes,
+ *     even though the file itself has not changed.
+ *
+ */
+TEST(vault, rebuilds_dependents) {
+    std::filesystem::path dir =
+        sparkdown::scratch::directory("vault-dependents");
+    sparkdown::scratch::write_file(dir / "notes" / "main._",
+                                   "main\n$include: parts/part._");
+    sparkdown::scratch::write_file(dir / "notes" / "parts" / "part._", "part");
+    sparkdown::scratch::write_file(dir / "notes" / "other._", "other");
+
+    sparkdown::vault v(dir / "notes", dir / "build", 2);
+    sparkdown::vault_report report = v.build();
+    EXPECT_TRUE(report.failed.empty());
+    EXPECT_EQ(sparkdown::scratch::read_file(dir / "build" / "main.tex"),
+              "main\npart");
+
+    sparkdown::scratch::write_file(dir / "notes" / "parts" / "part._",
+                                   "PART, edited");
+    report = v.build();
+
+    EXPECT_EQ(report.changed.size(), 2);
+    EXPECT_EQ(report.unchanged, 1);
+    EXPECT_EQ(sparkdown::scratch::read_file(dir / "build" / "main.tex"),
+              "main\nPART, edited");
+
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief `vault#build()` backend test.
+ * @details Builds a tree of more files than fit in one batch
+ *     with each I/O backend, and ensures that the outputs,
+ *     failures, and later no-op builds are the same.
+ *
+ */
+TEST(vault, backends) {
+    std::filesystem::path dir = sparkdown::scratch::directory("vault-backends");
+    for (int i = 0; i < 200; i++) {
+        std::string name = std::to_string(i);
+        sparkdown::scratch::write_file(
+            dir / "notes" / std::to_string(i % 7) / (name + "._"),
+            "# Note " + name + "\n* item " + name + "\n");
+    }
+    sparkdown::scratch::write_file(dir / "notes" / "broken._", "$unterminated");
+
+    for (sparkdown::io_backend backend :
+         {sparkdown::IO_URING, sparkdown::IO_BLOCKING}) {
+        std::filesystem::path build =
+            dir / (backend == sparkdown::IO_URING ? "uring" : "blocking");
+        sparkdown::vault v(dir / "notes", build, 3, backend);
+
+        sparkdown::vault_report report = v.build();
+        EXPECT_EQ(report.changed.size(), 200);
+        ASSERT_EQ(report.failed.size(), 1);
+        EXPECT_EQ(report.failed[0].first, dir / "notes" / "broken._");
+
+        report = v.build();
+        EXPECT_TRUE(report.changed.empty());
+        EXPECT_EQ(report.unchanged, 200);
+    }
+
+    for (int i = 0; i < 200; i++) {
+        std::filesystem::path relative =
+            std::filesystem::path(std::to_string(i % 7)) /
+            (std::to_string(i) + ".tex");
+        EXPECT_EQ(sparkdown::scratch::read_file(dir / "uring" / relative),
+                  sparkdown::scratch::read_file(dir / "blocking" / relative));
+        EXPECT_NE(sparkdown::scratch::read_file(dir / "uring" / relative)
+                      .find("\\section"),
+                  std::string::npos);
+    }
+
+    std::filesystem::remove_all(dir);
+}